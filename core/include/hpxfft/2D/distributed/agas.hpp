@@ -18,13 +18,27 @@ struct agas : hpx::components::client_base<agas, agas_server>
         base_type(hpx::new_<agas_server>(hpx::find_here()))
     { }
 
+    // attach to a server created elsewhere, e.g. on a remote locality
+    explicit agas(hpx::future<hpx::id_type> &&id) :
+        base_type(std::move(id))
+    { }
+
     hpx::future<vector_2d> fft_2d_r2c() { return hpx::async(fft_2d_r2c_action(), get_id()); }
 
+    // same as fft_2d_r2c(), the client is asynchronous by construction
+    hpx::future<vector_2d> fft_2d_r2c_async() { return fft_2d_r2c(); }
+
     hpx::future<void> initialize(vector_2d values_vec, const std::string COMM_FLAG, const std::string PLAN_FLAG)
     {
         return hpx::async(initialize_action(), get_id(), std::move(values_vec), COMM_FLAG, PLAN_FLAG);
     }
 
+    // input of the next fft_2d_r2c(), the result of the previous one was moved out
+    hpx::future<void> set_values(vector_2d values_vec)
+    {
+        return hpx::async(set_values_action(), get_id(), std::move(values_vec));
+    }
+
     ~agas() = default;
 };
 }  // namespace hpxfft::fft2D::distributed
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef hpxfft_distributed_agas_orchestrator_H_INCLUDED
+#define hpxfft_distributed_agas_orchestrator_H_INCLUDED
+
+#include "agas.hpp"
+#include <hpx/hpx.hpp>
+
+namespace hpxfft::fft2D::distributed
+{
+///////////////////////////////////////////////////////////////////////////////
+// Client that drives one agas_server per locality from a single locality.
+// The global input is split into row slabs, slab i is moved to locality i.
+struct agas_orchestrator
+{
+    typedef std::vector<hpx::future<void>> vector_future;
+
+  public:
+    agas_orchestrator();
+
+    hpx::future<void> initialize(vector_2d values_vec, const std::string COMM_FLAG, const std::string PLAN_FLAG);
+
+    hpx::future<void> fft_2d_r2c();
+
+    vector_2d get_result();
+
+    ~agas_orchestrator() = default;
+
+  private:
+    // parameters
+    std::size_t num_localities_;
+    std::size_t n_x_local_, n_col_;
+    // one client per locality, ordered by locality id
+    std::vector<agas> servers_;
+    // distributed results
+    std::vector<vector_2d> slabs_;
+};
+}  // namespace hpxfft::fft2D::distributed
+#endif  // hpxfft_distributed_agas_orchestrator_H_INCLUDED
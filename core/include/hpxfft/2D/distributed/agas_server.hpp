@@ -2,8 +2,9 @@
 #ifndef hpxfft_distributed_agas_server_H_INCLUDED
 #define hpxfft_distributed_agas_server_H_INCLUDED
 
-#include "../../util/adapter_fftw.hpp"
-#include "../../util/vector_2d.hpp"  // for hpxfft::util::vector_2d
+#include "../../util/fft_backend.hpp"
+#include "../../util/task_graph.hpp"  // for hpxfft::util::task_graph
+#include "../../util/vector_2d.hpp"   // for hpxfft::util::vector_2d
 #include <hpx/future.hpp>
 #include <hpx/modules/collectives.hpp>
 #include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
@@ -16,7 +17,6 @@ using vector_2d = hpxfft::util::vector_2d<real>;
 
 struct agas_server : hpx::components::component_base<agas_server>
 {
-    typedef std::vector<hpx::future<void>> vector_future;
     typedef std::vector<std::vector<real>> vector_comm;
 
   public:
@@ -24,64 +24,59 @@ struct agas_server : hpx::components::component_base<agas_server>
 
     void initialize(vector_2d values_vec, const std::string COMM_FLAG, const std::string PLAN_FLAG);
 
-    vector_2d fft_2d_r2c();
+    // replace the local input of the same shape, plans, communicators and task graph are kept
+    void set_values(vector_2d values_vec);
 
-    ~agas_server() { hpxfft::util::fftw_adapter::cleanup(); }
+    // the action completes once the task graph finished, no thread is blocked on the server
+    hpx::future<vector_2d> fft_2d_r2c();
 
   private:
     // FFT backend
     void fft_1d_r2c_inplace(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, fft_1d_r2c_inplace, fft_1d_r2c_inplace_action)
     void fft_1d_c2c_inplace(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, fft_1d_c2c_inplace, fft_1d_c2c_inplace_action)
+
+    // the previous exchange moved the buffers out
+    void prepare_communication(vector_comm &prep, const std::size_t block_size);
 
     // split data for communication
     void split_vec(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, split_vec, split_vec_action)
-
     void split_trans_vec(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, split_trans_vec, split_trans_vec_action)
 
     // scatter communication
     void communicate_scatter_vec(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, communicate_scatter_vec, communicate_scatter_vec_action)
-
     void communicate_scatter_trans_vec(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, communicate_scatter_trans_vec, communicate_scatter_trans_vec_action)
 
     // all to all communication
     void communicate_all_to_all_vec();
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, communicate_all_to_all_vec, communicate_all_to_all_vec_action)
-
     void communicate_all_to_all_trans_vec();
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, communicate_all_to_all_trans_vec, communicate_all_to_all_trans_vec_action)
 
     // transpose after communication
     void transpose_y_to_x(const std::size_t k, const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, transpose_y_to_x, transpose_y_to_x_action)
-
     void transpose_x_to_y(const std::size_t k, const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, transpose_x_to_y, transpose_x_to_y_action)
+
+    // transpose of the block that stays on this locality (bypasses communication)
+    void transpose_y_to_x_local(const std::size_t k);
+    void transpose_x_to_y_local(const std::size_t j);
+
+    // build task graph once during initialization: the server only
+    // schedules work on itself, so nodes invoke member functions directly
+    void build_task_graph();
 
   private:
     // parameters
     std::size_t n_x_local_, n_y_local_;
     std::size_t dim_r_y_, dim_c_y_, dim_c_x_;
+    // planner flag for re-planning in set_values()
+    std::string PLAN_FLAG_;
     std::size_t dim_c_y_part_, dim_c_x_part_;
     // 1D adapters
-    hpxfft::util::fftw_adapter::r2c_1d fft_r2c_adapter_;
-    hpxfft::util::fftw_adapter::c2c_1d fft_c2c_adapter_;
+    hpxfft::util::fft_backend::r2c_1d fft_r2c_adapter_;
+    hpxfft::util::fft_backend::c2c_1d fft_c2c_adapter_;
     // value vectors
     vector_2d values_vec_;
     vector_2d trans_values_vec_;
-    // future vectors
-    vector_future r2c_futures_;
-    vector_future split_vec_futures_;
-    std::vector<hpx::shared_future<void>> communication_futures_;
-    std::vector<vector_future> trans_y_to_x_futures_;
-    vector_future c2c_futures_;
-    vector_future split_trans_vec_futures_;
-    std::vector<vector_future> trans_x_to_y_futures_;
+    // task graph replayed on every transform
+    hpxfft::util::task_graph task_graph_;
     // communication vectors
     vector_comm values_prep_;
     vector_comm trans_values_prep_;
@@ -92,6 +87,8 @@ struct agas_server : hpx::components::component_base<agas_server>
     std::string COMM_FLAG_;
     std::vector<const char *> basenames_;
     std::vector<hpx::collectives::communicator> communicators_;
+    // collective generations of the current run, two exchanges per run
+    std::size_t generation_ = 0;
 };
 }  // namespace hpxfft::fft2D::distributed
 
@@ -99,4 +96,6 @@ HPX_DEFINE_COMPONENT_ACTION(hpxfft::fft2D::distributed::agas_server, initialize,
 
 HPX_DEFINE_COMPONENT_ACTION(hpxfft::fft2D::distributed::agas_server, fft_2d_r2c, fft_2d_r2c_action)
 
+HPX_DEFINE_COMPONENT_ACTION(hpxfft::fft2D::distributed::agas_server, set_values, set_values_action)
+
 #endif  // hpxfft_distributed_agas_server_H_INCLUDED
@@ -2,8 +2,9 @@
 #ifndef hpxfft_distributed_loop_H_INCLUDED
 #define hpxfft_distributed_loop_H_INCLUDED
 
-#include "../../util/adapter_fftw.hpp"
+#include "../../util/fft_backend.hpp"
 #include "../../util/vector_2d.hpp"  // for hpxfft::util::vector_2d
+#include <hpx/execution.hpp>
 #include <hpx/future.hpp>
 #include <hpx/modules/collectives.hpp>
 #include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
@@ -24,17 +25,24 @@ struct loop
 
     void initialize(vector_2d values_vec, const std::string COMM_FLAG, const std::string PLAN_FLAG);
 
+    // replace the local input of the same shape, plans and communicators are kept
+    void set_values(vector_2d values_vec);
+
     vector_2d fft_2d_r2c();
 
-    real get_measurement(std::string name);
+    // non-blocking, the future becomes ready with the transformed data
+    hpx::future<vector_2d> fft_2d_r2c_async();
 
-    ~loop() { hpxfft::util::fftw_adapter::cleanup(); }
+    real get_measurement(std::string name);
 
   private:
     // FFT backend
     void fft_1d_r2c_inplace(const std::size_t i);
     void fft_1d_c2c_inplace(const std::size_t i);
 
+    // the previous exchange moved the buffers out
+    void prepare_communication(vector_comm &prep, const std::size_t block_size);
+
     // split data for communication
     void split_vec(const std::size_t i);
     void split_trans_vec(const std::size_t i);
@@ -47,26 +55,41 @@ struct loop
     void communicate_all_to_all_vec();
     void communicate_all_to_all_trans_vec();
 
+    // start communication, ready once the received data is stored in communication_vec_
+    hpx::future<void> communicate_vec();
+    hpx::future<void> communicate_trans_vec();
+    hpx::future<void> collect_communication();
+
     // transpose after communication
     void transpose_y_to_x(const std::size_t k, const std::size_t i);
     void transpose_x_to_y(const std::size_t j, const std::size_t i);
 
+    // transpose of the block that stays on this locality (bypasses communication)
+    void transpose_y_to_x_local(const std::size_t k);
+    void transpose_x_to_y_local(const std::size_t j);
+
   private:
     // parameters
     std::size_t n_x_local_, n_y_local_;
     std::size_t dim_r_y_, dim_c_y_, dim_c_x_;
+    // planner flag for re-planning in set_values()
+    std::string PLAN_FLAG_;
     std::size_t dim_c_y_part_, dim_c_x_part_;
     // 1D adapters
-    hpxfft::util::fftw_adapter::r2c_1d fft_r2c_adapter_;
-    hpxfft::util::fftw_adapter::c2c_1d fft_c2c_adapter_;
+    hpxfft::util::fft_backend::r2c_1d fft_r2c_adapter_;
+    hpxfft::util::fft_backend::c2c_1d fft_c2c_adapter_;
     // value vectors
     vector_2d values_vec_;
     vector_2d trans_values_vec_;
     // future vectors
     std::vector<hpx::future<std::vector<real>>> communication_futures_;
+    hpx::future<vector_comm> all_to_all_future_;
     // time measurement
     hpx::chrono::high_resolution_timer t_ = hpx::chrono::high_resolution_timer();
     std::map<std::string, real> measurements_;
+    // phase time stamps
+    real start_total_, start_first_split_, start_first_comm_, start_first_trans_;
+    real start_second_fft_, start_second_split_, start_second_comm_, start_second_trans_;
     // communication vectors
     vector_comm values_prep_;
     vector_comm trans_values_prep_;
@@ -77,6 +100,11 @@ struct loop
     std::string COMM_FLAG_;
     std::vector<const char *> basenames_;
     std::vector<hpx::collectives::communicator> communicators_;
+    // collective generation of the last exchange, two exchanges per run
+    std::size_t generation_ = 0;
+    // executors of the communication and compute pools
+    hpx::execution::parallel_executor communication_executor_;
+    hpx::execution::parallel_executor compute_executor_;
 };
 }  // namespace hpxfft::fft2D::distributed
 #endif  // hpxfft_distributed_loop_H_INCLUDED
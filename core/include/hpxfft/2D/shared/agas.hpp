@@ -18,6 +18,9 @@ struct agas : ::hpx::components::client_base<agas, agas_server>
 
     hpx::future<vector_2d> fft_2d_r2c() { return ::hpx::async(fft_2d_r2c_action(), get_id()); }
 
+    // same as fft_2d_r2c(), the client is asynchronous by construction
+    hpx::future<vector_2d> fft_2d_r2c_async() { return fft_2d_r2c(); }
+
     hpx::future<void> initialize(vector_2d values_vec, const std::string PLAN_FLAG)
     {
         return ::hpx::async(initialize_action(), get_id(), std::move(values_vec), PLAN_FLAG);
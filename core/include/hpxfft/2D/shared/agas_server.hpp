@@ -2,8 +2,9 @@
 #ifndef hpxfft_shared_agas_server_H_INCLUDED
 #define hpxfft_shared_agas_server_H_INCLUDED
 
-#include "../../util/adapter_fftw.hpp"
-#include "../../util/vector_2d.hpp"  // for hpxfft::util::vector_2d
+#include "../../util/fft_backend.hpp"
+#include "../../util/task_graph.hpp"  // for hpxfft::util::task_graph
+#include "../../util/vector_2d.hpp"   // for hpxfft::util::vector_2d
 #include <hpx/future.hpp>
 #include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
 
@@ -15,44 +16,38 @@ using vector_2d = hpxfft::util::vector_2d<real>;
 
 struct agas_server : hpx::components::component_base<agas_server>
 {
-    typedef std::vector<hpx::future<void>> vector_future;
-
   public:
     agas_server() = default;
 
     void initialize(vector_2d values_vec, const std::string PLAN_FLAG);
 
-    vector_2d fft_2d_r2c();
-
-    ~agas_server() { hpxfft::util::fftw_adapter::cleanup(); }
+    // the action completes once the task graph finished, no thread is blocked on the server
+    hpx::future<vector_2d> fft_2d_r2c();
 
   private:
     // FFT backend
     void fft_1d_r2c_inplace(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, fft_1d_r2c_inplace, fft_1d_r2c_inplace_action)
     void fft_1d_c2c_inplace(const std::size_t i);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, fft_1d_c2c_inplace, fft_1d_c2c_inplace_action)
 
     // transpose
     void transpose_shared_y_to_x(const std::size_t index);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, transpose_shared_y_to_x, transpose_shared_y_to_x_action)
     void transpose_shared_x_to_y(const std::size_t index_trans);
-    HPX_DEFINE_COMPONENT_ACTION(agas_server, transpose_shared_x_to_y, transpose_shared_x_to_y_action)
+
+    // build task graph once during initialization
+    void build_task_graph();
 
   private:
     // parameters
     std::size_t dim_r_y_, dim_c_y_, dim_c_x_;
     // 1D adapters
-    hpxfft::util::fftw_adapter::r2c_1d fft_r2c_adapter_;
-    hpxfft::util::fftw_adapter::c2c_1d fft_c2c_adapter_;
+    hpxfft::util::fft_backend::r2c_1d fft_r2c_adapter_;
+    hpxfft::util::fft_backend::c2c_1d fft_c2c_adapter_;
     // value vectors
     vector_2d values_vec_;
     vector_2d trans_values_vec_;
-    // future vectors
-    vector_future r2c_futures_;
-    vector_future trans_y_to_x_futures_;
-    vector_future c2c_futures_;
-    vector_future trans_x_to_y_futures_;
+    // task graph replayed on every transform,
+    // nodes call the member functions directly instead of through actions
+    hpxfft::util::task_graph task_graph_;
 };
 
 }  // namespace hpxfft::fft2D::shared
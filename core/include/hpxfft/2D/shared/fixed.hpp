@@ -0,0 +1,248 @@
+#pragma once
+#ifndef hpxfft_shared_fixed_H_INCLUDED
+#define hpxfft_shared_fixed_H_INCLUDED
+
+#include "../../util/vector_2d.hpp"  // for hpxfft::util::vector_2d
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+typedef double real;
+
+namespace hpxfft::fft2D::shared
+{
+using vector_2d = hpxfft::util::vector_2d<real>;
+
+namespace fixed_detail
+{
+constexpr real pi = 3.14159265358979323846264338327950288;
+
+constexpr bool is_power_of_two(std::size_t n) { return n > 0 && (n & (n - 1)) == 0; }
+
+// Taylor series for x in [0, pi], std::sin and std::cos are not constexpr
+constexpr real sin(real x)
+{
+    real term = x;
+    real sum = x;
+    for (int n = 1; n < 30; ++n)
+    {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr real cos(real x)
+{
+    real term = 1.0;
+    real sum = 1.0;
+    for (int n = 1; n < 30; ++n)
+    {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// forward twiddles exp(-2 pi i k / N) for k < N / 2, exact on the axes
+template <std::size_t N>
+constexpr std::array<real, N> make_twiddles()
+{
+    std::array<real, N> twiddles{};
+    for (std::size_t k = 0; k < N / 2; ++k)
+    {
+        real re = cos(2 * pi * k / N);
+        real im = -sin(2 * pi * k / N);
+        if (4 * k == N)
+        {
+            re = 0.0;
+            im = -1.0;
+        }
+        twiddles[2 * k] = k == 0 ? 1.0 : re;
+        twiddles[2 * k + 1] = k == 0 ? 0.0 : im;
+    }
+    return twiddles;
+}
+
+template <std::size_t N>
+constexpr std::array<std::size_t, N> make_bit_reversal()
+{
+    std::array<std::size_t, N> index{};
+    std::size_t bits = 0;
+    while ((std::size_t(1) << bits) < N)
+    {
+        ++bits;
+    }
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        std::size_t reversed = 0;
+        for (std::size_t b = 0; b < bits; ++b)
+        {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        index[i] = reversed;
+    }
+    return index;
+}
+
+// Radix-2 decimation in time FFT of length N on "elements" of WIDTH
+// interleaved complex values with a distance of STRIDE reals. WIDTH = 1
+// transforms one interleaved array, WIDTH > 1 transforms WIDTH columns at
+// once with contiguous inner loops. All bounds are compile-time constants.
+template <std::size_t N, std::size_t WIDTH, std::size_t STRIDE>
+struct radix_2
+{
+    static constexpr std::array<real, N> twiddles = make_twiddles<N>();
+    static constexpr std::array<std::size_t, N> bit_reversal = make_bit_reversal<N>();
+
+    static inline void swap_elements(real *values, std::size_t i, std::size_t j) noexcept
+    {
+        real *a = values + i * STRIDE;
+        real *b = values + j * STRIDE;
+        for (std::size_t c = 0; c < 2 * WIDTH; ++c)
+        {
+            std::swap(a[c], b[c]);
+        }
+    }
+
+    template <std::size_t LEN>
+    static inline void stage(real *values) noexcept
+    {
+        constexpr std::size_t half = LEN / 2;
+        constexpr std::size_t step = N / LEN;
+        for (std::size_t start = 0; start < N; start += LEN)
+        {
+            for (std::size_t k = 0; k < half; ++k)
+            {
+                const real w_re = twiddles[2 * k * step];
+                const real w_im = twiddles[2 * k * step + 1];
+                real *a = values + (start + k) * STRIDE;
+                real *b = values + (start + k + half) * STRIDE;
+                for (std::size_t c = 0; c < WIDTH; ++c)
+                {
+                    // butterfly
+                    const real t_re = w_re * b[2 * c] - w_im * b[2 * c + 1];
+                    const real t_im = w_re * b[2 * c + 1] + w_im * b[2 * c];
+                    b[2 * c] = a[2 * c] - t_re;
+                    b[2 * c + 1] = a[2 * c + 1] - t_im;
+                    a[2 * c] += t_re;
+                    a[2 * c + 1] += t_im;
+                }
+            }
+        }
+        if constexpr (LEN < N)
+        {
+            stage<2 * LEN>(values);
+        }
+    }
+
+    static inline void execute(real *values) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (i < bit_reversal[i])
+            {
+                swap_elements(values, i, bit_reversal[i]);
+            }
+        }
+        if constexpr (N > 1)
+        {
+            stage<2>(values);
+        }
+    }
+};
+}  // namespace fixed_detail
+
+///////////////////////////////////////////////////////////////////////////////
+// 2D r2c FFT for small shapes known at compile time. NX and NY are powers of
+// two. The data layout is the one of the other shared engines: NX rows with
+// 2 * (NY / 2 + 1) reals, the first NY of them hold the input. Twiddles and
+// loop bounds are compile-time constants and nothing is allocated.
+template <std::size_t NX, std::size_t NY>
+struct fixed_fft_2d
+{
+    static_assert(fixed_detail::is_power_of_two(NX), "NX has to be a power of two");
+    static_assert(fixed_detail::is_power_of_two(NY) && NY >= 2, "NY has to be a power of two of at least 2");
+
+  public:
+    static constexpr std::size_t dim_c_x = NX;
+    static constexpr std::size_t dim_c_y = NY / 2 + 1;
+    static constexpr std::size_t dim_r_y = NY;
+    static constexpr std::size_t n_col = 2 * dim_c_y;
+
+    fixed_fft_2d() = default;
+
+    void initialize(vector_2d values_vec)
+    {
+        if (values_vec.n_row() != NX || values_vec.n_col() != n_col)
+        {
+            throw std::invalid_argument("Input dimensions do not match the fixed transform size");
+        }
+        values_vec_ = std::move(values_vec);
+    }
+
+    vector_2d fft_2d_r2c()
+    {
+        fft_2d_r2c_inplace(values_vec_.data());
+        return std::move(values_vec_);
+    }
+
+    // in-place transform of NX * n_col reals
+    static inline void fft_2d_r2c_inplace(real *values) noexcept
+    {
+        // first dimension
+        // 1d FFT r2c in y-direction
+        for (std::size_t i = 0; i < NX; ++i)
+        {
+            fft_1d_r2c_inplace(values + i * n_col);
+        }
+        // second dimension
+        // 1D FFT c2c in x-direction on all columns at once, no transpose needed
+        fixed_detail::radix_2<NX, dim_c_y, n_col>::execute(values);
+    }
+
+  private:
+    // real FFT of length NY as complex FFT of length NY / 2 and a post-processing step
+    static inline void fft_1d_r2c_inplace(real *row) noexcept
+    {
+        constexpr std::size_t M = NY / 2;
+        fixed_detail::radix_2<M, 1, 2>::execute(row);
+        // Z[M] = Z[0]
+        const real z0_re = row[0];
+        const real z0_im = row[1];
+        row[0] = z0_re + z0_im;
+        row[1] = 0.0;
+        row[2 * M] = z0_re - z0_im;
+        row[2 * M + 1] = 0.0;
+        for (std::size_t k = 1; 2 * k <= M; ++k)
+        {
+            const real w_re = real_twiddles[2 * k];
+            const real w_im = real_twiddles[2 * k + 1];
+            const real a_re = row[2 * k];
+            const real a_im = row[2 * k + 1];
+            const real b_re = row[2 * (M - k)];
+            const real b_im = row[2 * (M - k) + 1];
+            // E = (A + conj(B)) / 2, O = (A - conj(B)) / 2i
+            const real e_re = 0.5 * (a_re + b_re);
+            const real e_im = 0.5 * (a_im - b_im);
+            const real o_re = 0.5 * (a_im + b_im);
+            const real o_im = -0.5 * (a_re - b_re);
+            // X[k] = E + W^k O, X[M - k] = conj(E - W^k O)
+            const real t_re = w_re * o_re - w_im * o_im;
+            const real t_im = w_re * o_im + w_im * o_re;
+            row[2 * k] = e_re + t_re;
+            row[2 * k + 1] = e_im + t_im;
+            row[2 * (M - k)] = e_re - t_re;
+            row[2 * (M - k) + 1] = t_im - e_im;
+        }
+    }
+
+    // exp(-2 pi i k / NY) for k < NY / 2
+    static constexpr std::array<real, NY> real_twiddles = fixed_detail::make_twiddles<NY>();
+
+  private:
+    vector_2d values_vec_;
+};
+}  // namespace hpxfft::fft2D::shared
+#endif  // hpxfft_shared_fixed_H_INCLUDED
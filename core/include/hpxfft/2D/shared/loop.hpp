@@ -2,8 +2,11 @@
 #ifndef hpxfft_shared_loop_H_INCLUDED
 #define hpxfft_shared_loop_H_INCLUDED
 
-#include "../../util/adapter_fftw.hpp"
+#include "../../util/fft_backend.hpp"
+#include "../../util/loop_chunking.hpp"             // for hpxfft::util::chunk_param, hpxfft::util::chunk_tuner
 #include "../../util/vector_2d.hpp"                 // for hpxfft::util::vector_2d
+#include <functional>
+#include <hpx/future.hpp>
 #include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
 
 typedef double real;
@@ -12,23 +15,43 @@ namespace hpxfft::fft2D::shared
 {
 using vector_2d = hpxfft::util::vector_2d<real>;
 
+// chunking of the four parallel phases of loop::fft_2d_r2c_par()
+struct loop_chunking
+{
+    hpxfft::util::chunk_param first_fftw;
+    hpxfft::util::chunk_param first_trans;
+    hpxfft::util::chunk_param second_fftw;
+    hpxfft::util::chunk_param second_trans;
+};
+
 struct loop
 {
   public:
     loop() = default;
 
-    void initialize(vector_2d values_vec, const std::string PLAN_FLAG);
+    void initialize(vector_2d values_vec, const std::string PLAN_FLAG, const loop_chunking &CHUNKING = loop_chunking());
+
+    // replace the input of the same shape, plans and chunk tuning are kept
+    void set_values(vector_2d values_vec);
 
     vector_2d fft_2d_r2c_par();
 
+    // non-blocking fft_2d_r2c_par(), the future becomes ready with the transformed data
+    hpx::future<vector_2d> fft_2d_r2c_async();
+
     vector_2d fft_2d_r2c_seq();
 
+    // each worker thread transforms a fixed block of rows and transposes the
+    // tiles built from its own rows, the data stays in its cache between phases
+    vector_2d fft_2d_r2c_affinity();
+
+    // non-blocking fft_2d_r2c_affinity()
+    hpx::future<vector_2d> fft_2d_r2c_affinity_async();
+
     real get_measurement(std::string name);
 
     void write_plans_to_file(std::string file_path);
 
-    ~loop() { hpxfft::util::fftw_adapter::cleanup(); }
-
   private:
     // FFT backend
     void fft_1d_r2c_inplace(const std::size_t i);
@@ -41,19 +64,42 @@ struct loop
     //  transpose with read running index
     // void transpose_shared_x_to_y(const std::size_t index);
     void transpose_shared_x_to_y(const std::size_t index_trans);
+    // transpose of the tiles built from the rows [begin, end)
+    void transpose_y_to_x_rows(const std::size_t begin, const std::size_t end);
+
+    // run f(begin, end) for one block of [0, n) per worker thread on that worker,
+    // ready once all blocks are done
+    hpx::future<void>
+    for_each_worker_block(const std::size_t n, const std::function<void(std::size_t, std::size_t)> &f);
+
+    // number of FFTW threads per row for n_rows rows on n_threads threads
+    static std::size_t threads_per_row(const std::size_t n_rows, const std::size_t n_threads);
+
+    // chunking
+    const hpxfft::util::chunk_param &
+    chunk_param_of(const hpxfft::util::chunk_param &param, const hpxfft::util::chunk_tuner &tuner) const;
+    void record_chunk_runtimes();
 
   private:
     // parameters
     std::size_t dim_r_y_, dim_c_y_, dim_c_x_;
+    // planner flag and r2c threads for re-planning in set_values()
+    std::string PLAN_FLAG_;
+    int r2c_threads_ = 1;
     // 1D adapters
-    hpxfft::util::fftw_adapter::r2c_1d fft_r2c_adapter_;
-    hpxfft::util::fftw_adapter::c2c_1d fft_c2c_adapter_;
+    hpxfft::util::fft_backend::r2c_1d fft_r2c_adapter_;
+    hpxfft::util::fft_backend::c2c_1d fft_c2c_adapter_;
     // value vectors
     vector_2d values_vec_;
     vector_2d trans_values_vec_;
     // time measurement
     hpx::chrono::high_resolution_timer t_ = hpx::chrono::high_resolution_timer();
     std::map<std::string, real> measurements_;
+    // phase time stamps of the parallel transform
+    real start_total_, start_first_trans_, start_second_fft_, start_second_trans_;
+    // chunking of the parallel phases
+    loop_chunking chunking_;
+    hpxfft::util::chunk_tuner first_fftw_tuner_, first_trans_tuner_, second_fftw_tuner_, second_trans_tuner_;
 };
 }  // namespace hpxfft::fft2D::shared
 #endif  // hpxfft_shared_loop_H_INCLUDED
@@ -2,8 +2,9 @@
 #ifndef hpxfft_shared_naive_H_INCLUDED
 #define hpxfft_shared_naive_H_INCLUDED
 
-#include "../../util/adapter_fftw.hpp"
-#include "../../util/vector_2d.hpp"  // for hpxfft::util::vector_2d
+#include "../../util/fft_backend.hpp"
+#include "../../util/task_graph.hpp"  // for hpxfft::util::task_graph
+#include "../../util/vector_2d.hpp"   // for hpxfft::util::vector_2d
 #include <hpx/future.hpp>
 #include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
 
@@ -15,18 +16,20 @@ using vector_2d = hpxfft::util::vector_2d<real>;
 
 struct naive
 {
-    typedef std::vector<hpx::future<void>> vector_future;
-
   public:
     naive() = default;
 
     void initialize(vector_2d values_vec, const std::string PLAN_FLAG);
 
+    // replace the input of the same shape, plans and task graph are kept
+    void set_values(vector_2d values_vec);
+
     vector_2d fft_2d_r2c();
 
-    real get_measurement(std::string name);
+    // non-blocking, the future becomes ready with the transformed data
+    hpx::future<vector_2d> fft_2d_r2c_async();
 
-    ~naive() { hpxfft::util::fftw_adapter::cleanup(); }
+    real get_measurement(std::string name);
 
   private:
     // FFT backend
@@ -37,29 +40,25 @@ struct naive
     void transpose_shared_y_to_x(const std::size_t index_trans);
     void transpose_shared_x_to_y(const std::size_t index_trans);
 
-    // static wrappers
-    static void fft_1d_r2c_inplace_wrapper(naive *th, const std::size_t i);
-    static void fft_1d_c2c_inplace_wrapper(naive *th, const std::size_t i);
-    static void transpose_shared_y_to_x_wrapper(naive *th, const std::size_t index_trans);
-    static void transpose_shared_x_to_y_wrapper(naive *th, const std::size_t index_trans);
+    // build task graph once during initialization
+    void build_task_graph();
 
   private:
     // parameters
     std::size_t dim_r_y_, dim_c_y_, dim_c_x_;
+    // planner flag for re-planning in set_values()
+    std::string PLAN_FLAG_;
     // 1D adapters
-    hpxfft::util::fftw_adapter::r2c_1d fft_r2c_adapter_;
-    hpxfft::util::fftw_adapter::c2c_1d fft_c2c_adapter_;
+    hpxfft::util::fft_backend::r2c_1d fft_r2c_adapter_;
+    hpxfft::util::fft_backend::c2c_1d fft_c2c_adapter_;
     // value vectors
     vector_2d values_vec_;
     vector_2d trans_values_vec_;
     // time measurement
     hpx::chrono::high_resolution_timer t_ = hpx::chrono::high_resolution_timer();
     std::map<std::string, real> measurements_;
-    // future vectors
-    vector_future r2c_futures_;
-    vector_future trans_y_to_x_futures_;
-    vector_future c2c_futures_;
-    vector_future trans_x_to_y_futures_;
+    // task graph replayed on every transform
+    hpxfft::util::task_graph task_graph_;
 };
 }  // namespace hpxfft::fft2D::shared
 #endif  // hpxfft_shared_naive_H_INCLUDED
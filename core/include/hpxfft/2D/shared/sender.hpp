@@ -0,0 +1,100 @@
+#pragma once
+#ifndef hpxfft_shared_sender_H_INCLUDED
+#define hpxfft_shared_sender_H_INCLUDED
+
+#include "../../util/fft_backend.hpp"
+#include "../../util/vector_2d.hpp"  // for hpxfft::util::vector_2d
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
+
+typedef double real;
+
+namespace hpxfft::fft2D::shared
+{
+using vector_2d = hpxfft::util::vector_2d<real>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Engine based on senders: the 2D FFT is a single sender chain of bulk
+// stages on a thread pool scheduler. The chain can be composed with further
+// senders and only runs once it is started, no futures are allocated.
+struct sender
+{
+  public:
+    sender() = default;
+
+    void initialize(vector_2d values_vec, const std::string PLAN_FLAG);
+
+    // replace the input of the same shape, plans and scheduler are kept
+    void set_values(vector_2d values_vec);
+
+    // sender that completes with the transformed data
+    auto fft_2d_r2c_sender();
+
+    // start sender chain and wait for the result
+    vector_2d fft_2d_r2c();
+
+    // start sender chain, the future becomes ready with the transformed data
+    hpx::future<vector_2d> fft_2d_r2c_async();
+
+    real get_measurement(std::string name);
+
+  private:
+    // FFT backend
+    void fft_1d_r2c_inplace(const std::size_t i);
+    void fft_1d_c2c_inplace(const std::size_t i);
+
+    // transpose
+    void transpose_shared_y_to_x(const std::size_t index);
+    void transpose_shared_x_to_y(const std::size_t index_trans);
+
+    // store runtimes after the last stage
+    void finalize_measurements();
+
+  private:
+    // parameters
+    std::size_t dim_r_y_, dim_c_y_, dim_c_x_;
+    // planner flag for re-planning in set_values()
+    std::string PLAN_FLAG_;
+    // 1D adapters
+    hpxfft::util::fft_backend::r2c_1d fft_r2c_adapter_;
+    hpxfft::util::fft_backend::c2c_1d fft_c2c_adapter_;
+    // value vectors
+    vector_2d values_vec_;
+    vector_2d trans_values_vec_;
+    // scheduler of the default thread pool
+    hpx::execution::experimental::thread_pool_scheduler scheduler_;
+    // time measurement
+    hpx::chrono::high_resolution_timer t_ = hpx::chrono::high_resolution_timer();
+    std::map<std::string, real> measurements_;
+    // stage time stamps
+    real start_total_, start_first_trans_, start_second_fft_, start_second_trans_;
+};
+
+// 2D FFT algorithm
+inline auto sender::fft_2d_r2c_sender()
+{
+    namespace ex = hpx::execution::experimental;
+    return ex::schedule(scheduler_) | ex::then([this] { start_total_ = t_.now(); })
+           // first dimension
+           // 1d FFT r2c in y-direction
+           | ex::bulk(dim_c_x_, [this](std::size_t i) { fft_1d_r2c_inplace(i); })
+           | ex::then([this] { start_first_trans_ = t_.now(); })
+           // transpose from y-direction to x-direction
+           | ex::bulk(dim_c_y_, [this](std::size_t i) { transpose_shared_y_to_x(i); })
+           | ex::then([this] { start_second_fft_ = t_.now(); })
+           // second dimension
+           // 1D FFT c2c in x-direction
+           | ex::bulk(dim_c_y_, [this](std::size_t i) { fft_1d_c2c_inplace(i); })
+           | ex::then([this] { start_second_trans_ = t_.now(); })
+           // transpose from x-direction to y-direction
+           | ex::bulk(dim_c_y_, [this](std::size_t i) { transpose_shared_x_to_y(i); })
+           | ex::then(
+               [this]
+               {
+                   finalize_measurements();
+                   return std::move(values_vec_);
+               });
+}
+}  // namespace hpxfft::fft2D::shared
+#endif  // hpxfft_shared_sender_H_INCLUDED
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef hpxfft_shared_service_H_INCLUDED
+#define hpxfft_shared_service_H_INCLUDED
+
+#include "../../util/adapter_fftw.hpp"
+#include "../../util/vector_2d.hpp"  // for hpxfft::util::vector_2d
+#include <atomic>
+#include <hpx/concurrency/concurrentqueue.hpp>
+#include <hpx/future.hpp>
+#include <hpx/mutex.hpp>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+typedef double real;
+
+namespace hpxfft::fft2D::shared
+{
+using vector_2d = hpxfft::util::vector_2d<real>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Service for many small independent 2D FFTs: requests from any HPX task are
+// pushed into a lock-free queue, a single drain task groups them by shape and
+// runs each group as fftw_plan_many batches on pooled buffers. Plans and
+// buffers are kept for the lifetime of the service.
+struct service
+{
+  public:
+    explicit service(const std::string PLAN_FLAG = "estimate", const std::size_t MAX_BATCH = 64);
+
+    // thread-safe, input layout as for the other shared engines:
+    // n_x rows with 2 * (n_y / 2 + 1) reals, the future holds the transformed data
+    hpx::future<vector_2d> fft_2d_r2c_async(vector_2d values_vec);
+
+    vector_2d fft_2d_r2c(vector_2d values_vec);
+
+    ~service();
+
+  private:
+    struct request
+    {
+        vector_2d values_vec_;
+        hpx::promise<vector_2d> promise_;
+    };
+
+    // plans per batch size and free batch buffers of one shape
+    struct shape_cache
+    {
+        std::map<std::size_t, std::unique_ptr<hpxfft::util::fftw_adapter::r2c_2d_many>> plans_;
+        std::vector<real *> buffers_;
+    };
+
+    using shape = std::pair<std::size_t, std::size_t>;
+
+    // group queued requests by shape and post one task per batch
+    void drain();
+
+    void run_batch(std::vector<request> batch);
+
+  private:
+    // parameters
+    std::string PLAN_FLAG_;
+    std::size_t max_batch_;
+    // submission queue
+    hpx::concurrency::ConcurrentQueue<request> queue_;
+    std::atomic<bool> draining_{ false };
+    // outstanding requests and drain tasks
+    std::atomic<std::size_t> pending_{ 0 };
+    // plan and buffer pools, FFTW planning is not thread-safe
+    hpx::mutex mutex_;
+    std::map<shape, shape_cache> shapes_;
+};
+}  // namespace hpxfft::fft2D::shared
+#endif  // hpxfft_shared_service_H_INCLUDED
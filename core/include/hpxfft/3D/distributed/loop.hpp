@@ -0,0 +1,95 @@
+#pragma once
+#ifndef hpxfft_distributed_loop_3D_H_INCLUDED
+#define hpxfft_distributed_loop_3D_H_INCLUDED
+
+#include "../shared/shared_base.hpp"
+#include "../../util/vector_3d.hpp"              // for hpxfft::util::vector_3d
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
+
+typedef double real;
+
+namespace hpxfft::fft3D::distributed
+{
+using vector_3d = hpxfft::util::vector_3d<real>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Slab-decomposed 3D r2c FFT: every locality holds n_x / num_localities
+// x-slices of the x-y-z input. The z- and y-transforms are local, the global
+// transpose for the x-transform exchanges y-blocks between all localities.
+// The result is returned in the input decomposition and layout.
+struct loop : public hpxfft::fft3D::shared::base
+{
+    typedef std::vector<std::vector<real>> vector_comm;
+
+  public:
+    loop() = default;
+
+    void initialize(vector_3d values_vec, const std::string COMM_FLAG, const std::string PLAN_FLAG);
+
+    vector_3d fft_3d_r2c();
+
+    // non-blocking, the future becomes ready with the transformed data
+    hpx::future<vector_3d> fft_3d_r2c_async();
+
+    void write_plans_to_file(std::string file_path);
+
+  private:
+    // split data for communication
+    void split_vec(const std::size_t i);
+    void split_trans_vec(const std::size_t j);
+
+    // scatter communication
+    void communicate_scatter_vec(const std::size_t l);
+    void communicate_scatter_trans_vec(const std::size_t l);
+
+    // all to all communication
+    void communicate_all_to_all_vec();
+    void communicate_all_to_all_trans_vec();
+
+    // start communication, ready once the received data is stored in communication_vec_
+    hpx::future<void> communicate_vec();
+    hpx::future<void> communicate_trans_vec();
+    hpx::future<void> collect_communication();
+
+    // buffers are moved into the collectives
+    void prepare_communication(vector_comm &prep);
+
+    // transpose after communication
+    void transpose_y_to_x(const std::size_t j, const std::size_t l);
+    void transpose_x_to_y(const std::size_t i, const std::size_t l);
+
+    // transpose of the block that stays on this locality (bypasses communication)
+    void transpose_y_to_x_local(const std::size_t j);
+    void transpose_x_to_y_local(const std::size_t i);
+
+  private:
+    // parameters
+    std::size_t n_x_local_, n_y_local_;
+    // reals per communicated block
+    std::size_t block_size_;
+    // phase time stamps
+    real start_total_, start_first_permute_, start_second_fft_, start_first_split_, start_first_comm_;
+    real start_first_trans_, start_third_fft_, start_second_split_, start_second_comm_, start_second_trans_;
+    // communication vectors
+    vector_comm values_prep_;
+    vector_comm trans_values_prep_;
+    vector_comm communication_vec_;
+    // future vectors
+    std::vector<hpx::future<std::vector<real>>> communication_futures_;
+    hpx::future<vector_comm> all_to_all_future_;
+    // locality information
+    std::size_t this_locality_, num_localities_;
+    // communicators
+    std::string COMM_FLAG_;
+    std::vector<std::string> basenames_;
+    std::vector<hpx::collectives::communicator> communicators_;
+    std::size_t generation_ = 0;
+    // executors of the communication and compute pools
+    hpx::execution::parallel_executor communication_executor_;
+    hpx::execution::parallel_executor compute_executor_;
+};
+}  // namespace hpxfft::fft3D::distributed
+#endif  // hpxfft_distributed_loop_3D_H_INCLUDED
@@ -0,0 +1,115 @@
+#pragma once
+#ifndef hpxfft_distributed_pencil_3D_H_INCLUDED
+#define hpxfft_distributed_pencil_3D_H_INCLUDED
+
+#include "../../util/fft_backend.hpp"
+#include "../../util/vector_3d.hpp"              // for hpxfft::util::vector_3d
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/timing/high_resolution_timer.hpp>  // for hpx::chrono::high_resolution_timer
+#include <map>
+#include <string>
+#include <vector>
+
+typedef double real;
+
+namespace hpxfft::fft3D::distributed
+{
+using vector_3d = hpxfft::util::vector_3d<real>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Pencil-decomposed 3D r2c FFT on a P_row x P_col grid of localities. Locality
+// (r, c) holds the z-pencils of the r-th x-block and the c-th y-block of the
+// x-y-z input. Transposes only involve the P_col localities of a grid row
+// (z <-> y) or the P_row localities of a grid column (y <-> x), each with its
+// own communicator. The 1D FFTs run as one batched plan per slice. The result
+// is returned in the input decomposition and layout.
+struct pencil
+{
+    typedef std::vector<std::vector<real>> vector_comm;
+
+  public:
+    pencil() = default;
+
+    // P_ROW = 0: choose the most square grid
+    void initialize(vector_3d values_vec, const std::size_t P_ROW, const std::string PLAN_FLAG);
+
+    vector_3d fft_3d_r2c();
+
+    // non-blocking, the future becomes ready with the transformed data
+    hpx::future<vector_3d> fft_3d_r2c_async();
+
+    real get_measurement(std::string name);
+
+    void write_plans_to_file(std::string file_path);
+
+    // largest divisor of num_localities not exceeding its square root
+    static std::size_t default_grid_rows(const std::size_t num_localities);
+
+  private:
+    // batched FFTs of one slice
+    void fft_z_r2c(const std::size_t i);
+    void fft_y_c2c(const std::size_t i);
+    void fft_x_c2c(const std::size_t j);
+
+    // split data for communication, phase 0 to 3
+    void split_z_to_y(const std::size_t i);
+    void split_y_to_x(const std::size_t i);
+    void split_x_to_y(const std::size_t j);
+    void split_y_to_z(const std::size_t i);
+
+    // transpose after communication, phase 0 to 3
+    void transpose_z_to_y(const std::size_t i);
+    void transpose_y_to_x(const std::size_t j);
+    void transpose_x_to_y(const std::size_t i);
+    void transpose_y_to_z(const std::size_t i);
+
+    // all to all communication within the grid row (phase 0, 3) or grid column (phase 1, 2)
+    hpx::future<void> communicate(const std::size_t phase);
+
+    // split, communicate and transpose
+    hpx::future<void> exchange(const std::size_t phase);
+
+    // complex z-values per grid column, the last extents are smaller if not divisible
+    std::size_t n_z_part(const std::size_t c) const;
+    std::size_t z_offset(const std::size_t c) const;
+
+  private:
+    // parameters
+    std::size_t dim_r_z_, dim_c_z_, dim_c_y_, dim_c_x_;
+    // pencil extents: x and y of z-pencils, y of x-pencils, z of y- and x-pencils
+    std::size_t n_x_local_, n_y_local_, n_y_part_, n_z_local_;
+    // process grid
+    std::size_t this_locality_, num_localities_;
+    std::size_t n_rows_, n_cols_, this_row_, this_col_;
+    // batched FFT plans
+    std::string PLAN_FLAG_;
+    hpxfft::util::fft_backend::r2c_1d_many fft_r2c_adapter_dir_z_;
+    hpxfft::util::fft_backend::c2c_1d_many fft_c2c_adapter_dir_y_;
+    hpxfft::util::fft_backend::c2c_1d_many fft_c2c_adapter_dir_x_;
+    // value vectors: z-pencils (x, y, z), y-pencils (x, z, y) and x-pencils (y, z, x)
+    vector_3d values_vec_;
+    vector_3d trans_vec_;
+    // communication vectors
+    vector_comm send_vec_;
+    vector_comm communication_vec_;
+    // communicators of the grid row and the grid column
+    std::string row_basename_, col_basename_;
+    hpx::collectives::communicator row_communicator_;
+    hpx::collectives::communicator col_communicator_;
+    std::size_t row_generation_ = 0;
+    std::size_t col_generation_ = 0;
+    // executors of the communication and compute pools
+    hpx::execution::parallel_executor communication_executor_;
+    hpx::execution::parallel_executor compute_executor_;
+    // time measurement
+    hpx::chrono::high_resolution_timer t_ = hpx::chrono::high_resolution_timer();
+    std::map<std::string, real> measurements_;
+    // phase time stamps
+    real start_total_;
+    real start_fft_[3];
+    real start_split_[4], start_comm_[4], start_trans_[4];
+};
+}  // namespace hpxfft::fft3D::distributed
+#endif  // hpxfft_distributed_pencil_3D_H_INCLUDED
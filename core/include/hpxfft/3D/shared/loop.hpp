@@ -6,6 +6,7 @@
 #include "../../util/vector_3d.hpp"                 // for hpxfft::util::vector_3d
 #include <hpx/timing/high_resolution_timer.hpp>     // for hpx::chrono::high_resolution_timer
 #include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/future.hpp>
 
 typedef double real;
 
@@ -18,14 +19,36 @@ struct loop : public base
   public:
     loop() = default;
 
-    void initialize(vector_3d values_vec, const std::string PLAN_FLAG);
+    // TILE_DIM: permute tile size in complex entries
+    void initialize(vector_3d values_vec, const std::string PLAN_FLAG, const std::size_t TILE_DIM = 32);
+
+    // replace the input of the same shape, plans are kept and the buffers of the
+    // previous transform are reused: pass the last result back to avoid allocations
+    void set_values(vector_3d values_vec);
 
     vector_3d fft_3d_r2c_par();
 
+    // non-blocking fft_3d_r2c_par(), the future becomes ready with the transformed data
+    hpx::future<vector_3d> fft_3d_r2c_async();
+
     vector_3d fft_3d_r2c_seq();
 
+    // inverse of fft_3d_r2c_par() (unnormalized): takes the returned x-y-z spectrum,
+    // the real result is padded like the forward input
+    vector_3d fft_3d_c2r_par(vector_3d values_vec);
+
+    // non-blocking fft_3d_c2r_par()
+    hpx::future<vector_3d> fft_3d_c2r_async(vector_3d values_vec);
+
+    vector_3d fft_3d_c2r_seq(vector_3d values_vec);
+
     void write_plans_to_file(std::string file_path);
 
+  private:
+    // phase time stamps of the parallel transform
+    real start_total_, start_first_permute_, start_second_fft_, start_second_permute_;
+    real start_third_fft_, start_third_permute_;
+    real start_inverse_total_;
 };
 } // namespace hpxfft::fft3D::shared
 #endif  // hpxfft_shared_loop_3D_H_INCLUDED
@@ -20,22 +20,45 @@ struct naive : public base
   public:
     naive() = default;
 
-    void initialize(vector_3d values_vec, const std::string PLAN_FLAG);
+    // TILE_DIM: permute tile size in complex entries
+    void initialize(vector_3d values_vec, const std::string PLAN_FLAG, const std::size_t TILE_DIM = 32);
+
+    // replace the input of the same shape, plans are kept and the buffers of the
+    // previous transform are reused: pass the last result back to avoid allocations
+    void set_values(vector_3d values_vec);
 
     vector_3d fft_3d_r2c();
 
+    // non-blocking, the future becomes ready with the transformed data:
+    // x-slices run z-FFT, permute and y-FFT as independent task chains,
+    // the only barriers surround the permute that gathers all slices for the x-FFT
+    hpx::future<vector_3d> fft_3d_r2c_async();
+
+    // inverse of fft_3d_r2c() (unnormalized): takes the returned x-y-z spectrum,
+    // the real result is padded like the forward input
+    vector_3d fft_3d_c2r(vector_3d values_vec);
+
+    // non-blocking fft_3d_c2r()
+    hpx::future<vector_3d> fft_3d_c2r_async(vector_3d values_vec);
+
     void write_plans_to_file(std::string file_path);
 
   private:
     // static wrappers
-    static void fft_1d_r2c_inplace_wrapper(naive *th, const std::size_t i, const std::size_t j);
-    static void fft_1d_c2c_y_inplace_wrapper(naive *th, const std::size_t i, const std::size_t j);
-    static void fft_1d_c2c_x_inplace_wrapper(naive *th, const std::size_t i, const std::size_t j);
+    static void fft_1d_r2c_slice_wrapper(naive *th, const std::size_t i);
+    static void fft_1d_c2c_y_slice_wrapper(naive *th, const std::size_t i);
+    static void fft_1d_c2c_x_slice_wrapper(naive *th, const std::size_t i);
     static void permute_shared_x_z_y_wrapper(naive *th, const std::size_t slice_x);
     static void permute_shared_z_y_x_wrapper(naive *th, const std::size_t slice_y);
-    static void permute_shared_z_x_y_wrapper(naive *th, const std::size_t slice_x);
+    static void permute_shared_z_x_y_wrapper(naive *th, const std::size_t slice_y);
+    static void fft_1d_c2c_x_inv_slice_wrapper(naive *th, const std::size_t i);
+    static void fft_1d_c2c_y_inv_slice_wrapper(naive *th, const std::size_t i);
+    static void fft_1d_c2r_slice_wrapper(naive *th, const std::size_t i);
+    static void permute_inverse_y_z_x_wrapper(naive *th, const std::size_t slice_x);
+    static void permute_inverse_x_z_y_wrapper(naive *th, const std::size_t slice_z);
+    static void permute_inverse_x_y_z_wrapper(naive *th, const std::size_t slice_x);
 
-    // future vectors
+    // future vectors, reused by the inverse transform
     vector_future fft_z_r2c_futures_;
     vector_future permute_first_futures_;
     vector_future fft_y_c2c_futures_;
@@ -2,9 +2,14 @@
 #ifndef hpxfft_shared_base_3D_H_INCLUDED
 #define hpxfft_shared_base_3D_H_INCLUDED
 
-#include "../../util/adapter_fftw.hpp"
+#include "../../util/fft_backend.hpp"
 #include "../../util/vector_3d.hpp"                 // for hpxfft::util::vector_3d
 #include <hpx/timing/high_resolution_timer.hpp>     // for hpx::chrono::high_resolution_timer
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <map>
+#include <string>
 
 typedef double real;
 
@@ -20,25 +25,66 @@ struct base
     real get_measurement(std::string name);
 
   protected:
-    // FFT backend
-    void fft_1d_r2c_inplace(const std::size_t i, const std::size_t j);
-    void fft_1d_c2c_y_inplace(const std::size_t i, const std::size_t j);
-    void fft_1d_c2c_x_inplace(const std::size_t i, const std::size_t j);
+    // replace the input of the same shape, the intermediate buffer left by the
+    // previous transform becomes the permute target: no allocation per transform
+    void swap_in_values(vector_3d values_vec);
 
-    // permute
+    // take the x-y-z spectrum returned by the forward transform as input of the
+    // inverse transform, the other work buffer becomes the first permute target
+    void swap_in_spectrum(vector_3d values_vec);
+
+    // batched forward and backward plans over one slice,
+    // planned on scratch memory of at least one slice per layout
+    void plan_slices(real *scratch);
+
+    // true if the slices of both work buffers have the alignment of the planning scratch
+    bool slices_keep_alignment(real *scratch, const std::size_t slice);
+
+    // true if every plan accepts the buffer data: z- and y-plans execute at
+    // offsets of step_yz, x-plans at offsets of step_x
+    bool plans_accept(real *data, const std::size_t step_yz, const std::size_t step_x) const;
+
+    // after a swap-in: re-plan on scratch with FFTW_UNALIGNED if a caller buffer
+    // breaks the alignment the slice plans were created for
+    void keep_plans_valid(real *scratch);
+
+    // FFT backend, one batched transform per slice
+    void fft_1d_r2c_slice(const std::size_t i);
+    void fft_1d_c2c_y_slice(const std::size_t i);
+    void fft_1d_c2c_x_slice(const std::size_t i);
+    void fft_1d_c2c_x_inv_slice(const std::size_t i);
+    void fft_1d_c2c_y_inv_slice(const std::size_t i);
+    void fft_1d_c2r_slice(const std::size_t i);
+
+    // permute, tiled with dim_tile_ x dim_tile_ complex entries across the swapped axes
     void permute_shared_x_z_y(const std::size_t slice_x);
     void permute_shared_z_y_x(const std::size_t slice_y);
-    void permute_shared_z_x_y(const std::size_t slice_z);
+    void permute_shared_z_x_y(const std::size_t slice_y);
+
+    // inverse permutes, named after the target layout
+    void permute_inverse_y_z_x(const std::size_t slice_x);
+    void permute_inverse_x_z_y(const std::size_t slice_z);
+    void permute_inverse_x_y_z(const std::size_t slice_x);
+
+    static void copy_complex(real *to, const real *from);
 
   protected:
     // prarameters
     std::size_t dim_r_z_, dim_c_z_, dim_c_y_, dim_c_x_;
-    // FFTW plans
-    hpxfft::util::fftw_plan_flag PLAN_FLAG_;
+    // FFTW plans: z-rows of an x-y-z slice, y-rows of an x-z-y slice, x-rows of a y-z-x slice
+    std::string PLAN_FLAG_;
     // IMPORTANT: declare r2c adapter before c2c so r2c destructor is called after c2c
-    hpxfft::util::fftw_adapter_r2c fftw_r2c_adapter_dir_z_;
-    hpxfft::util::fftw_adapter_c2c fftw_c2c_adapter_dir_y_;
-    hpxfft::util::fftw_adapter_c2c fftw_c2c_adapter_dir_x_;
+    hpxfft::util::fft_backend::r2c_1d_many fftw_r2c_adapter_dir_z_;
+    hpxfft::util::fft_backend::c2c_1d_many fftw_c2c_adapter_dir_y_;
+    hpxfft::util::fft_backend::c2c_1d_many fftw_c2c_adapter_dir_x_;
+    // backward plans of the same layouts
+    hpxfft::util::fft_backend::c2r_1d_many fftw_c2r_adapter_dir_z_;
+    hpxfft::util::fft_backend::c2c_1d_many fftw_c2c_inv_adapter_dir_y_;
+    hpxfft::util::fft_backend::c2c_1d_many fftw_c2c_inv_adapter_dir_x_;
+    // permute tile size in complex entries
+    std::size_t dim_tile_ = 32;
+    // set once caller buffers broke the planned alignment, later plans accept any
+    bool plan_unaligned_ = false;
     // value vectors
     vector_3d values_vec_;
     vector_3d permuted_vec_;
@@ -52,39 +98,167 @@ inline real hpxfft::fft3D::shared::base::get_measurement(std::string name)
     return measurements_[name];
 }
 
-inline void hpxfft::fft3D::shared::base::fft_1d_r2c_inplace(const std::size_t i, const std::size_t j)
+inline void hpxfft::fft3D::shared::base::swap_in_values(vector_3d values_vec)
+{
+    if (values_vec.n_x() != dim_c_x_ || values_vec.n_y() != dim_c_y_ || values_vec.n_z() != 2 * dim_c_z_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    vector_3d previous = std::move(values_vec_);
+    values_vec_ = std::move(values_vec);
+    // the result was moved out of permuted_vec_, the previous buffer takes its place
+    if (permuted_vec_.size() == 0)
+    {
+        permuted_vec_ = std::move(previous);
+        permuted_vec_.rearrange(dim_c_x_, dim_c_z_, 2 * dim_c_y_);
+    }
+    // permuted_vec_ is free until the transform runs
+    keep_plans_valid(permuted_vec_.data());
+}
+
+inline void hpxfft::fft3D::shared::base::swap_in_spectrum(vector_3d values_vec)
+{
+    if (values_vec.n_x() != dim_c_x_ || values_vec.n_y() != dim_c_y_ || values_vec.n_z() != 2 * dim_c_z_)
+    {
+        throw std::invalid_argument("Spectrum dimensions do not match the initialized plans");
+    }
+    // after a forward transform only values_vec_ is left, after an inverse one only permuted_vec_
+    vector_3d work = values_vec_.size() != 0 ? std::move(values_vec_) : std::move(permuted_vec_);
+    permuted_vec_ = std::move(values_vec);
+    values_vec_ = std::move(work);
+    // the spectrum need not come from this engine, values_vec_ is free
+    keep_plans_valid(values_vec_.data());
+}
+
+inline bool hpxfft::fft3D::shared::base::slices_keep_alignment(real *scratch, const std::size_t slice)
+{
+    return hpxfft::util::fftw_adapter::keeps_alignment(scratch, values_vec_.data(), slice)
+        && hpxfft::util::fftw_adapter::keeps_alignment(scratch, permuted_vec_.data(), slice);
+}
+
+inline bool hpxfft::fft3D::shared::base::plans_accept(real *data,
+                                                      const std::size_t step_yz,
+                                                      const std::size_t step_x) const
+{
+    return fftw_r2c_adapter_dir_z_.accepts(data, step_yz) && fftw_c2c_adapter_dir_y_.accepts(data, step_yz)
+        && fftw_c2c_adapter_dir_x_.accepts(data, step_x) && fftw_c2r_adapter_dir_z_.accepts(data, step_yz)
+        && fftw_c2c_inv_adapter_dir_y_.accepts(data, step_yz) && fftw_c2c_inv_adapter_dir_x_.accepts(data, step_x);
+}
+
+inline void hpxfft::fft3D::shared::base::keep_plans_valid(real *scratch)
+{
+    const std::size_t slice_yz = 2 * dim_c_y_ * dim_c_z_;
+    const std::size_t slice_x = 2 * dim_c_z_ * dim_c_x_;
+    if (plans_accept(values_vec_.data(), slice_yz, slice_x) && plans_accept(permuted_vec_.data(), slice_yz, slice_x))
+    {
+        return;
+    }
+    // once is enough: the new plans accept buffers of any alignment
+    plan_unaligned_ = true;
+    plan_slices(scratch);
+}
+
+inline void hpxfft::fft3D::shared::base::plan_slices(real *scratch)
+{
+    // plans run on other slices than the scratch: FFTW_UNALIGNED if the alignment differs
+    const bool aligned_yz = !plan_unaligned_ && slices_keep_alignment(scratch, 2 * dim_c_y_ * dim_c_z_);
+    const bool aligned_x = !plan_unaligned_ && slices_keep_alignment(scratch, 2 * dim_c_z_ * dim_c_x_);
+    // r2c in z-direction: dim_c_y rows per x-slice
+    fftw_r2c_adapter_dir_z_.plan(dim_r_z_, dim_c_y_, PLAN_FLAG_, scratch, aligned_yz);
+    // c2c in y-direction: dim_c_z rows per x-slice
+    fftw_c2c_adapter_dir_y_.plan(dim_c_y_,
+                                 dim_c_z_,
+                                 1,
+                                 dim_c_y_,
+                                 PLAN_FLAG_,
+                                 reinterpret_cast<fftw_complex *>(scratch),
+                                 hpxfft::util::fftw_adapter::direction::forward,
+                                 aligned_yz);
+    // c2c in x-direction: dim_c_z rows per y-slice
+    fftw_c2c_adapter_dir_x_.plan(dim_c_x_,
+                                 dim_c_z_,
+                                 1,
+                                 dim_c_x_,
+                                 PLAN_FLAG_,
+                                 reinterpret_cast<fftw_complex *>(scratch),
+                                 hpxfft::util::fftw_adapter::direction::forward,
+                                 aligned_x);
+    // backward plans
+    fftw_c2r_adapter_dir_z_.plan(dim_r_z_, dim_c_y_, PLAN_FLAG_, scratch, aligned_yz);
+    fftw_c2c_inv_adapter_dir_y_.plan(dim_c_y_,
+                                     dim_c_z_,
+                                     1,
+                                     dim_c_y_,
+                                     PLAN_FLAG_,
+                                     reinterpret_cast<fftw_complex *>(scratch),
+                                     hpxfft::util::fftw_adapter::direction::backward,
+                                     aligned_yz);
+    fftw_c2c_inv_adapter_dir_x_.plan(dim_c_x_,
+                                     dim_c_z_,
+                                     1,
+                                     dim_c_x_,
+                                     PLAN_FLAG_,
+                                     reinterpret_cast<fftw_complex *>(scratch),
+                                     hpxfft::util::fftw_adapter::direction::backward,
+                                     aligned_x);
+}
+
+inline void hpxfft::fft3D::shared::base::fft_1d_r2c_slice(const std::size_t i)
+{
+    fftw_r2c_adapter_dir_z_.execute(values_vec_.slice_yz(i));
+}
+
+inline void hpxfft::fft3D::shared::base::fft_1d_c2c_y_slice(const std::size_t i)
+{
+    fftw_c2c_adapter_dir_y_.execute(reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(i)));
+}
+
+inline void hpxfft::fft3D::shared::base::fft_1d_c2c_x_slice(const std::size_t i)
+{
+    fftw_c2c_adapter_dir_x_.execute(reinterpret_cast<fftw_complex *>(values_vec_.slice_yz(i)));
+}
+
+inline void hpxfft::fft3D::shared::base::fft_1d_c2c_x_inv_slice(const std::size_t i)
+{
+    fftw_c2c_inv_adapter_dir_x_.execute(reinterpret_cast<fftw_complex *>(values_vec_.slice_yz(i)));
+}
+
+inline void hpxfft::fft3D::shared::base::fft_1d_c2c_y_inv_slice(const std::size_t i)
 {
-    fftw_r2c_adapter_dir_z_.execute_r2c(
-        values_vec_.vector_z(i, j), reinterpret_cast<fftw_complex *>(values_vec_.vector_z(i, j)));
+    fftw_c2c_inv_adapter_dir_y_.execute(reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(i)));
 }
 
-inline void hpxfft::fft3D::shared::base::fft_1d_c2c_y_inplace(const std::size_t i, const std::size_t j)
+inline void hpxfft::fft3D::shared::base::fft_1d_c2r_slice(const std::size_t i)
 {
-    fftw_c2c_adapter_dir_y_.execute_c2c(
-        reinterpret_cast<fftw_complex *>(permuted_vec_.vector_z(i, j)),
-        reinterpret_cast<fftw_complex *>(permuted_vec_.vector_z(i, j)));
+    fftw_c2r_adapter_dir_z_.execute(values_vec_.slice_yz(i));
 }
 
-inline void hpxfft::fft3D::shared::base::fft_1d_c2c_x_inplace(const std::size_t i, const std::size_t j)
+inline void hpxfft::fft3D::shared::base::copy_complex(real *to, const real *from)
 {
-    fftw_c2c_adapter_dir_x_.execute_c2c(
-        reinterpret_cast<fftw_complex *>(values_vec_.vector_z(i, j)),
-        reinterpret_cast<fftw_complex *>(values_vec_.vector_z(i, j)));
+    // one 16 byte move, vectorized by the compiler
+    std::memcpy(to, from, 2 * sizeof(real));
 }
 
 inline void hpxfft::fft3D::shared::base::permute_shared_x_z_y(const std::size_t slice_x)
 {
-    const std::size_t n_x = values_vec_.n_x();
     const std::size_t n_y = values_vec_.n_y();
-    const std::size_t n_z = values_vec_.n_z();
-    const std::size_t n_z_c = n_z / 2;
-    
-    for (std::size_t index_y = 0; index_y < n_y; ++index_y)
+    const std::size_t n_z_c = values_vec_.n_z() / 2;
+
+    // tiles across the swapped y- and z-axis
+    for (std::size_t tile_y = 0; tile_y < n_y; tile_y += dim_tile_)
     {
-        for (std::size_t index_z = 0; index_z < n_z_c; ++index_z)
+        const std::size_t end_y = std::min(tile_y + dim_tile_, n_y);
+        for (std::size_t tile_z = 0; tile_z < n_z_c; tile_z += dim_tile_)
         {
-            permuted_vec_(slice_x, index_z, 2 * index_y) = values_vec_(slice_x, index_y, 2 * index_z);
-            permuted_vec_(slice_x, index_z, 2 * index_y + 1) = values_vec_(slice_x, index_y, 2 * index_z + 1);
+            const std::size_t end_z = std::min(tile_z + dim_tile_, n_z_c);
+            for (std::size_t index_y = tile_y; index_y < end_y; ++index_y)
+            {
+                for (std::size_t index_z = tile_z; index_z < end_z; ++index_z)
+                {
+                    copy_complex(&permuted_vec_(slice_x, index_z, 2 * index_y),
+                                 &values_vec_(slice_x, index_y, 2 * index_z));
+                }
+            }
         }
     }
 }
@@ -92,33 +266,123 @@ inline void hpxfft::fft3D::shared::base::permute_shared_x_z_y(const std::size_t
 inline void hpxfft::fft3D::shared::base::permute_shared_z_y_x(const std::size_t slice_y)
 {
     const std::size_t n_x = permuted_vec_.n_x();
+    const std::size_t n_z_c = permuted_vec_.n_z() / 2;
+
+    // tiles across the swapped x- and y-axis
+    for (std::size_t tile_x = 0; tile_x < n_x; tile_x += dim_tile_)
+    {
+        const std::size_t end_x = std::min(tile_x + dim_tile_, n_x);
+        for (std::size_t tile_z = 0; tile_z < n_z_c; tile_z += dim_tile_)
+        {
+            const std::size_t end_z = std::min(tile_z + dim_tile_, n_z_c);
+            for (std::size_t index_x = tile_x; index_x < end_x; ++index_x)
+            {
+                for (std::size_t index_z = tile_z; index_z < end_z; ++index_z)
+                {
+                    copy_complex(&values_vec_(index_z, slice_y, 2 * index_x),
+                                 &permuted_vec_(index_x, slice_y, 2 * index_z));
+                }
+            }
+        }
+    }
+}
+
+inline void hpxfft::fft3D::shared::base::permute_shared_z_x_y(const std::size_t slice_y)
+{
+    // values_vec_ (Y, Z, X) -> permuted_vec_ (X, Y, Z)
+    const std::size_t n_z = values_vec_.n_y();
+    const std::size_t n_x_c = values_vec_.n_z() / 2;
+
+    // tiles across the swapped z- and x-axis
+    for (std::size_t tile_z = 0; tile_z < n_z; tile_z += dim_tile_)
+    {
+        const std::size_t end_z = std::min(tile_z + dim_tile_, n_z);
+        for (std::size_t tile_x = 0; tile_x < n_x_c; tile_x += dim_tile_)
+        {
+            const std::size_t end_x = std::min(tile_x + dim_tile_, n_x_c);
+            for (std::size_t index_z = tile_z; index_z < end_z; ++index_z)
+            {
+                for (std::size_t index_x = tile_x; index_x < end_x; ++index_x)
+                {
+                    copy_complex(&permuted_vec_(index_x, slice_y, 2 * index_z),
+                                 &values_vec_(slice_y, index_z, 2 * index_x));
+                }
+            }
+        }
+    }
+}
+
+inline void hpxfft::fft3D::shared::base::permute_inverse_y_z_x(const std::size_t slice_x)
+{
+    // permuted_vec_ (X, Y, Z) -> values_vec_ (Y, Z, X)
     const std::size_t n_y = permuted_vec_.n_y();
-    const std::size_t n_z = permuted_vec_.n_z();
-    const std::size_t n_z_c = n_z / 2;
+    const std::size_t n_z_c = permuted_vec_.n_z() / 2;
 
-    for (std::size_t index_x = 0; index_x < n_x; ++index_x)
+    // tiles across the y- and z-axis
+    for (std::size_t tile_y = 0; tile_y < n_y; tile_y += dim_tile_)
     {
-        for (std::size_t index_z = 0; index_z < n_z_c; ++index_z)
+        const std::size_t end_y = std::min(tile_y + dim_tile_, n_y);
+        for (std::size_t tile_z = 0; tile_z < n_z_c; tile_z += dim_tile_)
         {
-            values_vec_(index_z, slice_y, 2 * index_x) = permuted_vec_(index_x, slice_y, 2 * index_z);
-            values_vec_(index_z, slice_y, 2 * index_x + 1) = permuted_vec_(index_x, slice_y, 2 * index_z + 1);
+            const std::size_t end_z = std::min(tile_z + dim_tile_, n_z_c);
+            for (std::size_t index_y = tile_y; index_y < end_y; ++index_y)
+            {
+                for (std::size_t index_z = tile_z; index_z < end_z; ++index_z)
+                {
+                    copy_complex(&values_vec_(index_y, index_z, 2 * slice_x),
+                                 &permuted_vec_(slice_x, index_y, 2 * index_z));
+                }
+            }
         }
     }
 }
 
-inline void hpxfft::fft3D::shared::base::permute_shared_z_x_y(const std::size_t slice_x)
+inline void hpxfft::fft3D::shared::base::permute_inverse_x_z_y(const std::size_t slice_z)
 {
-    const std::size_t n_x = values_vec_.n_x();
-    const std::size_t n_y = values_vec_.n_y();
-    const std::size_t n_z = values_vec_.n_z();
-    const std::size_t n_z_c = n_z / 2;
+    // values_vec_ (Y, Z, X) -> permuted_vec_ (X, Z, Y)
+    const std::size_t n_y = values_vec_.n_x();
+    const std::size_t n_x_c = values_vec_.n_z() / 2;
+
+    // tiles across the swapped y- and x-axis
+    for (std::size_t tile_y = 0; tile_y < n_y; tile_y += dim_tile_)
+    {
+        const std::size_t end_y = std::min(tile_y + dim_tile_, n_y);
+        for (std::size_t tile_x = 0; tile_x < n_x_c; tile_x += dim_tile_)
+        {
+            const std::size_t end_x = std::min(tile_x + dim_tile_, n_x_c);
+            for (std::size_t index_y = tile_y; index_y < end_y; ++index_y)
+            {
+                for (std::size_t index_x = tile_x; index_x < end_x; ++index_x)
+                {
+                    copy_complex(&permuted_vec_(index_x, slice_z, 2 * index_y),
+                                 &values_vec_(index_y, slice_z, 2 * index_x));
+                }
+            }
+        }
+    }
+}
+
+inline void hpxfft::fft3D::shared::base::permute_inverse_x_y_z(const std::size_t slice_x)
+{
+    // permuted_vec_ (X, Z, Y) -> values_vec_ (X, Y, Z)
+    const std::size_t n_z = permuted_vec_.n_y();
+    const std::size_t n_y_c = permuted_vec_.n_z() / 2;
 
-    for (std::size_t index_y = 0; index_y < n_y; ++index_y)
+    // tiles across the swapped z- and y-axis
+    for (std::size_t tile_z = 0; tile_z < n_z; tile_z += dim_tile_)
     {
-        for (std::size_t index_z = 0; index_z < n_z_c; ++index_z)
+        const std::size_t end_z = std::min(tile_z + dim_tile_, n_z);
+        for (std::size_t tile_y = 0; tile_y < n_y_c; tile_y += dim_tile_)
         {
-            permuted_vec_(index_z, slice_x, 2 * index_y) = values_vec_(slice_x, index_y, 2 * index_z);
-            permuted_vec_(index_z, slice_x, 2 * index_y + 1) = values_vec_(slice_x, index_y, 2 * index_z + 1);
+            const std::size_t end_y = std::min(tile_y + dim_tile_, n_y_c);
+            for (std::size_t index_z = tile_z; index_z < end_z; ++index_z)
+            {
+                for (std::size_t index_y = tile_y; index_y < end_y; ++index_y)
+                {
+                    copy_complex(&values_vec_(slice_x, index_y, 2 * index_z),
+                                 &permuted_vec_(slice_x, index_z, 2 * index_y));
+                }
+            }
         }
     }
 }
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef hpxfft_shared_strided_3D_H_INCLUDED
+#define hpxfft_shared_strided_3D_H_INCLUDED
+
+#include "shared_base.hpp"
+#include "../../util/vector_3d.hpp"                 // for hpxfft::util::vector_3d
+#include <hpx/timing/high_resolution_timer.hpp>     // for hpx::chrono::high_resolution_timer
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/future.hpp>
+
+typedef double real;
+
+namespace hpxfft::fft3D::shared
+{
+using vector_3d = hpxfft::util::vector_3d<real>;
+
+///////////////////////////////////////////////////////////////////////////////
+// 3D r2c FFT without permutes: the y- and x-transforms run in place on the
+// x-y-z data with strided batched plans. Tasks work on sub-volumes, an
+// x-slice for the z- and y-transforms and a y-slice (all x, one y, all z)
+// for the x-transforms. The result stays in the x-y-z input layout.
+struct strided : public base
+{
+  public:
+    strided() = default;
+
+    void initialize(vector_3d values_vec, const std::string PLAN_FLAG);
+
+    // replace the input of the same shape, plans are kept
+    void set_values(vector_3d values_vec);
+
+    vector_3d fft_3d_r2c_par();
+
+    // non-blocking fft_3d_r2c_par(), the future becomes ready with the transformed data
+    hpx::future<vector_3d> fft_3d_r2c_async();
+
+    vector_3d fft_3d_r2c_seq();
+
+    // inverse of fft_3d_r2c_par() (unnormalized), in place on the returned spectrum
+    vector_3d fft_3d_c2r_par(vector_3d values_vec);
+
+    // non-blocking fft_3d_c2r_par()
+    hpx::future<vector_3d> fft_3d_c2r_async(vector_3d values_vec);
+
+    vector_3d fft_3d_c2r_seq(vector_3d values_vec);
+
+    void write_plans_to_file(std::string file_path);
+
+  private:
+    // batched plans over the whole values_vec_ with the strides of the x-y-z layout
+    void plan_strided();
+
+    // strided FFTs of one sub-volume
+    void fft_1d_c2c_y_strided(const std::size_t i);
+    void fft_1d_c2c_x_strided(const std::size_t j);
+    void fft_1d_c2c_y_inv_strided(const std::size_t i);
+    void fft_1d_c2c_x_inv_strided(const std::size_t j);
+
+  private:
+    // phase time stamps of the parallel transform
+    real start_total_, start_second_fft_, start_third_fft_;
+    real start_inverse_total_;
+};
+} // namespace hpxfft::fft3D::shared
+#endif  // hpxfft_shared_strided_3D_H_INCLUDED
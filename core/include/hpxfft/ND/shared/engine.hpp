@@ -0,0 +1,584 @@
+#pragma once
+#ifndef hpxfft_shared_engine_ND_H_INCLUDED
+#define hpxfft_shared_engine_ND_H_INCLUDED
+
+#include "policy.hpp"
+#include "../../util/fft_backend.hpp"
+#include "../../util/vector_nd.hpp"                 // for hpxfft::util::vector_nd
+#include <hpx/timing/high_resolution_timer.hpp>     // for hpx::chrono::high_resolution_timer
+#include <hpx/future.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+typedef double real;
+
+namespace hpxfft::fftND::shared
+{
+template <std::size_t Rank>
+using vector_nd = hpxfft::util::vector_nd<real, Rank>;
+
+///////////////////////////////////////////////////////////////////////////////
+// Rank-generic N-D r2c FFT. The real input is padded in the last dimension
+// like vector_3d: (n_0, ..., n_{N-2}, 2 * (n_{N-1} / 2 + 1)).
+// The last axis is transformed first, then every other axis is swapped to the
+// back with a tiled permute, transformed with one batched plan per slice and
+// left there. The last permute rotates the layout (1, ..., N-1, 0) back to the
+// input layout. For Rank 3 these are the passes of the 3D shared engines.
+// Policy (policy::loop, policy::sync, policy::dataflow) schedules the passes.
+template <std::size_t Rank, typename Policy = policy::loop>
+struct engine
+{
+    static_assert(Rank >= 2, "engine needs at least two dimensions");
+
+    using vector_nd = hpxfft::fftND::shared::vector_nd<Rank>;
+    using extents_type = typename vector_nd::extents_type;
+
+  public:
+    engine() = default;
+
+    // TILE_DIM: permute tile size in complex entries
+    void initialize(vector_nd values_vec, const std::string PLAN_FLAG, const std::size_t TILE_DIM = 32);
+
+    // replace the input of the same shape, plans are kept and the buffers of the
+    // previous transform are reused: pass the last result back to avoid allocations
+    void set_values(vector_nd values_vec);
+
+    vector_nd fft_nd_r2c();
+
+    // non-blocking, the future becomes ready with the transformed data
+    hpx::future<vector_nd> fft_nd_r2c_async();
+
+    // inverse of fft_nd_r2c() (unnormalized): takes the returned spectrum,
+    // the real result is padded like the forward input
+    vector_nd fft_nd_c2r(vector_nd values_vec);
+
+    // non-blocking fft_nd_c2r()
+    hpx::future<vector_nd> fft_nd_c2r_async(vector_nd values_vec);
+
+    real get_measurement(std::string name);
+
+    void write_plans_to_file(std::string file_path);
+
+  private:
+    // passes on buffer 0 (values_vec_) or 1 (work_vec_) with layout extents in complex entries
+    pass fft_r2c_pass(const extents_type &extents);
+    pass fft_c2r_pass(const extents_type &extents, const std::size_t buffer);
+    pass fft_c2c_pass(hpxfft::util::fft_backend::c2c_1d_many &adapter,
+                      const extents_type &extents,
+                      const std::size_t buffer);
+    // swap axis position p with the last one: per first-axis slice for p > 0, global for p = 0
+    pass permute_swap_pass(const extents_type &extents,
+                           const std::size_t p,
+                           const std::size_t from,
+                           const std::size_t to);
+    // layout (1, ..., N-1, 0) to (0, ..., N-1) and back
+    pass permute_rotate_pass(const extents_type &extents, const std::size_t from, const std::size_t to);
+    pass permute_rotate_inverse_pass(const extents_type &extents, const std::size_t from, const std::size_t to);
+
+    // r2c and c2r plans of the last axis
+    void plan_last_axis();
+
+    // plan axis with the last axis of the layout, forward and backward
+    void plan_axis(const std::size_t axis, const extents_type &extents);
+
+    // true if every plan accepts the slices of the buffer data
+    bool plans_accept(real *data) const;
+
+    // after a swap-in: re-plan all axes with FFTW_UNALIGNED if a caller buffer
+    // breaks the alignment the plans were created for
+    void keep_plans_valid();
+
+    // true if the slices of both buffers have the alignment of the planning buffer
+    bool slices_keep_alignment(const std::size_t n_slices);
+
+    // copy an nb x nd block of complex entries tile by tile, strides in complex entries
+    void copy_tiles(real *to,
+                    const real *from,
+                    const std::size_t nb,
+                    const std::size_t nd,
+                    const std::size_t from_stride_b,
+                    const std::size_t from_stride_d,
+                    const std::size_t to_stride_b,
+                    const std::size_t to_stride_d) const;
+
+    static void copy_complex(real *to, const real *from);
+
+    static extents_type swap_axes(extents_type extents, const std::size_t p);
+
+    real *buffer(const std::size_t b);
+
+  private:
+    // parameters
+    extents_type dim_c_;
+    std::size_t dim_r_last_, size_c_;
+    // permute tile size in complex entries
+    std::size_t dim_tile_ = 32;
+    // FFT plans: one batched transform per slice, c2c plans of axis 0 to N-2
+    std::string PLAN_FLAG_;
+    // IMPORTANT: declare r2c adapter before c2c so r2c destructor is called after c2c
+    hpxfft::util::fft_backend::r2c_1d_many fft_r2c_adapter_;
+    std::array<hpxfft::util::fft_backend::c2c_1d_many, Rank - 1> fft_c2c_adapter_;
+    hpxfft::util::fft_backend::c2r_1d_many fft_c2r_adapter_;
+    std::array<hpxfft::util::fft_backend::c2c_1d_many, Rank - 1> fft_c2c_inv_adapter_;
+    std::array<std::size_t, Rank> n_slices_;
+    // layout in which each c2c axis is planned
+    std::array<extents_type, Rank - 1> axis_extents_;
+    // set once caller buffers broke the planned alignment, later plans accept any
+    bool plan_unaligned_ = false;
+    // schedules
+    std::vector<stage> forward_stages_;
+    std::vector<stage> inverse_stages_;
+    // value vectors, Rank permutes: the result ends up in buffer Rank % 2
+    vector_nd values_vec_;
+    vector_nd work_vec_;
+    // time measurement
+    hpx::chrono::high_resolution_timer t_ = hpx::chrono::high_resolution_timer();
+    std::map<std::string, real> measurements_;
+};
+}  // namespace hpxfft::fftND::shared
+
+template <std::size_t Rank, typename Policy>
+inline void hpxfft::fftND::shared::engine<Rank, Policy>::initialize(vector_nd values_vec,
+                                                                     const std::string PLAN_FLAG,
+                                                                     const std::size_t TILE_DIM)
+{
+    values_vec_ = std::move(values_vec);
+    dim_c_ = values_vec_.extents();
+    dim_c_[Rank - 1] = dim_c_[Rank - 1] / 2;
+    dim_r_last_ = 2 * dim_c_[Rank - 1] - 2;
+    size_c_ = values_vec_.size() / 2;
+    // second buffer, permute target
+    work_vec_ = vector_nd(values_vec_.extents());
+    PLAN_FLAG_ = PLAN_FLAG;
+    dim_tile_ = std::max(TILE_DIM, std::size_t(1));
+    auto start_plan = t_.now();
+
+    /////////////////////////////////////////////////////////////////
+    // forward: the first axis stays in front while the axes N-2 to 1
+    // visit the back, every x_0-slice flows independently
+    extents_type extents = dim_c_;
+    std::size_t current = 0;
+    plan_last_axis();
+    forward_stages_.clear();
+    forward_stages_.push_back(stage{fft_r2c_pass(extents)});
+    for (std::size_t p = Rank - 2; p > 0; --p)
+    {
+        forward_stages_.back().push_back(permute_swap_pass(extents, p, current, 1 - current));
+        extents = swap_axes(extents, p);
+        current = 1 - current;
+        plan_axis(p, extents);
+        forward_stages_.back().push_back(fft_c2c_pass(fft_c2c_adapter_[p], extents, current));
+    }
+    // global permute: every slice of the target gathers data from all x_0-slices
+    forward_stages_.push_back(stage{permute_swap_pass(extents, 0, current, 1 - current)});
+    extents = swap_axes(extents, 0);
+    current = 1 - current;
+    // first axis, then back to the input layout per x_1-slice
+    plan_axis(0, extents);
+    forward_stages_.push_back(stage{fft_c2c_pass(fft_c2c_adapter_[0], extents, current),
+                                    permute_rotate_pass(extents, current, 1 - current)});
+
+    /////////////////////////////////////////////////////////////////
+    // inverse: the forward passes backwards, swaps are their own inverse
+    current = 0;
+    inverse_stages_.clear();
+    inverse_stages_.push_back(stage{permute_rotate_inverse_pass(extents, current, 1 - current),
+                                    fft_c2c_pass(fft_c2c_inv_adapter_[0], extents, 1 - current)});
+    current = 1 - current;
+    inverse_stages_.push_back(stage{permute_swap_pass(extents, 0, current, 1 - current)});
+    extents = swap_axes(extents, 0);
+    current = 1 - current;
+    inverse_stages_.push_back(stage{});
+    for (std::size_t p = 1; p < Rank - 1; ++p)
+    {
+        inverse_stages_.back().push_back(fft_c2c_pass(fft_c2c_inv_adapter_[p], extents, current));
+        inverse_stages_.back().push_back(permute_swap_pass(extents, p, current, 1 - current));
+        extents = swap_axes(extents, p);
+        current = 1 - current;
+    }
+    inverse_stages_.back().push_back(fft_c2r_pass(extents, current));
+
+    auto stop_plan = t_.now();
+    measurements_["plan"] = stop_plan - start_plan;
+    // compute overall plan flops
+    double add, mul, fma;
+    fft_r2c_adapter_.flops(&add, &mul, &fma);
+    real plan_flops = dim_c_[0] * (add + mul + fma);
+    for (std::size_t axis = 0; axis < Rank - 1; ++axis)
+    {
+        fft_c2c_adapter_[axis].flops(&add, &mul, &fma);
+        plan_flops += n_slices_[axis] * (add + mul + fma);
+    }
+    measurements_["plan_flops"] = plan_flops;
+}
+
+template <std::size_t Rank, typename Policy>
+inline void hpxfft::fftND::shared::engine<Rank, Policy>::set_values(vector_nd values_vec)
+{
+    extents_type extents = dim_c_;
+    extents[Rank - 1] = 2 * dim_c_[Rank - 1];
+    if (values_vec.extents() != extents)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    vector_nd previous = std::move(values_vec_);
+    values_vec_ = std::move(values_vec);
+    // the result was moved out of work_vec_, the previous buffer takes its place
+    if (work_vec_.size() == 0)
+    {
+        work_vec_ = std::move(previous);
+    }
+    keep_plans_valid();
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::vector_nd<Rank> hpxfft::fftND::shared::engine<Rank, Policy>::fft_nd_r2c()
+{
+    return fft_nd_r2c_async().get();
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpx::future<hpxfft::fftND::shared::vector_nd<Rank>>
+hpxfft::fftND::shared::engine<Rank, Policy>::fft_nd_r2c_async()
+{
+    auto start_total = t_.now();
+    return Policy::run(forward_stages_)
+        .then(
+            [this, start_total](hpx::future<void> r)
+            {
+                r.get();
+                measurements_["total"] = t_.now() - start_total;
+                return Rank % 2 == 0 ? std::move(values_vec_) : std::move(work_vec_);
+            });
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::vector_nd<Rank>
+hpxfft::fftND::shared::engine<Rank, Policy>::fft_nd_c2r(vector_nd values_vec)
+{
+    return fft_nd_c2r_async(std::move(values_vec)).get();
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpx::future<hpxfft::fftND::shared::vector_nd<Rank>>
+hpxfft::fftND::shared::engine<Rank, Policy>::fft_nd_c2r_async(vector_nd values_vec)
+{
+    auto start_total = t_.now();
+    set_values(std::move(values_vec));
+    return Policy::run(inverse_stages_)
+        .then(
+            [this, start_total](hpx::future<void> r)
+            {
+                r.get();
+                measurements_["inverse_total"] = t_.now() - start_total;
+                return Rank % 2 == 0 ? std::move(values_vec_) : std::move(work_vec_);
+            });
+}
+
+template <std::size_t Rank, typename Policy>
+inline real hpxfft::fftND::shared::engine<Rank, Policy>::get_measurement(std::string name)
+{
+    return measurements_[name];
+}
+
+template <std::size_t Rank, typename Policy>
+inline void hpxfft::fftND::shared::engine<Rank, Policy>::write_plans_to_file(std::string file_path)
+{
+    // Open file
+    FILE *file_name = fopen(file_path.c_str(), "a");
+    if (!file_name)
+    {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+    // Write forward plans
+    fprintf(file_name, "FFTW r2c 1D plan axis %zu:\n", Rank - 1);
+    fft_r2c_adapter_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    for (std::size_t axis = Rank - 1; axis-- > 0;)
+    {
+        fprintf(file_name, "FFTW c2c 1D plan axis %zu:\n", axis);
+        fft_c2c_adapter_[axis].print_plan(file_name);
+        fprintf(file_name, "\n");
+    }
+    // Write inverse plans
+    for (std::size_t axis = 0; axis < Rank - 1; ++axis)
+    {
+        fprintf(file_name, "FFTW backward c2c 1D plan axis %zu:\n", axis);
+        fft_c2c_inv_adapter_[axis].print_plan(file_name);
+        fprintf(file_name, "\n");
+    }
+    fprintf(file_name, "FFTW c2r 1D plan axis %zu:\n", Rank - 1);
+    fft_c2r_adapter_.print_plan(file_name);
+    fprintf(file_name, "\n\n");
+    // Close file
+    fclose(file_name);
+}
+
+template <std::size_t Rank, typename Policy>
+inline bool hpxfft::fftND::shared::engine<Rank, Policy>::slices_keep_alignment(const std::size_t n_slices)
+{
+    const std::size_t slice = 2 * size_c_ / n_slices;
+    return hpxfft::util::fftw_adapter::keeps_alignment(work_vec_.data(), values_vec_.data(), slice)
+        && hpxfft::util::fftw_adapter::keeps_alignment(work_vec_.data(), work_vec_.data(), slice);
+}
+
+template <std::size_t Rank, typename Policy>
+inline void hpxfft::fftND::shared::engine<Rank, Policy>::plan_last_axis()
+{
+    // r2c and c2r in the last axis, planned on the permute target so that
+    // measuring planners do not overwrite the input
+    const std::size_t howmany = size_c_ / (dim_c_[0] * dim_c_[Rank - 1]);
+    const bool aligned = !plan_unaligned_ && slices_keep_alignment(dim_c_[0]);
+    fft_r2c_adapter_.plan(dim_r_last_, howmany, PLAN_FLAG_, work_vec_.data(), aligned);
+    fft_c2r_adapter_.plan(dim_r_last_, howmany, PLAN_FLAG_, work_vec_.data(), aligned);
+}
+
+template <std::size_t Rank, typename Policy>
+inline void
+hpxfft::fftND::shared::engine<Rank, Policy>::plan_axis(const std::size_t axis, const extents_type &extents)
+{
+    // rows of the last axis per slice of the first axis
+    const std::size_t n = extents[Rank - 1];
+    const std::size_t howmany = size_c_ / (extents[0] * n);
+    n_slices_[axis] = extents[0];
+    axis_extents_[axis] = extents;
+    const bool aligned = !plan_unaligned_ && slices_keep_alignment(extents[0]);
+    fft_c2c_adapter_[axis].plan(n,
+                                howmany,
+                                1,
+                                n,
+                                PLAN_FLAG_,
+                                reinterpret_cast<fftw_complex *>(work_vec_.data()),
+                                hpxfft::util::fftw_adapter::direction::forward,
+                                aligned);
+    fft_c2c_inv_adapter_[axis].plan(n,
+                                    howmany,
+                                    1,
+                                    n,
+                                    PLAN_FLAG_,
+                                    reinterpret_cast<fftw_complex *>(work_vec_.data()),
+                                    hpxfft::util::fftw_adapter::direction::backward,
+                                    aligned);
+}
+
+template <std::size_t Rank, typename Policy>
+inline bool hpxfft::fftND::shared::engine<Rank, Policy>::plans_accept(real *data) const
+{
+    const std::size_t slice = 2 * size_c_ / dim_c_[0];
+    bool accepted = fft_r2c_adapter_.accepts(data, slice) && fft_c2r_adapter_.accepts(data, slice);
+    for (std::size_t axis = 0; axis < Rank - 1; ++axis)
+    {
+        const std::size_t axis_slice = 2 * size_c_ / n_slices_[axis];
+        accepted = accepted && fft_c2c_adapter_[axis].accepts(data, axis_slice)
+                && fft_c2c_inv_adapter_[axis].accepts(data, axis_slice);
+    }
+    return accepted;
+}
+
+template <std::size_t Rank, typename Policy>
+inline void hpxfft::fftND::shared::engine<Rank, Policy>::keep_plans_valid()
+{
+    if (plans_accept(values_vec_.data()) && plans_accept(work_vec_.data()))
+    {
+        return;
+    }
+    // once is enough: the new plans accept buffers of any alignment,
+    // work_vec_ is free until the transform runs
+    plan_unaligned_ = true;
+    plan_last_axis();
+    for (std::size_t axis = 0; axis < Rank - 1; ++axis)
+    {
+        plan_axis(axis, axis_extents_[axis]);
+    }
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::pass
+hpxfft::fftND::shared::engine<Rank, Policy>::fft_r2c_pass(const extents_type &extents)
+{
+    const std::size_t slice = 2 * size_c_ / extents[0];
+    return pass{extents[0], [this, slice](const std::size_t i) { fft_r2c_adapter_.execute(buffer(0) + i * slice); }};
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::pass
+hpxfft::fftND::shared::engine<Rank, Policy>::fft_c2r_pass(const extents_type &extents, const std::size_t b)
+{
+    const std::size_t slice = 2 * size_c_ / extents[0];
+    return pass{extents[0],
+                [this, slice, b](const std::size_t i) { fft_c2r_adapter_.execute(buffer(b) + i * slice); }};
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::pass
+hpxfft::fftND::shared::engine<Rank, Policy>::fft_c2c_pass(hpxfft::util::fft_backend::c2c_1d_many &adapter,
+                                                          const extents_type &extents,
+                                                          const std::size_t b)
+{
+    const std::size_t slice = 2 * size_c_ / extents[0];
+    return pass{extents[0],
+                [this, &adapter, slice, b](const std::size_t i)
+                { adapter.execute(reinterpret_cast<fftw_complex *>(buffer(b) + i * slice)); }};
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::pass
+hpxfft::fftND::shared::engine<Rank, Policy>::permute_swap_pass(const extents_type &extents,
+                                                               const std::size_t p,
+                                                               const std::size_t from,
+                                                               const std::size_t to)
+{
+    // (A, B, C, D) -> (A, D, C, B) with B the extent at position p and D the last one
+    std::size_t n_a = 1, n_c = 1;
+    for (std::size_t q = 0; q < p; ++q)
+    {
+        n_a *= extents[q];
+    }
+    for (std::size_t q = p + 1; q < Rank - 1; ++q)
+    {
+        n_c *= extents[q];
+    }
+    const std::size_t n_b = extents[p];
+    const std::size_t n_d = extents[Rank - 1];
+    if (p > 0)
+    {
+        // the first axis is not touched: one task per slice of it
+        const std::size_t n_a_slice = n_a / extents[0];
+        return pass{extents[0],
+                    [=, this](const std::size_t i)
+                    {
+                        const real *src = buffer(from);
+                        real *dst = buffer(to);
+                        for (std::size_t a = i * n_a_slice; a < (i + 1) * n_a_slice; ++a)
+                        {
+                            for (std::size_t c = 0; c < n_c; ++c)
+                            {
+                                copy_tiles(dst + 2 * (a * n_d * n_c * n_b + c * n_b),
+                                           src + 2 * (a * n_b * n_c * n_d + c * n_d),
+                                           n_b,
+                                           n_d,
+                                           n_c * n_d,
+                                           1,
+                                           1,
+                                           n_c * n_b);
+                            }
+                        }
+                    }};
+    }
+    // n_a = 1: one task per middle index and tile of the last axis
+    const std::size_t n_d_tiles = (n_d + dim_tile_ - 1) / dim_tile_;
+    return pass{n_c * n_d_tiles,
+                [=, this](const std::size_t t)
+                {
+                    const std::size_t c = t / n_d_tiles;
+                    const std::size_t d = (t % n_d_tiles) * dim_tile_;
+                    copy_tiles(buffer(to) + 2 * (d * n_c * n_b + c * n_b),
+                               buffer(from) + 2 * (c * n_d + d),
+                               n_b,
+                               std::min(dim_tile_, n_d - d),
+                               n_c * n_d,
+                               1,
+                               1,
+                               n_c * n_b);
+                }};
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::pass hpxfft::fftND::shared::engine<Rank, Policy>::permute_rotate_pass(
+    const extents_type &extents, const std::size_t from, const std::size_t to)
+{
+    // (S, M, D) -> (D, S, M): one task per slice of the first axis
+    const std::size_t n_s = extents[0];
+    const std::size_t n_d = extents[Rank - 1];
+    const std::size_t n_m = size_c_ / (n_s * n_d);
+    return pass{n_s,
+                [=, this](const std::size_t s)
+                {
+                    copy_tiles(buffer(to) + 2 * s * n_m,
+                               buffer(from) + 2 * s * n_m * n_d,
+                               n_m,
+                               n_d,
+                               n_d,
+                               1,
+                               1,
+                               n_s * n_m);
+                }};
+}
+
+template <std::size_t Rank, typename Policy>
+inline hpxfft::fftND::shared::pass hpxfft::fftND::shared::engine<Rank, Policy>::permute_rotate_inverse_pass(
+    const extents_type &extents, const std::size_t from, const std::size_t to)
+{
+    // (D, S, M) -> (S, M, D), extents of the target layout: one task per target slice
+    const std::size_t n_s = extents[0];
+    const std::size_t n_d = extents[Rank - 1];
+    const std::size_t n_m = size_c_ / (n_s * n_d);
+    return pass{n_s,
+                [=, this](const std::size_t s)
+                {
+                    copy_tiles(buffer(to) + 2 * s * n_m * n_d,
+                               buffer(from) + 2 * s * n_m,
+                               n_m,
+                               n_d,
+                               1,
+                               n_s * n_m,
+                               n_d,
+                               1);
+                }};
+}
+
+template <std::size_t Rank, typename Policy>
+inline void hpxfft::fftND::shared::engine<Rank, Policy>::copy_tiles(real *to,
+                                                                     const real *from,
+                                                                     const std::size_t nb,
+                                                                     const std::size_t nd,
+                                                                     const std::size_t from_stride_b,
+                                                                     const std::size_t from_stride_d,
+                                                                     const std::size_t to_stride_b,
+                                                                     const std::size_t to_stride_d) const
+{
+    // tiles across the swapped axes
+    for (std::size_t tile_b = 0; tile_b < nb; tile_b += dim_tile_)
+    {
+        const std::size_t end_b = std::min(tile_b + dim_tile_, nb);
+        for (std::size_t tile_d = 0; tile_d < nd; tile_d += dim_tile_)
+        {
+            const std::size_t end_d = std::min(tile_d + dim_tile_, nd);
+            for (std::size_t index_b = tile_b; index_b < end_b; ++index_b)
+            {
+                for (std::size_t index_d = tile_d; index_d < end_d; ++index_d)
+                {
+                    copy_complex(to + 2 * (index_b * to_stride_b + index_d * to_stride_d),
+                                 from + 2 * (index_b * from_stride_b + index_d * from_stride_d));
+                }
+            }
+        }
+    }
+}
+
+template <std::size_t Rank, typename Policy>
+inline void hpxfft::fftND::shared::engine<Rank, Policy>::copy_complex(real *to, const real *from)
+{
+    // one 16 byte move, vectorized by the compiler
+    std::memcpy(to, from, 2 * sizeof(real));
+}
+
+template <std::size_t Rank, typename Policy>
+inline typename hpxfft::fftND::shared::engine<Rank, Policy>::extents_type
+hpxfft::fftND::shared::engine<Rank, Policy>::swap_axes(extents_type extents, const std::size_t p)
+{
+    std::swap(extents[p], extents[Rank - 1]);
+    return extents;
+}
+
+template <std::size_t Rank, typename Policy>
+inline real *hpxfft::fftND::shared::engine<Rank, Policy>::buffer(const std::size_t b)
+{
+    return b == 0 ? values_vec_.data() : work_vec_.data();
+}
+#endif  // hpxfft_shared_engine_ND_H_INCLUDED
@@ -0,0 +1,120 @@
+#pragma once
+#ifndef hpxfft_shared_policy_ND_H_INCLUDED
+#define hpxfft_shared_policy_ND_H_INCLUDED
+
+#include <hpx/future.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <functional>
+#include <vector>
+
+namespace hpxfft::fftND::shared
+{
+///////////////////////////////////////////////////////////////////////////////
+// One pass of an N-D transform: n_tasks independent tasks, e.g. the batched
+// 1D FFTs of one slice or the permute of one slice.
+struct pass
+{
+    std::size_t n_tasks;
+    std::function<void(const std::size_t)> task;
+};
+
+// Passes of a stage have the same number of tasks and task i of a pass only
+// depends on task i of the previous pass. Stages depend on each other globally.
+using stage = std::vector<pass>;
+
+namespace policy
+{
+// every pass is one parallel for_loop, passes are separated by barriers
+struct loop
+{
+    static hpx::future<void> run(const std::vector<stage> &stages);
+};
+
+// every task is an hpx::async, passes are synchronized with when_all
+struct sync
+{
+    static hpx::future<void> run(const std::vector<stage> &stages);
+};
+
+// task i of a stage runs as one chain through all passes of the stage,
+// only stages are synchronized with when_all
+struct dataflow
+{
+    static hpx::future<void> run(const std::vector<stage> &stages);
+};
+}  // namespace policy
+}  // namespace hpxfft::fftND::shared
+
+inline hpx::future<void> hpxfft::fftND::shared::policy::loop::run(const std::vector<stage> &stages)
+{
+    const auto policy = hpx::execution::par(hpx::execution::task);
+    hpx::future<void> result = hpx::make_ready_future();
+    for (const stage &s : stages)
+    {
+        for (const pass &p : s)
+        {
+            result = result.then(
+                [&p, policy](hpx::future<void> r)
+                {
+                    r.get();
+                    return hpx::experimental::for_loop(policy, 0, p.n_tasks, [&p](auto i) { p.task(i); });
+                });
+        }
+    }
+    return result;
+}
+
+inline hpx::future<void> hpxfft::fftND::shared::policy::sync::run(const std::vector<stage> &stages)
+{
+    hpx::future<void> result = hpx::make_ready_future();
+    for (const stage &s : stages)
+    {
+        for (const pass &p : s)
+        {
+            result = result.then(
+                [&p](hpx::future<void> r)
+                {
+                    r.get();
+                    std::vector<hpx::future<void>> futures(p.n_tasks);
+                    for (std::size_t i = 0; i < p.n_tasks; ++i)
+                    {
+                        futures[i] = hpx::async(p.task, i);
+                    }
+                    return hpx::when_all(futures).then([](hpx::future<std::vector<hpx::future<void>>> r)
+                                                       { r.get(); });
+                });
+        }
+    }
+    return result;
+}
+
+inline hpx::future<void> hpxfft::fftND::shared::policy::dataflow::run(const std::vector<stage> &stages)
+{
+    hpx::future<void> result = hpx::make_ready_future();
+    for (const stage &s : stages)
+    {
+        result = result.then(
+            [&s](hpx::future<void> r)
+            {
+                r.get();
+                const std::size_t n_tasks = s.front().n_tasks;
+                std::vector<hpx::future<void>> chains(n_tasks);
+                for (std::size_t i = 0; i < n_tasks; ++i)
+                {
+                    chains[i] = hpx::async(s.front().task, i);
+                    for (std::size_t k = 1; k < s.size(); ++k)
+                    {
+                        chains[i] = chains[i].then(
+                            [&p = s[k], i](hpx::future<void> r)
+                            {
+                                r.get();
+                                p.task(i);
+                            });
+                    }
+                }
+                return hpx::when_all(chains).then([](hpx::future<std::vector<hpx::future<void>>> r) { r.get(); });
+            });
+    }
+    return result;
+}
+#endif  // hpxfft_shared_policy_ND_H_INCLUDED
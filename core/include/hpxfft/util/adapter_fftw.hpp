@@ -2,8 +2,10 @@
 #define fftw_adapter_H_INCLUDED
 
 #include <fftw3.h>
+#include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 // Enums for fftw integration
 namespace hpxfft::util::fftw_adapter
@@ -17,8 +19,28 @@ enum class plan_flag {
     exhaustive = FFTW_EXHAUSTIVE
 };
 
+// Process-level teardown of the global FFTW state: every live plan of every
+// engine becomes invalid. Engines never call it, the application may once at
+// shutdown after all engines are destroyed. init_threads() registers it with
+// std::atexit. Planning is serialized internally.
 void cleanup();
 
+// Multi-threaded FFTW plans: the parallel sections of a plan run as HPX tasks
+// via fftw_threads_set_callback. Returns false if hpxfft was built without
+// the FFTW threads library, plans are then always single-threaded.
+bool init_threads();
+
+// FFTW wisdom: plans created after an import reuse the stored measurements,
+// the export appends the wisdom of all plans created so far. Return false on failure.
+bool import_wisdom(const std::string &file_path);
+bool export_wisdom(const std::string &file_path);
+
+// New-array execution keeps the SIMD codelets of a plan only if the execute
+// pointers have the alignment of the planning pointer. True if every pointer
+// data + k * step (k >= 0) has the alignment of planned: pass aligned = false
+// to the plans otherwise, they are then created with FFTW_UNALIGNED.
+bool keeps_alignment(double *planned, double *data, std::size_t step);
+
 inline plan_flag string_to_fftw_plan_flag(const std::string &flag_str)
 {
     if (flag_str == "estimate")
@@ -46,7 +68,31 @@ inline plan_flag string_to_fftw_plan_flag(const std::string &flag_str)
 struct r2c_1d
 {
   public:
-    void plan(int dim_r, std::string plan_flag, double *in, fftw_complex *out);
+    // the adapters own their FFTW plan: no copies, a move assignment hands the
+    // plan over and the replaced plan is destroyed with the moved-from adapter
+    r2c_1d() = default;
+    r2c_1d(const r2c_1d &) = delete;
+    r2c_1d &operator=(const r2c_1d &) = delete;
+
+    r2c_1d(r2c_1d &&other) noexcept { *this = std::move(other); }
+
+    r2c_1d &operator=(r2c_1d &&other) noexcept
+    {
+        std::swap(plan_r2c_1d_, other.plan_r2c_1d_);
+        std::swap(alignment_, other.alignment_);
+        return *this;
+    }
+
+    // n_threads > 1 requires init_threads()
+    void plan(int dim_r,
+              std::string plan_flag,
+              double *in,
+              fftw_complex *out,
+              int n_threads = 1,
+              bool aligned = true);
+
+    // true if in-place execute(in + k * step) is valid for every k >= 0
+    bool accepts(double *in, std::size_t step) const;
 
     void execute(double *in, fftw_complex *out);
 
@@ -54,16 +100,43 @@ struct r2c_1d
 
     void print_plan(FILE *stream);
 
-    ~r2c_1d() { fftw_destroy_plan(plan_r2c_1d_); }
+    ~r2c_1d()
+    {
+        if (plan_r2c_1d_)
+        {
+            fftw_destroy_plan(plan_r2c_1d_);
+        }
+    }
 
   private:
-    fftw_plan plan_r2c_1d_;
+    fftw_plan plan_r2c_1d_ = nullptr;
+    // alignment of the planning pointer, -1 for FFTW_UNALIGNED plans
+    int alignment_ = -1;
 };
 
 struct c2c_1d
 {
   public:
-    void plan(int dim_c, std::string plan_flag, fftw_complex *in, fftw_complex *out, fftw_adapter::direction direction);
+    c2c_1d() = default;
+    c2c_1d(const c2c_1d &) = delete;
+    c2c_1d &operator=(const c2c_1d &) = delete;
+
+    c2c_1d(c2c_1d &&other) noexcept { *this = std::move(other); }
+
+    c2c_1d &operator=(c2c_1d &&other) noexcept
+    {
+        std::swap(plan_c2c_1d_, other.plan_c2c_1d_);
+        return *this;
+    }
+
+    // n_threads > 1 requires init_threads()
+    void plan(int dim_c,
+              std::string plan_flag,
+              fftw_complex *in,
+              fftw_complex *out,
+              fftw_adapter::direction direction,
+              int n_threads = 1,
+              bool aligned = true);
 
     void execute(fftw_complex *in, fftw_complex *out);
 
@@ -71,10 +144,185 @@ struct c2c_1d
 
     void print_plan(FILE *stream);
 
-    ~c2c_1d() { fftw_destroy_plan(plan_c2c_1d_); }
+    ~c2c_1d()
+    {
+        if (plan_c2c_1d_)
+        {
+            fftw_destroy_plan(plan_c2c_1d_);
+        }
+    }
+
+  private:
+    fftw_plan plan_c2c_1d_ = nullptr;
+};
+// batch of in-place 1D r2c transforms: howmany contiguous rows,
+// each padded to 2 * (dim_r / 2 + 1) reals
+struct r2c_1d_many
+{
+  public:
+    r2c_1d_many() = default;
+    r2c_1d_many(const r2c_1d_many &) = delete;
+    r2c_1d_many &operator=(const r2c_1d_many &) = delete;
+
+    r2c_1d_many(r2c_1d_many &&other) noexcept { *this = std::move(other); }
+
+    r2c_1d_many &operator=(r2c_1d_many &&other) noexcept
+    {
+        std::swap(plan_r2c_1d_many_, other.plan_r2c_1d_many_);
+        std::swap(alignment_, other.alignment_);
+        return *this;
+    }
+
+    void plan(int dim_r, int howmany, std::string plan_flag, double *values, bool aligned = true);
+
+    // true if execute(values + k * step) is valid for every k >= 0: the plan
+    // was created with FFTW_UNALIGNED or the pointers keep its alignment
+    bool accepts(double *values, std::size_t step) const;
+
+    void execute(double *values);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+    ~r2c_1d_many()
+    {
+        if (plan_r2c_1d_many_)
+        {
+            fftw_destroy_plan(plan_r2c_1d_many_);
+        }
+    }
+
+  private:
+    fftw_plan plan_r2c_1d_many_ = nullptr;
+    // alignment of the planning pointer, -1 for FFTW_UNALIGNED plans
+    int alignment_ = -1;
+};
+
+// batch of in-place 1D c2r transforms, inverse of r2c_1d_many (unnormalized):
+// howmany contiguous rows of dim_r / 2 + 1 complex inputs, the input is destroyed
+struct c2r_1d_many
+{
+  public:
+    c2r_1d_many() = default;
+    c2r_1d_many(const c2r_1d_many &) = delete;
+    c2r_1d_many &operator=(const c2r_1d_many &) = delete;
+
+    c2r_1d_many(c2r_1d_many &&other) noexcept { *this = std::move(other); }
+
+    c2r_1d_many &operator=(c2r_1d_many &&other) noexcept
+    {
+        std::swap(plan_c2r_1d_many_, other.plan_c2r_1d_many_);
+        std::swap(alignment_, other.alignment_);
+        return *this;
+    }
+
+    void plan(int dim_r, int howmany, std::string plan_flag, double *values, bool aligned = true);
+
+    // see r2c_1d_many::accepts
+    bool accepts(double *values, std::size_t step) const;
+
+    void execute(double *values);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+    ~c2r_1d_many()
+    {
+        if (plan_c2r_1d_many_)
+        {
+            fftw_destroy_plan(plan_c2r_1d_many_);
+        }
+    }
+
+  private:
+    fftw_plan plan_c2r_1d_many_ = nullptr;
+    // alignment of the planning pointer, -1 for FFTW_UNALIGNED plans
+    int alignment_ = -1;
+};
+
+// batch of in-place 1D c2c transforms of length dim_c: element k of
+// transform b is located at values[b * dist + k * stride]
+struct c2c_1d_many
+{
+  public:
+    c2c_1d_many() = default;
+    c2c_1d_many(const c2c_1d_many &) = delete;
+    c2c_1d_many &operator=(const c2c_1d_many &) = delete;
+
+    c2c_1d_many(c2c_1d_many &&other) noexcept { *this = std::move(other); }
+
+    c2c_1d_many &operator=(c2c_1d_many &&other) noexcept
+    {
+        std::swap(plan_c2c_1d_many_, other.plan_c2c_1d_many_);
+        std::swap(alignment_, other.alignment_);
+        return *this;
+    }
+
+    void plan(int dim_c,
+              int howmany,
+              int stride,
+              int dist,
+              std::string plan_flag,
+              fftw_complex *values,
+              fftw_adapter::direction direction,
+              bool aligned = true);
+
+    // see r2c_1d_many::accepts
+    bool accepts(double *values, std::size_t step) const;
+
+    void execute(fftw_complex *values);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+    ~c2c_1d_many()
+    {
+        if (plan_c2c_1d_many_)
+        {
+            fftw_destroy_plan(plan_c2c_1d_many_);
+        }
+    }
+
+  private:
+    fftw_plan plan_c2c_1d_many_ = nullptr;
+    // alignment of the planning pointer, -1 for FFTW_UNALIGNED plans
+    int alignment_ = -1;
+};
+
+// batch of in-place 2D r2c transforms: howmany contiguous n_row x n_col arrays,
+// the real input of each row is padded to n_col = 2 * (dim_r_y / 2 + 1)
+struct r2c_2d_many
+{
+  public:
+    r2c_2d_many() = default;
+    r2c_2d_many(const r2c_2d_many &) = delete;
+    r2c_2d_many &operator=(const r2c_2d_many &) = delete;
+
+    r2c_2d_many(r2c_2d_many &&other) noexcept { *this = std::move(other); }
+
+    r2c_2d_many &operator=(r2c_2d_many &&other) noexcept
+    {
+        std::swap(plan_r2c_2d_many_, other.plan_r2c_2d_many_);
+        return *this;
+    }
+
+    void plan(int n_row, int n_col, int howmany, std::string plan_flag, double *values, bool aligned = true);
+
+    void execute(double *values);
+
+    ~r2c_2d_many()
+    {
+        if (plan_r2c_2d_many_)
+        {
+            fftw_destroy_plan(plan_r2c_2d_many_);
+        }
+    }
 
   private:
-    fftw_plan plan_c2c_1d_;
+    fftw_plan plan_r2c_2d_many_ = nullptr;
 };
 }  // namespace hpxfft::util::fftw_adapter
 #endif  // fftw_adapter_H_INCLUDED
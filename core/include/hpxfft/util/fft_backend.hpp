@@ -0,0 +1,139 @@
+#ifndef fft_backend_H_INCLUDED
+#define fft_backend_H_INCLUDED
+
+#include "adapter_fftw.hpp"
+#include "native_fft.hpp"
+#include <string>
+
+// 1D FFT backends of the engines, selected by the plan flag:
+// "native" uses the in-tree kernels for power-of-two lengths,
+// every FFTW plan flag (estimate, measure, ...) uses FFTW.
+// aligned = false: execute pointers may differ in alignment from the planning
+// pointer, see fftw_adapter::keeps_alignment. The native kernels ignore it.
+namespace hpxfft::util::fft_backend
+{
+enum class backend { fftw, native };
+
+inline backend string_to_backend(const std::string &plan_flag)
+{
+    return plan_flag == "native" ? backend::native : backend::fftw;
+}
+
+struct r2c_1d
+{
+  public:
+    void plan(int dim_r,
+              std::string plan_flag,
+              double *in,
+              fftw_complex *out,
+              int n_threads = 1,
+              bool aligned = true);
+
+    bool accepts(double *in, std::size_t step) const;
+
+    void execute(double *in, fftw_complex *out);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+  private:
+    backend backend_ = backend::fftw;
+    fftw_adapter::r2c_1d fftw_;
+    native_fft::r2c_1d native_;
+};
+
+struct c2c_1d
+{
+  public:
+    void plan(int dim_c,
+              std::string plan_flag,
+              fftw_complex *in,
+              fftw_complex *out,
+              fftw_adapter::direction direction,
+              int n_threads = 1,
+              bool aligned = true);
+
+    void execute(fftw_complex *in, fftw_complex *out);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+  private:
+    backend backend_ = backend::fftw;
+    fftw_adapter::c2c_1d fftw_;
+    native_fft::c2c_1d native_;
+};
+
+// batched in-place backends, same layout as fftw_adapter::r2c_1d_many / c2c_1d_many,
+// the native backend loops over the batch
+struct r2c_1d_many
+{
+  public:
+    void plan(int dim_r, int howmany, std::string plan_flag, double *values, bool aligned = true);
+
+    // true if execute(values + k * step) is valid for every k >= 0, always for native
+    bool accepts(double *values, std::size_t step) const;
+
+    void execute(double *values);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+  private:
+    backend backend_ = backend::fftw;
+    std::size_t dim_r_ = 0, howmany_ = 0;
+    fftw_adapter::r2c_1d_many fftw_;
+    native_fft::r2c_1d native_;
+};
+
+struct c2r_1d_many
+{
+  public:
+    void plan(int dim_r, int howmany, std::string plan_flag, double *values, bool aligned = true);
+
+    bool accepts(double *values, std::size_t step) const;
+
+    void execute(double *values);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+  private:
+    backend backend_ = backend::fftw;
+    std::size_t dim_r_ = 0, howmany_ = 0;
+    fftw_adapter::c2r_1d_many fftw_;
+    native_fft::c2r_1d native_;
+};
+
+struct c2c_1d_many
+{
+  public:
+    void plan(int dim_c,
+              int howmany,
+              int stride,
+              int dist,
+              std::string plan_flag,
+              fftw_complex *values,
+              fftw_adapter::direction direction,
+              bool aligned = true);
+
+    bool accepts(double *values, std::size_t step) const;
+
+    void execute(fftw_complex *values);
+
+    void flops(double *add, double *mul, double *fma);
+
+    void print_plan(FILE *stream);
+
+  private:
+    backend backend_ = backend::fftw;
+    std::size_t dim_c_ = 0, howmany_ = 0, stride_ = 0, dist_ = 0;
+    fftw_adapter::c2c_1d_many fftw_;
+    native_fft::c2c_1d native_;
+};
+}  // namespace hpxfft::util::fft_backend
+#endif  // fft_backend_H_INCLUDED
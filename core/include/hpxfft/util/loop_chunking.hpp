@@ -0,0 +1,112 @@
+#ifndef loop_chunking_H_INCLUDED
+#define loop_chunking_H_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpxfft::util
+{
+// Chunking of a parallel loop: automatic leaves the choice to HPX,
+// tune lets a chunk_tuner pick one of the other policies at runtime.
+enum class chunk_policy { automatic, static_size, dynamic_size, guided_size, tune };
+
+inline chunk_policy string_to_chunk_policy(const std::string &policy_str)
+{
+    if (policy_str == "auto")
+    {
+        return chunk_policy::automatic;
+    }
+    else if (policy_str == "static")
+    {
+        return chunk_policy::static_size;
+    }
+    else if (policy_str == "dynamic")
+    {
+        return chunk_policy::dynamic_size;
+    }
+    else if (policy_str == "guided")
+    {
+        return chunk_policy::guided_size;
+    }
+    else if (policy_str == "tune")
+    {
+        return chunk_policy::tune;
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid chunk policy string");
+    }
+}
+
+struct chunk_param
+{
+    chunk_policy policy = chunk_policy::automatic;
+    // chunk size (static, dynamic) or minimal chunk size (guided), 0: HPX default
+    std::size_t size = 0;
+};
+
+// hpx::experimental::for_loop(par(task), first, last, f) with runtime chunking,
+// the future becomes ready once all iterations finished
+template <typename F>
+hpx::future<void> for_loop_chunked_async(const chunk_param &param, std::size_t first, std::size_t last, F &&f)
+{
+    const auto policy = hpx::execution::par(hpx::execution::task);
+    // dynamic and guided chunking require a positive size
+    const std::size_t size = std::max(param.size, std::size_t(1));
+    switch (param.policy)
+    {
+    case chunk_policy::static_size:
+        return hpx::experimental::for_loop(
+            policy.with(hpx::execution::experimental::static_chunk_size(param.size)), first, last, std::forward<F>(f));
+    case chunk_policy::dynamic_size:
+        return hpx::experimental::for_loop(
+            policy.with(hpx::execution::experimental::dynamic_chunk_size(size)), first, last, std::forward<F>(f));
+    case chunk_policy::guided_size:
+        return hpx::experimental::for_loop(
+            policy.with(hpx::execution::experimental::guided_chunk_size(size)), first, last, std::forward<F>(f));
+    default:
+        return hpx::experimental::for_loop(policy, first, last, std::forward<F>(f));
+    }
+}
+
+// blocking hpx::experimental::for_loop(par, first, last, f) with runtime chunking
+template <typename F>
+void for_loop_chunked(const chunk_param &param, std::size_t first, std::size_t last, F &&f)
+{
+    for_loop_chunked_async(param, first, last, std::forward<F>(f)).get();
+}
+
+// Times one candidate chunking per execution of a loop and locks in the
+// fastest one after all candidates were tried.
+struct chunk_tuner
+{
+  public:
+    chunk_tuner() = default;
+
+    // candidates for a loop of n_iterations on n_threads worker threads
+    void initialize(std::size_t n_iterations, std::size_t n_threads);
+
+    // chunking to use for the next execution
+    const chunk_param &current() const;
+
+    // report runtime of the last execution with current()
+    void record(double runtime);
+
+    bool locked() const noexcept;
+
+  private:
+    std::vector<chunk_param> candidates_;
+    std::vector<double> runtimes_;
+    std::size_t trial_ = 0;
+    bool locked_ = false;
+    chunk_param best_;
+};
+}  // namespace hpxfft::util
+#endif  // loop_chunking_H_INCLUDED
@@ -0,0 +1,80 @@
+#ifndef native_fft_H_INCLUDED
+#define native_fft_H_INCLUDED
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// In-tree FFT kernels for power-of-two lengths without FFTW:
+// Stockham autosort with radix-4 stages and a final radix-2 stage,
+// twiddle tables are computed once at planning. Complex data is
+// interleaved (re, im) like fftw_complex.
+namespace hpxfft::util::native_fft
+{
+struct c2c_1d
+{
+  public:
+    // sign = -1: forward, sign = +1: backward (unnormalized)
+    void plan(int dim_c, int sign);
+
+    // in and out may alias
+    void execute(const double *in, double *out) const;
+
+    void flops(double *add, double *mul, double *fma) const;
+
+    void print_plan(FILE *stream) const;
+
+    std::size_t size() const noexcept;
+
+  private:
+    // ping-pong stages on the two buffers, returns buffer holding the result
+    double *transform(double *x, double *y) const;
+
+  private:
+    std::size_t n_ = 0;
+    int sign_ = -1;
+    // per radix-4 stage: (w1, w2, w3) for each butterfly, interleaved
+    std::vector<double> twiddles_;
+};
+
+struct r2c_1d
+{
+  public:
+    void plan(int dim_r);
+
+    // n real inputs, n / 2 + 1 complex outputs, in and out may alias
+    void execute(const double *in, double *out) const;
+
+    void flops(double *add, double *mul, double *fma) const;
+
+    void print_plan(FILE *stream) const;
+
+  private:
+    std::size_t n_ = 0;
+    // complex transform of half length
+    c2c_1d half_;
+    // exp(-2 pi i k / n) for k <= n / 4, interleaved
+    std::vector<double> twiddles_;
+};
+
+struct c2r_1d
+{
+  public:
+    void plan(int dim_r);
+
+    // n / 2 + 1 complex inputs, n real outputs (unnormalized), in and out may alias
+    void execute(const double *in, double *out) const;
+
+    void flops(double *add, double *mul, double *fma) const;
+
+    void print_plan(FILE *stream) const;
+
+  private:
+    std::size_t n_ = 0;
+    // backward complex transform of half length
+    c2c_1d half_;
+    // exp(-2 pi i k / n) for k <= n / 4, interleaved
+    std::vector<double> twiddles_;
+};
+}  // namespace hpxfft::util::native_fft
+#endif  // native_fft_H_INCLUDED
@@ -0,0 +1,103 @@
+#ifndef task_graph_H_INCLUDED
+#define task_graph_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/mutex.hpp>
+#include <memory>
+#include <vector>
+
+namespace hpxfft::util
+{
+// Counter-based DAG that is built once and replayed on every run.
+// Each node keeps the number of its predecessors. On run() the counters are
+// reset and a node is spawned as soon as its last predecessor finished, so a
+// replay only costs one task per node and no futures or shared states.
+// Nodes on the critical path can be given a high priority. While critical
+// nodes are outstanding, the number of running background nodes is bounded
+// so that long background work cannot occupy all worker threads.
+// If a node throws, no further nodes are started and the run finishes with
+// the first exception once the running nodes have drained.
+struct task_graph
+{
+  public:
+    task_graph() = default;
+
+    // add node running on the compute executor and return its index
+    std::size_t add_node(std::function<void()> work);
+
+    // add node running on the given executor and return its index
+    std::size_t add_node(std::function<void()> work, hpx::execution::parallel_executor executor);
+
+    // node "to" may only start once node "from" has finished
+    void add_edge(std::size_t from, std::size_t to);
+
+    // run node with the given priority, high priority marks the node as critical
+    void set_priority(std::size_t i, hpx::threads::thread_priority priority);
+
+    // maximal number of running background nodes while critical nodes are outstanding, 0: unbounded
+    void set_background_limit(std::size_t max_running);
+
+    // execute all nodes respecting the dependencies and wait for completion
+    void run();
+
+    // execute all nodes, the future becomes ready once every node finished
+    hpx::future<void> run_async();
+
+    std::size_t size() const noexcept;
+
+    void clear();
+
+  private:
+    void execute(std::size_t i);
+
+    // post node to its executor or defer it if the background limit is reached
+    void spawn(std::size_t i);
+
+    // hand the slot of a finished background node to a deferred node
+    void release_background_slot();
+
+    // lift the background limit once the last critical node finished
+    void release_deferred();
+
+    // store the first exception of the run and drop the deferred nodes
+    void fail(std::exception_ptr error);
+
+    // node left the run, the last one completes it
+    void finish_node();
+
+  private:
+    struct node
+    {
+        std::function<void()> work_;
+        hpx::execution::parallel_executor executor_;
+        std::vector<std::size_t> successors_;
+        std::size_t num_predecessors_ = 0;
+        bool critical_ = false;
+    };
+
+    std::vector<node> nodes_;
+    std::vector<std::size_t> roots_;
+    // dependency counters, reset on each run
+    std::unique_ptr<std::atomic<std::size_t>[]> counters_;
+    bool modified_ = true;
+    // completion of the current run: spawned or deferred nodes that did not finish
+    std::atomic<std::size_t> in_flight_{ 0 };
+    std::atomic<bool> failed_{ false };
+    std::exception_ptr error_;
+    hpx::promise<void> done_;
+    // bounded background nodes
+    std::size_t background_limit_ = 0;
+    std::size_t num_critical_ = 0;
+    std::atomic<std::size_t> critical_remaining_{ 0 };
+    hpx::mutex background_mutex_;
+    std::size_t running_background_ = 0;
+    std::deque<std::size_t> deferred_;
+};
+}  // namespace hpxfft::util
+#endif  // task_graph_H_INCLUDED
@@ -0,0 +1,43 @@
+#ifndef thread_pools_H_INCLUDED
+#define thread_pools_H_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/modules/resource_partitioner.hpp>
+
+namespace hpxfft::util
+{
+// Optional split of the cores into a communication pool that drives the
+// collectives and the default pool that runs FFTs and transposes.
+// Without a communication pool both executors use the default pool.
+constexpr const char *communication_pool_name = "hpxfft_communication";
+
+// to be called from hpx::init_params::rp_callback, n_cores = 0 keeps a single pool
+void create_communication_pool(hpx::resource::partitioner &rp, std::size_t n_cores);
+
+// executor for collectives and their continuations
+hpx::execution::parallel_executor communication_executor();
+
+// executor for FFT and transpose tasks
+hpx::execution::parallel_executor compute_executor();
+
+// number of worker threads of the compute pool
+std::size_t compute_thread_count();
+
+// executor pinned to one worker thread of the compute pool, tasks are not stolen
+hpx::execution::parallel_executor worker_executor(std::size_t worker);
+
+// number of background tasks that may run concurrently on the compute pool
+// while critical tasks are pending, keeps one worker thread free
+std::size_t background_task_limit();
+
+// loop over [first, last) split into at most background_task_limit() tasks on
+// the executor, so background work never occupies every worker thread
+hpx::future<void> background_for_loop(hpx::execution::parallel_executor executor,
+                                      std::size_t first,
+                                      std::size_t last,
+                                      std::function<void(std::size_t)> body);
+}  // namespace hpxfft::util
+#endif  // thread_pools_H_INCLUDED
@@ -77,6 +77,13 @@ struct vector_2d
         ar &n_row_;
         ar &n_col_;
         ar &size_;
+
+        if (Archive::is_loading::value)
+        {
+            delete[] values_;
+            values_ = new T[size_];
+        }
+
         for(std::size_t i=0; i<size_; ++i)
         {
             ar& values_[i];
@@ -128,7 +135,7 @@ inline vector_2d<T>::vector_2d(const vector_2d<T> &src) :
     n_row_(src.n_row_),
     n_col_(src.n_col_),
     size_(src.size_),
-    values_(new T[size_])
+    values_(new T[src.size_])
 {
     // for(std::size_t i = 0; i < size_; ++i)
     //     values_[ i ] = src.values_[ i ];
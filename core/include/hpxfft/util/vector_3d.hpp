@@ -9,12 +9,13 @@ namespace hpxfft::util
 template <typename T>
 struct vector_3d
 {
-    T *values_;
-    std::size_t size_;
+    // moved-from vectors are left empty
+    T *values_ = nullptr;
+    std::size_t size_ = 0;
     // row major format
-    std::size_t n_x_;  // First dimension
-    std::size_t n_y_;  // Second dimension
-    std::size_t n_z_;  // Third dimension
+    std::size_t n_x_ = 0;  // First dimension
+    std::size_t n_y_ = 0;  // Second dimension
+    std::size_t n_z_ = 0;  // Third dimension
 
   public:
     using iterator = T *;
@@ -29,7 +30,7 @@ struct vector_3d
     // move constructor
     vector_3d(vector_3d<T> &&) noexcept;
     // destructor
-    ~vector_3d() = default;
+    ~vector_3d() { delete[] values_; }
     // operators
     vector_3d<T> &operator=(vector_3d<T> &);
     vector_3d<T> &operator=(vector_3d<T> &&) noexcept;
@@ -85,6 +86,7 @@ struct vector_3d
 
         if (Archive::is_loading::value)
         {
+            delete[] values_;
             values_ = new T[size_];
         }
 
@@ -138,7 +140,7 @@ inline vector_3d<T>::vector_3d(const vector_3d<T> &src) :
     n_y_(src.n_y_),
     n_z_(src.n_z_),
     size_(src.size_),
-    values_(new T[size_])
+    values_(new T[src.size_])
 {
     std::copy(src.begin(), src.end(), begin());
 }
@@ -0,0 +1,348 @@
+#ifndef vector_nd_H_INCLUDED
+#define vector_nd_H_INCLUDED
+
+#include <hpx/serialization.hpp>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace hpxfft::util
+{
+
+// row major N-D vector with compile-time rank,
+// vector_nd<T, 3> has the same memory layout as vector_3d<T>
+template <typename T, std::size_t Rank>
+struct vector_nd
+{
+    static_assert(Rank > 0, "vector_nd needs at least one dimension");
+
+    using extents_type = std::array<std::size_t, Rank>;
+
+    // moved-from vectors are left empty
+    T *values_ = nullptr;
+    std::size_t size_ = 0;
+    // first entry is the slowest dimension
+    extents_type extents_ = {};
+
+  public:
+    using iterator = T *;
+    using const_iterator = const T *;
+    // default constructor
+    vector_nd() = default;
+    explicit vector_nd(const extents_type &extents);
+    // explicit contructors
+    vector_nd(const extents_type &extents, const T &v);
+    // copy constructor
+    vector_nd(const vector_nd<T, Rank> &);
+    // move constructor
+    vector_nd(vector_nd<T, Rank> &&) noexcept;
+    // destructor
+    ~vector_nd() { delete[] values_; }
+    // operators
+    vector_nd<T, Rank> &operator=(vector_nd<T, Rank> &);
+    vector_nd<T, Rank> &operator=(vector_nd<T, Rank> &&) noexcept;
+    T &operator()(const extents_type &index);
+    const T &operator()(const extents_type &index) const;
+    template <typename... I>
+    T &operator()(I... index);
+    template <typename... I>
+    const T &operator()(I... index) const;
+    T &at(const extents_type &index);
+    const T &at(const extents_type &index) const;
+    constexpr T *data() noexcept;
+    constexpr const T *data() const noexcept;
+    // iterators
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+    // i-th slice of the first dimension
+    iterator slice(std::size_t i) noexcept;
+    const_iterator slice(std::size_t i) const noexcept;
+    // size
+    std::size_t size() const noexcept;
+    std::size_t extent(std::size_t dim) const noexcept;
+    const extents_type &extents() const noexcept;
+    void rearrange(const extents_type &new_extents);
+    // Non-Member Functions
+    template <typename H, std::size_t R>
+    friend bool operator==(const vector_nd<H, R> &lhs, const vector_nd<H, R> &rhs);
+
+    // see https://stackoverflow.com/questions/3279543/what-is-the-copy-and-swap-idiom
+    friend void swap(vector_nd &first, vector_nd &second)
+    {
+        std::swap(first.extents_, second.extents_);
+        std::swap(first.size_, second.size_);
+        std::swap(first.values_, second.values_);
+    }
+
+  private:
+    std::size_t offset(const extents_type &index) const noexcept;
+
+    // serialization support
+    friend class hpx::serialization::access;
+
+    template <typename Archive>
+    void serialize(Archive &ar, const unsigned int version)
+    {
+        // clang-format off
+        for (std::size_t d = 0; d < Rank; ++d)
+        {
+            ar &extents_[d];
+        }
+        ar &size_;
+
+        if (Archive::is_loading::value)
+        {
+            delete[] values_;
+            values_ = new T[size_];
+        }
+
+        for (std::size_t i = 0; i < size_; ++i)
+        {
+            ar &values_[i];
+        }
+        // clang-format on
+    }
+};
+
+template <typename T, std::size_t Rank>
+inline vector_nd<T, Rank>::vector_nd(const extents_type &extents) :
+    extents_(extents)
+{
+    size_ = 1;
+    for (std::size_t d = 0; d < Rank; ++d)
+    {
+        size_ *= extents_[d];
+    }
+    values_ = new T[size_];
+
+    for (std::size_t i = 0; i < size_; ++i)
+    {
+        values_[i] = T();
+    }
+}
+
+template <typename T, std::size_t Rank>
+inline vector_nd<T, Rank>::vector_nd(const extents_type &extents, const T &v) :
+    extents_(extents)
+{
+    size_ = 1;
+    for (std::size_t d = 0; d < Rank; ++d)
+    {
+        size_ *= extents_[d];
+    }
+    values_ = new T[size_];
+    std::fill(begin(), end(), v);
+}
+
+template <typename T, std::size_t Rank>
+inline vector_nd<T, Rank>::vector_nd(const vector_nd<T, Rank> &src) :
+    values_(new T[src.size_]),
+    size_(src.size_),
+    extents_(src.extents_)
+{
+    std::copy(src.begin(), src.end(), begin());
+}
+
+template <typename T, std::size_t Rank>
+inline vector_nd<T, Rank>::vector_nd(vector_nd<T, Rank> &&mv) noexcept
+{
+    swap(*this, mv);
+}
+
+template <typename T, std::size_t Rank>
+inline vector_nd<T, Rank> &vector_nd<T, Rank>::operator=(vector_nd<T, Rank> &src)
+{
+    swap(*this, src);
+    return *this;
+}
+
+template <typename T, std::size_t Rank>
+inline vector_nd<T, Rank> &vector_nd<T, Rank>::operator=(vector_nd<T, Rank> &&mv) noexcept
+{
+    swap(*this, mv);
+    return *this;
+}
+
+template <typename T, std::size_t Rank>
+inline std::size_t vector_nd<T, Rank>::offset(const extents_type &index) const noexcept
+{
+    std::size_t offset = 0;
+    for (std::size_t d = 0; d < Rank; ++d)
+    {
+        offset = offset * extents_[d] + index[d];
+    }
+    return offset;
+}
+
+template <typename T, std::size_t Rank>
+inline T &vector_nd<T, Rank>::operator()(const extents_type &index)
+{
+    return values_[offset(index)];
+}
+
+template <typename T, std::size_t Rank>
+inline const T &vector_nd<T, Rank>::operator()(const extents_type &index) const
+{
+    return values_[offset(index)];
+}
+
+template <typename T, std::size_t Rank>
+template <typename... I>
+inline T &vector_nd<T, Rank>::operator()(I... index)
+{
+    static_assert(sizeof...(I) == Rank, "number of indices does not match the rank");
+    return values_[offset(extents_type{static_cast<std::size_t>(index)...})];
+}
+
+template <typename T, std::size_t Rank>
+template <typename... I>
+inline const T &vector_nd<T, Rank>::operator()(I... index) const
+{
+    static_assert(sizeof...(I) == Rank, "number of indices does not match the rank");
+    return values_[offset(extents_type{static_cast<std::size_t>(index)...})];
+}
+
+template <typename T, std::size_t Rank>
+inline T &vector_nd<T, Rank>::at(const extents_type &index)
+{
+    for (std::size_t d = 0; d < Rank; ++d)
+    {
+        if (index[d] >= extents_[d])
+        {
+            throw std::runtime_error("out of range exception");
+        }
+    }
+    return values_[offset(index)];
+}
+
+template <typename T, std::size_t Rank>
+inline const T &vector_nd<T, Rank>::at(const extents_type &index) const
+{
+    for (std::size_t d = 0; d < Rank; ++d)
+    {
+        if (index[d] >= extents_[d])
+        {
+            throw std::runtime_error("out of range exception");
+        }
+    }
+    return values_[offset(index)];
+}
+
+template <typename T, std::size_t Rank>
+inline constexpr T *vector_nd<T, Rank>::data() noexcept
+{
+    return values_;
+}
+
+template <typename T, std::size_t Rank>
+inline constexpr const T *vector_nd<T, Rank>::data() const noexcept
+{
+    return values_;
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::iterator vector_nd<T, Rank>::begin() noexcept
+{
+    return values_;
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::const_iterator vector_nd<T, Rank>::begin() const noexcept
+{
+    return values_;
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::iterator vector_nd<T, Rank>::end() noexcept
+{
+    return values_ + size_;
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::const_iterator vector_nd<T, Rank>::end() const noexcept
+{
+    return values_ + size_;
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::const_iterator vector_nd<T, Rank>::cbegin() const noexcept
+{
+    return values_;
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::const_iterator vector_nd<T, Rank>::cend() const noexcept
+{
+    return values_ + size_;
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::iterator vector_nd<T, Rank>::slice(std::size_t i) noexcept
+{
+    return values_ + i * (size_ / extents_[0]);
+}
+
+template <typename T, std::size_t Rank>
+inline typename vector_nd<T, Rank>::const_iterator vector_nd<T, Rank>::slice(std::size_t i) const noexcept
+{
+    return values_ + i * (size_ / extents_[0]);
+}
+
+template <typename T, std::size_t Rank>
+inline std::size_t vector_nd<T, Rank>::size() const noexcept
+{
+    return size_;
+}
+
+template <typename T, std::size_t Rank>
+inline std::size_t vector_nd<T, Rank>::extent(std::size_t dim) const noexcept
+{
+    return extents_[dim];
+}
+
+template <typename T, std::size_t Rank>
+inline const typename vector_nd<T, Rank>::extents_type &vector_nd<T, Rank>::extents() const noexcept
+{
+    return extents_;
+}
+
+template <typename T, std::size_t Rank>
+inline void vector_nd<T, Rank>::rearrange(const extents_type &new_extents)
+{
+    std::size_t new_size = 1;
+    for (std::size_t d = 0; d < Rank; ++d)
+    {
+        new_size *= new_extents[d];
+    }
+    if (new_size != size_)
+    {
+        throw std::runtime_error("New dimensions do not match total size.");
+    }
+    extents_ = new_extents;
+}
+
+template <typename H, std::size_t R>
+inline bool operator==(const vector_nd<H, R> &lhs, const vector_nd<H, R> &rhs)
+{
+    if (lhs.extents_ != rhs.extents_)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < lhs.size_; ++i)
+    {
+        if (lhs.values_[i] != rhs.values_[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace hpxfft::util
+#endif  // vector_nd_H_INCLUDED
@@ -1,7 +1,9 @@
 #include "../../../include/hpxfft/2D/distributed/agas.hpp"
 
+#include "../../../include/hpxfft/util/thread_pools.hpp"
 #include <hpx/hpx_init.hpp>
 #include <hpx/modules/components.hpp>
+#include <stdexcept>
 
 // HPX_REGISTER_COMPONENT() exposes the component creation
 // through hpx::new_<>().
@@ -16,6 +18,8 @@ HPX_REGISTER_ACTION(fft_2d_r2c_action)
 // typedef hpxfft::fft2D::distributed::agas_server::initialize_action initialize_action;
 HPX_REGISTER_ACTION(initialize_action)
 
+HPX_REGISTER_ACTION(set_values_action)
+
 // FFT backend
 void hpxfft::fft2D::distributed::agas_server::fft_1d_r2c_inplace(const std::size_t i)
 {
@@ -28,11 +32,31 @@ void hpxfft::fft2D::distributed::agas_server::fft_1d_c2c_inplace(const std::size
                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(i)));
 }
 
+// communication buffers
+void hpxfft::fft2D::distributed::agas_server::prepare_communication(vector_comm &prep, const std::size_t block_size)
+{
+    prep.resize(num_localities_);
+    for (std::size_t j = 0; j < num_localities_; ++j)
+    {
+        // block of this locality is never communicated and stays empty
+        if (j != this_locality_)
+        {
+            prep[j].resize(block_size);
+        }
+    }
+}
+
 // split data for communication
 void hpxfft::fft2D::distributed::agas_server::split_vec(const std::size_t i)
 {
     for (std::size_t j = 0; j < num_localities_; ++j)
-    {  // std::move same performance
+    {
+        // block of this locality is transposed locally
+        if (j == this_locality_)
+        {
+            continue;
+        }
+        // std::move same performance
         std::copy(values_vec_.row(i) + j * dim_c_y_part_,
                   values_vec_.row(i) + (j + 1) * dim_c_y_part_,
                   values_prep_[j].begin() + i * dim_c_y_part_);
@@ -42,7 +66,13 @@ void hpxfft::fft2D::distributed::agas_server::split_vec(const std::size_t i)
 void hpxfft::fft2D::distributed::agas_server::split_trans_vec(const std::size_t i)
 {
     for (std::size_t j = 0; j < num_localities_; ++j)
-    {  // std::move same performance
+    {
+        // block of this locality is transposed locally
+        if (j == this_locality_)
+        {
+            continue;
+        }
+        // std::move same performance
         std::copy(trans_values_vec_.row(i) + j * dim_c_x_part_,
                   trans_values_vec_.row(i) + (j + 1) * dim_c_x_part_,
                   trans_values_prep_[j].begin() + i * dim_c_x_part_);
@@ -55,16 +85,17 @@ void hpxfft::fft2D::distributed::agas_server::communicate_scatter_vec(const std:
     if (this_locality_ != i)
     {
         // receive from other locality
-        communication_vec_[i] =
-            hpx::collectives::scatter_from<std::vector<real>>(communicators_[i], hpx::collectives::generation_arg(1))
-                .get();
+        communication_vec_[i] = hpx::collectives::scatter_from<std::vector<real>>(
+                                    communicators_[i], hpx::collectives::generation_arg(generation_ - 1))
+                                    .get();
     }
     else
     {
         // send from this locality
-        communication_vec_[i] = hpx::collectives::scatter_to(
-                                    communicators_[i], std::move(values_prep_), hpx::collectives::generation_arg(1))
-                                    .get();
+        communication_vec_[i] =
+            hpx::collectives::scatter_to(
+                communicators_[i], std::move(values_prep_), hpx::collectives::generation_arg(generation_ - 1))
+                .get();
     }
 }
 
@@ -73,16 +104,16 @@ void hpxfft::fft2D::distributed::agas_server::communicate_scatter_trans_vec(cons
     if (this_locality_ != i)
     {
         // receive from other locality
-        communication_vec_[i] =
-            hpx::collectives::scatter_from<std::vector<real>>(communicators_[i], hpx::collectives::generation_arg(2))
-                .get();
+        communication_vec_[i] = hpx::collectives::scatter_from<std::vector<real>>(
+                                    communicators_[i], hpx::collectives::generation_arg(generation_))
+                                    .get();
     }
     else
     {
         // send from this locality
         communication_vec_[i] =
             hpx::collectives::scatter_to(
-                communicators_[i], std::move(trans_values_prep_), hpx::collectives::generation_arg(2))
+                communicators_[i], std::move(trans_values_prep_), hpx::collectives::generation_arg(generation_))
                 .get();
     }
 }
@@ -91,15 +122,17 @@ void hpxfft::fft2D::distributed::agas_server::communicate_scatter_trans_vec(cons
 void hpxfft::fft2D::distributed::agas_server::communicate_all_to_all_vec()
 {
     communication_vec_ =
-        hpx::collectives::all_to_all(communicators_[0], std::move(values_prep_), hpx::collectives::generation_arg(1))
+        hpx::collectives::all_to_all(
+            communicators_[0], std::move(values_prep_), hpx::collectives::generation_arg(generation_ - 1))
             .get();
 }
 
 void hpxfft::fft2D::distributed::agas_server::communicate_all_to_all_trans_vec()
 {
-    communication_vec_ = hpx::collectives::all_to_all(
-                             communicators_[0], std::move(trans_values_prep_), hpx::collectives::generation_arg(2))
-                             .get();
+    communication_vec_ =
+        hpx::collectives::all_to_all(
+            communicators_[0], std::move(trans_values_prep_), hpx::collectives::generation_arg(generation_))
+            .get();
 }
 
 // transpose after communication
@@ -145,158 +178,175 @@ void hpxfft::fft2D::distributed::agas_server::transpose_x_to_y(const std::size_t
     }
 }
 
-// 2D FFT algorithm
-hpxfft::fft2D::distributed::vector_2d hpxfft::fft2D::distributed::agas_server::fft_2d_r2c()
+// transpose of the local block directly from the source vector
+void hpxfft::fft2D::distributed::agas_server::transpose_y_to_x_local(const std::size_t k)
+{
+    std::size_t index_out;
+    const std::size_t index_in = this_locality_ * dim_c_y_part_ + 2 * k;
+    const std::size_t offset_out = 2 * this_locality_;
+    const std::size_t factor_out = 2 * num_localities_;
+
+    for (std::size_t j = 0; j < n_x_local_; ++j)
+    {
+        // compute index once use twice
+        index_out = factor_out * j + offset_out;
+        // transpose
+        trans_values_vec_(k, index_out) = values_vec_(j, index_in);
+        trans_values_vec_(k, index_out + 1) = values_vec_(j, index_in + 1);
+    }
+}
+
+void hpxfft::fft2D::distributed::agas_server::transpose_x_to_y_local(const std::size_t j)
+{
+    std::size_t index_in;
+    const std::size_t offset_in = this_locality_ * dim_c_x_part_;
+    const std::size_t index_out = 2 * num_localities_ * j + 2 * this_locality_;
+
+    for (std::size_t k = 0; k < n_x_local_; ++k)
+    {
+        // compute index once use twice
+        index_in = offset_in + 2 * k;
+        // transpose
+        values_vec_(k, index_out) = trans_values_vec_(j, index_in);
+        values_vec_(k, index_out + 1) = trans_values_vec_(j, index_in + 1);
+    }
+}
+
+// task graph
+void hpxfft::fft2D::distributed::agas_server::build_task_graph()
 {
+    task_graph_.clear();
+    const bool scatter = COMM_FLAG_ == "scatter";
+    const std::size_t n_comm = scatter ? num_localities_ : 1;
+    // collectives run on the communication pool if one was created
+    const hpx::execution::parallel_executor communication_executor = hpxfft::util::communication_executor();
+    // critical path: tasks feeding the collectives and the collectives themselves,
+    // background: local transposes that overlap with communication and the final transposes
+    task_graph_.set_background_limit(hpxfft::util::background_task_limit());
+    // local synchronization steps for communication
+    std::size_t all_split_vec = task_graph_.add_node({});
+    std::size_t all_split_trans_vec = task_graph_.add_node({});
+    task_graph_.set_priority(all_split_vec, hpx::threads::thread_priority::high);
+    task_graph_.set_priority(all_split_trans_vec, hpx::threads::thread_priority::high);
+    // communication buffers were moved into the collectives of the previous run
+    std::size_t prep_vec =
+        task_graph_.add_node([this] { prepare_communication(values_prep_, n_x_local_ * dim_c_y_part_); });
+    task_graph_.set_priority(prep_vec, hpx::threads::thread_priority::high);
+    std::size_t prep_trans_vec =
+        task_graph_.add_node([this] { prepare_communication(trans_values_prep_, n_y_local_ * dim_c_x_part_); });
     // first dimension
     for (std::size_t i = 0; i < n_x_local_; ++i)
     {
         // 1d FFT r2c in y-direction
-        r2c_futures_[i] = hpx::async(fft_1d_r2c_inplace_action(), get_id(), i);
+        std::size_t r2c = task_graph_.add_node([this, i] { fft_1d_r2c_inplace(i); });
+        task_graph_.set_priority(r2c, hpx::threads::thread_priority::high);
         // prepare for communication
-        split_vec_futures_[i] = r2c_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(split_vec_action(), get_id(), i);
-            });
+        std::size_t split = task_graph_.add_node([this, i] { split_vec(i); });
+        task_graph_.set_priority(split, hpx::threads::thread_priority::high);
+        task_graph_.add_edge(r2c, split);
+        task_graph_.add_edge(prep_vec, split);
+        task_graph_.add_edge(split, all_split_vec);
     }
-    // local synchronization step for communication
-    hpx::shared_future<vector_future> all_split_vec_futures = hpx::when_all(split_vec_futures_);
     // communication for FFT in second dimension
-    if (COMM_FLAG_ == "scatter")
+    std::vector<std::size_t> communication(n_comm);
+    for (std::size_t i = 0; i < n_comm; ++i)
     {
-        // scatter operation from all localities
-        for (std::size_t i = 0; i < num_localities_; ++i)
+        if (scatter)
         {
-            communication_futures_[i] = all_split_vec_futures.then(
-                [=, this](hpx::shared_future<vector_future> r)
-                {
-                    r.get();
-                    return hpx::async(communicate_scatter_vec_action(), get_id(), i);
-                });
+            // scatter operation from all localities
+            communication[i] = task_graph_.add_node([this, i] { communicate_scatter_vec(i); }, communication_executor);
         }
-        // tranpose from y-direction to x-direction
-        for (std::size_t k = 0; k < n_y_local_; ++k)
+        else
         {
-            for (std::size_t i = 0; i < num_localities_; ++i)
-            {
-                trans_y_to_x_futures_[k][i] = communication_futures_[i].then(
-                    [=, this](hpx::shared_future<void> r)
-                    {
-                        r.get();
-                        return hpx::async(transpose_y_to_x_action(), get_id(), k, i);
-                    });
-            }
+            // all to all operation
+            communication[i] = task_graph_.add_node([this] { communicate_all_to_all_vec(); }, communication_executor);
         }
+        task_graph_.set_priority(communication[i], hpx::threads::thread_priority::high);
+        task_graph_.add_edge(all_split_vec, communication[i]);
     }
-    else if (COMM_FLAG_ == "all_to_all")
+    // second dimension
+    for (std::size_t k = 0; k < n_y_local_; ++k)
     {
-        // all to all operation
-        communication_futures_[0] = all_split_vec_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
-            {
-                r.get();
-                return hpx::async(communicate_all_to_all_vec_action(), get_id());
-            });
-        // tranpose from y-direction to x-direction
-        for (std::size_t k = 0; k < n_y_local_; ++k)
+        // 1D FFT in x-direction once all blocks of the row are transposed
+        std::size_t c2c = task_graph_.add_node([this, k] { fft_1d_c2c_inplace(k); });
+        task_graph_.set_priority(c2c, hpx::threads::thread_priority::high);
+        // tranpose local block from y-direction to x-direction while communicating
+        std::size_t trans_local = task_graph_.add_node([this, k] { transpose_y_to_x_local(k); });
+        task_graph_.add_edge(all_split_vec, trans_local);
+        task_graph_.add_edge(trans_local, c2c);
+        // tranpose communicated blocks from y-direction to x-direction
+        for (std::size_t i = 0; i < num_localities_; ++i)
         {
-            for (std::size_t i = 0; i < num_localities_; ++i)
+            if (i == this_locality_)
             {
-                trans_y_to_x_futures_[k][i] = communication_futures_[0].then(
-                    [=, this](hpx::shared_future<void> r)
-                    {
-                        r.get();
-                        return hpx::async(transpose_y_to_x_action(), get_id(), k, i);
-                    });
+                continue;
             }
+            std::size_t trans = task_graph_.add_node([this, k, i] { transpose_y_to_x(k, i); });
+            task_graph_.set_priority(trans, hpx::threads::thread_priority::high);
+            task_graph_.add_edge(communication[scatter ? i : 0], trans);
+            task_graph_.add_edge(trans, c2c);
         }
-    }
-    else
-    {
-        std::cout << "Communication scheme not specified during initialization\n";
-        hpx::finalize();
-    }
-    // second dimension
-    for (std::size_t i = 0; i < n_y_local_; ++i)
-    {
-        // synchronize
-        hpx::future<vector_future> all_trans_y_to_x_i_futures = hpx::when_all(trans_y_to_x_futures_[i]);
-        // 1D FFT in x-direction
-        c2c_futures_[i] = all_trans_y_to_x_i_futures.then(
-            [=, this](hpx::future<vector_future> r)
-            {
-                r.get();
-                return hpx::async(fft_1d_c2c_inplace_action(), get_id(), i);
-            });
         // prepare for communication
-        split_trans_vec_futures_[i] = c2c_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(split_trans_vec_action(), get_id(), i);
-            });
+        std::size_t split = task_graph_.add_node([this, k] { split_trans_vec(k); });
+        task_graph_.set_priority(split, hpx::threads::thread_priority::high);
+        task_graph_.add_edge(c2c, split);
+        task_graph_.add_edge(prep_trans_vec, split);
+        task_graph_.add_edge(split, all_split_trans_vec);
     }
-    // local synchronization step for communication
-    hpx::shared_future<vector_future> all_split_trans_vec_futures = hpx::when_all(split_trans_vec_futures_);
     /////////////////////////////////
     // communication to get original data layout
-    if (COMM_FLAG_ == "scatter")
+    for (std::size_t i = 0; i < n_comm; ++i)
     {
-        // scatter operation from all localities
-        for (std::size_t i = 0; i < num_localities_; ++i)
+        if (scatter)
         {
-            communication_futures_[i] = all_split_trans_vec_futures.then(
-                [=, this](hpx::shared_future<vector_future> r)
-                {
-                    r.get();
-                    return hpx::async(communicate_scatter_trans_vec_action(), get_id(), i);
-                });
+            // scatter operation from all localities
+            communication[i] =
+                task_graph_.add_node([this, i] { communicate_scatter_trans_vec(i); }, communication_executor);
         }
-        // tranpose from x-direction to y-direction
-        for (std::size_t j = 0; j < n_y_local_; ++j)
+        else
         {
-            for (std::size_t i = 0; i < num_localities_; ++i)
-            {
-                trans_x_to_y_futures_[j][i] = communication_futures_[i].then(
-                    [=, this](hpx::shared_future<void> r)
-                    {
-                        r.get();
-                        return hpx::async(transpose_x_to_y_action(), get_id(), j, i);
-                    });
-            }
+            // all to all operation
+            communication[i] =
+                task_graph_.add_node([this] { communicate_all_to_all_trans_vec(); }, communication_executor);
         }
+        task_graph_.set_priority(communication[i], hpx::threads::thread_priority::high);
+        task_graph_.add_edge(all_split_trans_vec, communication[i]);
     }
-    else if (COMM_FLAG_ == "all_to_all")
+    for (std::size_t j = 0; j < n_y_local_; ++j)
     {
-        // all to all operation
-        communication_futures_[0] = all_split_trans_vec_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
-            {
-                r.get();
-                return hpx::async(communicate_all_to_all_trans_vec_action(), get_id());
-            });
-        // tranpose from x-direction to y-direction
-        for (std::size_t k = 0; k < n_x_local_; ++k)
+        // tranpose local block from x-direction to y-direction while communicating
+        std::size_t trans_local = task_graph_.add_node([this, j] { transpose_x_to_y_local(j); });
+        task_graph_.add_edge(all_split_trans_vec, trans_local);
+        // tranpose communicated blocks from x-direction to y-direction
+        for (std::size_t i = 0; i < num_localities_; ++i)
         {
-            for (std::size_t i = 0; i < num_localities_; ++i)
+            if (i == this_locality_)
             {
-                trans_x_to_y_futures_[k][i] = communication_futures_[0].then(
-                    [=, this](hpx::shared_future<void> r)
-                    {
-                        r.get();
-                        return hpx::async(transpose_x_to_y_action(), get_id(), k, i);
-                    });
+                continue;
             }
+            std::size_t trans = task_graph_.add_node([this, j, i] { transpose_x_to_y(j, i); });
+            task_graph_.add_edge(communication[scatter ? i : 0], trans);
         }
     }
-    // wait for every task to finish
-    for (std::size_t i = 0; i < n_x_local_; ++i)
+}
+
+// 2D FFT algorithm
+hpx::future<hpxfft::fft2D::distributed::vector_2d> hpxfft::fft2D::distributed::agas_server::fft_2d_r2c()
+{
+    if (COMM_FLAG_ != "scatter" && COMM_FLAG_ != "all_to_all")
     {
-        hpx::wait_all(trans_x_to_y_futures_[i]);
-    };
-    return std::move(values_vec_);
+        std::cout << "Communication scheme not specified during initialization\n";
+        hpx::finalize();
+    }
+    // fresh generations for both exchanges of this run
+    generation_ += 2;
+    // replay prebuilt task graph
+    return task_graph_.run_async().then(
+        [this](hpx::future<void> r)
+        {
+            r.get();
+            return std::move(values_vec_);
+        });
 }
 
 // initialization
@@ -318,31 +368,37 @@ void hpxfft::fft2D::distributed::agas_server::initialize(
     dim_c_x_part_ = 2 * dim_c_x_ / num_localities_;
     // resize other data structures
     trans_values_vec_ = std::move(hpxfft::fft2D::distributed::vector_2d(n_y_local_, 2 * dim_c_x_));
-    values_prep_.resize(num_localities_);
-    trans_values_prep_.resize(num_localities_);
-    for (std::size_t i = 0; i < num_localities_; ++i)
-    {
-        values_prep_[i].resize(n_x_local_ * dim_c_y_part_);
-        trans_values_prep_[i].resize(n_y_local_ * dim_c_x_part_);
-    }
+    // communication buffers are sized by the task graph before every split
+    PLAN_FLAG_ = PLAN_FLAG;
     // create FFTW plans
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
     // r2c in y-direction
-    fft_r2c_adapter_ = hpxfft::util::fftw_adapter::r2c_1d();
-    fft_r2c_adapter_.plan(
-        dim_r_y_, PLAN_FLAG, trans_values_vec_.row(0), reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)));
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          1,
+                          r2c_aligned);
     // c2c in x-direction
-    fft_c2c_adapter_ = hpxfft::util::fftw_adapter::c2c_1d();
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
     fft_c2c_adapter_.plan(dim_c_x_,
                           PLAN_FLAG,
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
-                          hpxfft::util::fftw_adapter::direction::forward);
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          1,
+                          c2c_aligned);
     // communication specific initialization
     COMM_FLAG_ = COMM_FLAG;
+    generation_ = 0;
     if (COMM_FLAG_ == "scatter")
     {
         communication_vec_.resize(num_localities_);
-        communication_futures_.resize(num_localities_);
         // setup communicators
         basenames_.resize(num_localities_);
         communicators_.resize(num_localities_);
@@ -358,7 +414,6 @@ void hpxfft::fft2D::distributed::agas_server::initialize(
     else if (COMM_FLAG_ == "all_to_all")
     {
         communication_vec_.resize(1);
-        communication_futures_.resize(1);
         // setup communicators
         basenames_.resize(1);
         communicators_.resize(1);
@@ -373,19 +428,25 @@ void hpxfft::fft2D::distributed::agas_server::initialize(
         std::cout << "Specify communication scheme: scatter or all_to_all\n";
         hpx::finalize();
     }
-    // resize futures
-    r2c_futures_.resize(n_x_local_);
-    split_vec_futures_.resize(n_x_local_);
-    c2c_futures_.resize(n_y_local_);
-    split_trans_vec_futures_.resize(n_y_local_);
-    trans_y_to_x_futures_.resize(n_y_local_);
-    trans_x_to_y_futures_.resize(n_x_local_);
-    for (std::size_t i = 0; i < n_y_local_; ++i)
+    // dependency structure of the transform
+    build_task_graph();
+}
+
+void hpxfft::fft2D::distributed::agas_server::set_values(vector_2d values_vec)
+{
+    if (values_vec.n_row() != n_x_local_ || values_vec.n_col() != 2 * dim_c_y_)
     {
-        trans_y_to_x_futures_[i].resize(num_localities_);
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
     }
-    for (std::size_t i = 0; i < n_x_local_; ++i)
+    values_vec_ = std::move(values_vec);
+    // a buffer of another alignment than the planned one needs an unaligned r2c plan
+    if (!fft_r2c_adapter_.accepts(values_vec_.row(0), values_vec_.n_col()))
     {
-        trans_x_to_y_futures_[i].resize(num_localities_);
+        fft_r2c_adapter_.plan(dim_r_y_,
+                              PLAN_FLAG_,
+                              trans_values_vec_.row(0),
+                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                              1,
+                              false);
     }
 }
@@ -0,0 +1,85 @@
+#include "../../../include/hpxfft/2D/distributed/agas_orchestrator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+// create one server per locality
+hpxfft::fft2D::distributed::agas_orchestrator::agas_orchestrator()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    // slab i must end up on locality i
+    std::sort(localities.begin(),
+              localities.end(),
+              [](const hpx::id_type &a, const hpx::id_type &b)
+              { return hpx::naming::get_locality_id_from_id(a) < hpx::naming::get_locality_id_from_id(b); });
+    num_localities_ = localities.size();
+    servers_.reserve(num_localities_);
+    for (const hpx::id_type &locality : localities)
+    {
+        servers_.emplace_back(hpx::new_<agas_server>(locality));
+    }
+    slabs_.resize(num_localities_);
+}
+
+// initialization
+hpx::future<void> hpxfft::fft2D::distributed::agas_orchestrator::initialize(
+    hpxfft::fft2D::distributed::vector_2d values_vec, const std::string COMM_FLAG, const std::string PLAN_FLAG)
+{
+    // parameters
+    if (values_vec.n_row() == 0 || values_vec.n_row() % num_localities_ != 0)
+    {
+        throw std::invalid_argument("Row slabs require n_x to be a positive multiple of the number of localities");
+    }
+    n_x_local_ = values_vec.n_row() / num_localities_;
+    n_col_ = values_vec.n_col();
+    // distribute row slabs, the initialization of all localities runs concurrently
+    vector_future initialize_futures(num_localities_);
+    for (std::size_t i = 0; i < num_localities_; ++i)
+    {
+        vector_2d slab(n_x_local_, n_col_);
+        std::copy(values_vec.row(i * n_x_local_), values_vec.row((i + 1) * n_x_local_), slab.begin());
+        initialize_futures[i] = servers_[i].initialize(std::move(slab), COMM_FLAG, PLAN_FLAG);
+    }
+    return hpx::when_all(std::move(initialize_futures))
+        .then(
+            [](hpx::future<vector_future> r)
+            {
+                for (hpx::future<void> &f : r.get())
+                {
+                    f.get();
+                }
+            });
+}
+
+// 2D FFT algorithm
+hpx::future<void> hpxfft::fft2D::distributed::agas_orchestrator::fft_2d_r2c()
+{
+    std::vector<hpx::future<vector_2d>> fft_futures(num_localities_);
+    for (std::size_t i = 0; i < num_localities_; ++i)
+    {
+        // launch 2D FFT on all localities
+        fft_futures[i] = servers_[i].fft_2d_r2c();
+    }
+    return hpx::when_all(std::move(fft_futures))
+        .then(
+            [this](hpx::future<std::vector<hpx::future<vector_2d>>> r)
+            {
+                std::vector<hpx::future<vector_2d>> results = r.get();
+                for (std::size_t i = 0; i < num_localities_; ++i)
+                {
+                    slabs_[i] = results[i].get();
+                }
+            });
+}
+
+// helpers
+hpxfft::fft2D::distributed::vector_2d hpxfft::fft2D::distributed::agas_orchestrator::get_result()
+{
+    // gather row slabs in locality order
+    vector_2d values_vec(num_localities_ * n_x_local_, n_col_);
+    for (std::size_t i = 0; i < num_localities_; ++i)
+    {
+        std::copy(slabs_[i].begin(), slabs_[i].end(), values_vec.row(i * n_x_local_));
+    }
+    return values_vec;
+}
@@ -1,7 +1,9 @@
 #include "../../../include/hpxfft/2D/distributed/loop.hpp"
 
+#include "../../../include/hpxfft/util/thread_pools.hpp"
 #include <hpx/hpx_init.hpp>
 #include <hpx/parallel/algorithms/for_loop.hpp>
+#include <stdexcept>
 
 // FFT backend
 void hpxfft::fft2D::distributed::loop::fft_1d_r2c_inplace(const std::size_t i)
@@ -15,11 +17,31 @@ void hpxfft::fft2D::distributed::loop::fft_1d_c2c_inplace(const std::size_t i)
                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(i)));
 }
 
+// communication buffers
+void hpxfft::fft2D::distributed::loop::prepare_communication(vector_comm &prep, const std::size_t block_size)
+{
+    prep.resize(num_localities_);
+    for (std::size_t j = 0; j < num_localities_; ++j)
+    {
+        // block of this locality is never communicated and stays empty
+        if (j != this_locality_)
+        {
+            prep[j].resize(block_size);
+        }
+    }
+}
+
 // split data for communication
 void hpxfft::fft2D::distributed::loop::split_vec(const std::size_t i)
 {
     for (std::size_t j = 0; j < num_localities_; ++j)
-    {  // std::move same performance
+    {
+        // block of this locality is transposed locally
+        if (j == this_locality_)
+        {
+            continue;
+        }
+        // std::move same performance
         std::copy(values_vec_.row(i) + j * dim_c_y_part_,
                   values_vec_.row(i) + (j + 1) * dim_c_y_part_,
                   values_prep_[j].begin() + i * dim_c_y_part_);
@@ -29,7 +51,13 @@ void hpxfft::fft2D::distributed::loop::split_vec(const std::size_t i)
 void hpxfft::fft2D::distributed::loop::split_trans_vec(const std::size_t i)
 {
     for (std::size_t j = 0; j < num_localities_; ++j)
-    {  // std::move same performance
+    {
+        // block of this locality is transposed locally
+        if (j == this_locality_)
+        {
+            continue;
+        }
+        // std::move same performance
         std::copy(trans_values_vec_.row(i) + j * dim_c_x_part_,
                   trans_values_vec_.row(i) + (j + 1) * dim_c_x_part_,
                   trans_values_prep_[j].begin() + i * dim_c_x_part_);
@@ -41,14 +69,14 @@ void hpxfft::fft2D::distributed::loop::communicate_scatter_vec(const std::size_t
     if (this_locality_ != i)
     {
         // receive from other locality
-        communication_futures_[i] =
-            hpx::collectives::scatter_from<std::vector<real>>(communicators_[i], hpx::collectives::generation_arg(1));
+        communication_futures_[i] = hpx::collectives::scatter_from<std::vector<real>>(
+            communicators_[i], hpx::collectives::generation_arg(generation_));
     }
     else
     {
         // send from this locality
         communication_futures_[i] = hpx::collectives::scatter_to(
-            communicators_[i], std::move(values_prep_), hpx::collectives::generation_arg(1));
+            communicators_[i], std::move(values_prep_), hpx::collectives::generation_arg(generation_));
     }
 }
 
@@ -57,30 +85,28 @@ void hpxfft::fft2D::distributed::loop::communicate_scatter_trans_vec(const std::
     if (this_locality_ != i)
     {
         // receive from other locality
-        communication_futures_[i] =
-            hpx::collectives::scatter_from<std::vector<real>>(communicators_[i], hpx::collectives::generation_arg(2));
+        communication_futures_[i] = hpx::collectives::scatter_from<std::vector<real>>(
+            communicators_[i], hpx::collectives::generation_arg(generation_));
     }
     else
     {
         // send from this locality
         communication_futures_[i] = hpx::collectives::scatter_to(
-            communicators_[i], std::move(trans_values_prep_), hpx::collectives::generation_arg(2));
+            communicators_[i], std::move(trans_values_prep_), hpx::collectives::generation_arg(generation_));
     }
 }
 
 // all to all communication
 void hpxfft::fft2D::distributed::loop::communicate_all_to_all_vec()
 {
-    communication_vec_ =
-        hpx::collectives::all_to_all(communicators_[0], std::move(values_prep_), hpx::collectives::generation_arg(1))
-            .get();
+    all_to_all_future_ = hpx::collectives::all_to_all(
+        communicators_[0], std::move(values_prep_), hpx::collectives::generation_arg(generation_));
 }
 
 void hpxfft::fft2D::distributed::loop::communicate_all_to_all_trans_vec()
 {
-    communication_vec_ = hpx::collectives::all_to_all(
-                             communicators_[0], std::move(trans_values_prep_), hpx::collectives::generation_arg(2))
-                             .get();
+    all_to_all_future_ = hpx::collectives::all_to_all(
+        communicators_[0], std::move(trans_values_prep_), hpx::collectives::generation_arg(generation_));
 }
 
 // transpose after communication
@@ -126,33 +152,44 @@ void hpxfft::fft2D::distributed::loop::transpose_x_to_y(const std::size_t j, con
     }
 }
 
-// 2D FFT algorithm
-hpxfft::fft2D::distributed::vector_2d hpxfft::fft2D::distributed::loop::fft_2d_r2c()
+// transpose of the local block directly from the source vector
+void hpxfft::fft2D::distributed::loop::transpose_y_to_x_local(const std::size_t k)
 {
-    /////////////////////////////////////////////////////////////////
-    // first dimension
-    auto start_total = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        n_x_local_,
-        [&](auto i)
-        {
-            // 1d FFT r2c in y-direction
-            fft_1d_r2c_inplace(i);
-        });
-    auto start_first_split = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        n_x_local_,
-        [&](auto i)
-        {
-            // rearrange for communication step
-            split_vec(i);
-        });
-    // communication for FFT in second dimension
-    auto start_first_comm = t_.now();
+    std::size_t index_out;
+    const std::size_t index_in = this_locality_ * dim_c_y_part_ + 2 * k;
+    const std::size_t offset_out = 2 * this_locality_;
+    const std::size_t factor_out = 2 * num_localities_;
+
+    for (std::size_t j = 0; j < n_x_local_; ++j)
+    {
+        // compute index once use twice
+        index_out = factor_out * j + offset_out;
+        // transpose
+        trans_values_vec_(k, index_out) = values_vec_(j, index_in);
+        trans_values_vec_(k, index_out + 1) = values_vec_(j, index_in + 1);
+    }
+}
+
+void hpxfft::fft2D::distributed::loop::transpose_x_to_y_local(const std::size_t j)
+{
+    std::size_t index_in;
+    const std::size_t offset_in = this_locality_ * dim_c_x_part_;
+    const std::size_t index_out = 2 * num_localities_ * j + 2 * this_locality_;
+
+    for (std::size_t k = 0; k < n_x_local_; ++k)
+    {
+        // compute index once use twice
+        index_in = offset_in + 2 * k;
+        // transpose
+        values_vec_(k, index_out) = trans_values_vec_(j, index_in);
+        values_vec_(k, index_out + 1) = trans_values_vec_(j, index_in + 1);
+    }
+}
+
+// start communication
+hpx::future<void> hpxfft::fft2D::distributed::loop::communicate_vec()
+{
+    ++generation_;
     if (COMM_FLAG_ == "scatter")
     {
         for (std::size_t i = 0; i < num_localities_; ++i)
@@ -160,63 +197,18 @@ hpxfft::fft2D::distributed::vector_2d hpxfft::fft2D::distributed::loop::fft_2d_r
             // scatter operation from all localities
             communicate_scatter_vec(i);
         }
-        // global sychronization
-        for (std::size_t i = 0; i < num_localities_; ++i)
-        {
-            communication_vec_[i] = communication_futures_[i].get();
-        }
     }
-    else if (COMM_FLAG_ == "all_to_all")
+    else
     {
         // all to all operation
-        // (implicit) global sychronization
         communicate_all_to_all_vec();
     }
-    else
-    {
-        std::cout << "Communication scheme not specified during initialization\n";
-        hpx::finalize();
-    }
-    auto start_first_trans = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        num_localities_,
-        [&](auto i)
-        {
-            hpx::experimental::for_loop(
-                hpx::execution::par,
-                0,
-                n_y_local_,
-                [&](auto k)
-                {
-                    // transpose from y-direction to x-direction
-                    transpose_y_to_x(k, i);
-                });
-        });
-    // second dimension
-    auto start_second_fft = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        n_y_local_,
-        [&](auto i)
-        {
-            // 1D FFT c2c in x-direction
-            fft_1d_c2c_inplace(i);
-        });
-    auto start_second_split = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        n_y_local_,
-        [&](auto i)
-        {
-            // rearrange for communication step
-            split_trans_vec(i);
-        });
-    // communication to get original data layout
-    auto start_second_comm = t_.now();
+    return collect_communication();
+}
+
+hpx::future<void> hpxfft::fft2D::distributed::loop::communicate_trans_vec()
+{
+    ++generation_;
     if (COMM_FLAG_ == "scatter")
     {
         for (std::size_t i = 0; i < num_localities_; ++i)
@@ -224,51 +216,225 @@ hpxfft::fft2D::distributed::vector_2d hpxfft::fft2D::distributed::loop::fft_2d_r
             // scatter operation from all localities
             communicate_scatter_trans_vec(i);
         }
-        // global synchronization
-        for (std::size_t i = 0; i < num_localities_; ++i)
-        {
-            communication_vec_[i] = communication_futures_[i].get();
-        }
     }
-    else if (COMM_FLAG_ == "all_to_all")
+    else
     {
         // all to all operation
-        // (implicit) global sychronization
         communicate_all_to_all_trans_vec();
     }
-    auto start_second_trans = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        num_localities_,
-        [&](auto i)
-        {
-            hpx::experimental::for_loop(
-                hpx::execution::par,
-                0,
-                n_y_local_,
-                [&](auto j)
+    return collect_communication();
+}
+
+// communication results
+hpx::future<void> hpxfft::fft2D::distributed::loop::collect_communication()
+{
+    if (COMM_FLAG_ == "scatter")
+    {
+        return hpx::when_all(communication_futures_)
+            .then(
+                communication_executor_,
+                [this](hpx::future<std::vector<hpx::future<std::vector<real>>>> r)
                 {
-                    // transpose from x-direction to y-direction
-                    transpose_x_to_y(j, i);
+                    std::vector<hpx::future<std::vector<real>>> received = r.get();
+                    for (std::size_t i = 0; i < num_localities_; ++i)
+                    {
+                        communication_vec_[i] = received[i].get();
+                    }
                 });
-        });
-    auto stop_total = t_.now();
+    }
+    return all_to_all_future_.then(communication_executor_,
+                                   [this](hpx::future<vector_comm> r) { communication_vec_ = r.get(); });
+}
+
+// 2D FFT algorithm
+hpxfft::fft2D::distributed::vector_2d hpxfft::fft2D::distributed::loop::fft_2d_r2c()
+{
+    return fft_2d_r2c_async().get();
+}
 
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
-    measurements_["first_fftw"] = start_first_split - start_total;
-    measurements_["first_split"] = start_first_comm - start_first_split;
-    measurements_["first_comm"] = start_first_trans - start_first_comm;
-    measurements_["first_trans"] = start_second_fft - start_first_trans;
-    measurements_["second_fftw"] = start_second_split - start_second_fft;
-    measurements_["second_split"] = start_second_comm - start_second_split;
-    measurements_["second_comm"] = start_second_trans - start_second_comm;
-    measurements_["second_trans"] = stop_total - start_second_trans;
+hpx::future<hpxfft::fft2D::distributed::vector_2d> hpxfft::fft2D::distributed::loop::fft_2d_r2c_async()
+{
+    if (COMM_FLAG_ != "scatter" && COMM_FLAG_ != "all_to_all")
+    {
+        std::cout << "Communication scheme not specified during initialization\n";
+        hpx::finalize();
+    }
+    // FFTs and transposes run on the compute pool:
+    // loops feeding a collective are critical and run with high priority,
+    // local transposes overlapping with communication are background work on at most
+    // background_task_limit() tasks, so one worker thread stays free for critical work
+    const auto policy = hpx::execution::par(hpx::execution::task).on(compute_executor_);
+    const auto critical_policy = hpx::execution::par(hpx::execution::task)
+                                     .on(hpx::execution::experimental::with_priority(
+                                         compute_executor_, hpx::threads::thread_priority::high));
+    /////////////////////////////////////////////////////////////////
+    // first dimension
+    start_total_ = t_.now();
+    return hpx::experimental::for_loop(critical_policy,
+                                       0,
+                                       n_x_local_,
+                                       [this](auto i)
+                                       {
+                                           // 1d FFT r2c in y-direction
+                                           fft_1d_r2c_inplace(i);
+                                       })
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_first_split_ = t_.now();
+                prepare_communication(values_prep_, n_x_local_ * dim_c_y_part_);
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_x_local_,
+                                                   [this](auto i)
+                                                   {
+                                                       // rearrange for communication step
+                                                       split_vec(i);
+                                                   });
+            })
+        // communication for FFT in second dimension
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_first_comm_ = t_.now();
+                // collectives are started on the communication pool
+                hpx::future<void> received = hpx::async(communication_executor_, &loop::communicate_vec, this);
+                // overlap communication with transpose of the local block
+                return hpx::dataflow(
+                    [](hpx::future<void> received, hpx::future<void> local)
+                    {
+                        received.get();
+                        local.get();
+                    },
+                    std::move(received),
+                    hpxfft::util::background_for_loop(compute_executor_,
+                                                      0,
+                                                      n_y_local_,
+                                                      [this](std::size_t k)
+                                                      {
+                                                          // transpose from y-direction to x-direction
+                                                          transpose_y_to_x_local(k);
+                                                      }));
+            })
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_first_trans_ = t_.now();
+                // one iteration per row and communicated block
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   num_localities_ * n_y_local_,
+                                                   [this](auto index)
+                                                   {
+                                                       const std::size_t i = index / n_y_local_;
+                                                       const std::size_t k = index % n_y_local_;
+                                                       if (i == this_locality_)
+                                                       {
+                                                           return;
+                                                       }
+                                                       // transpose from y-direction to x-direction
+                                                       transpose_y_to_x(k, i);
+                                                   });
+            })
+        // second dimension
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_second_fft_ = t_.now();
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_y_local_,
+                                                   [this](auto i)
+                                                   {
+                                                       // 1D FFT c2c in x-direction
+                                                       fft_1d_c2c_inplace(i);
+                                                   });
+            })
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_second_split_ = t_.now();
+                prepare_communication(trans_values_prep_, n_y_local_ * dim_c_x_part_);
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_y_local_,
+                                                   [this](auto i)
+                                                   {
+                                                       // rearrange for communication step
+                                                       split_trans_vec(i);
+                                                   });
+            })
+        // communication to get original data layout
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_second_comm_ = t_.now();
+                // collectives are started on the communication pool
+                hpx::future<void> received = hpx::async(communication_executor_, &loop::communicate_trans_vec, this);
+                // overlap communication with transpose of the local block
+                return hpx::dataflow(
+                    [](hpx::future<void> received, hpx::future<void> local)
+                    {
+                        received.get();
+                        local.get();
+                    },
+                    std::move(received),
+                    hpxfft::util::background_for_loop(compute_executor_,
+                                                      0,
+                                                      n_y_local_,
+                                                      [this](std::size_t j)
+                                                      {
+                                                          // transpose from x-direction to y-direction
+                                                          transpose_x_to_y_local(j);
+                                                      }));
+            })
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                start_second_trans_ = t_.now();
+                // one iteration per row and communicated block
+                return hpx::experimental::for_loop(policy,
+                                                   0,
+                                                   num_localities_ * n_y_local_,
+                                                   [this](auto index)
+                                                   {
+                                                       const std::size_t i = index / n_y_local_;
+                                                       const std::size_t j = index % n_y_local_;
+                                                       if (i == this_locality_)
+                                                       {
+                                                           return;
+                                                       }
+                                                       // transpose from x-direction to y-direction
+                                                       transpose_x_to_y(j, i);
+                                                   });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_first_split_ - start_total_;
+                measurements_["first_split"] = start_first_comm_ - start_first_split_;
+                measurements_["first_comm"] = start_first_trans_ - start_first_comm_;
+                measurements_["first_trans"] = start_second_fft_ - start_first_trans_;
+                measurements_["second_fftw"] = start_second_split_ - start_second_fft_;
+                measurements_["second_split"] = start_second_comm_ - start_second_split_;
+                measurements_["second_comm"] = start_second_trans_ - start_second_comm_;
+                measurements_["second_trans"] = stop_total - start_second_trans_;
 
-    ////////////////////////////////////////////////////////////////
-    return std::move(values_vec_);
+                ////////////////////////////////////////////////////////////////
+                return std::move(values_vec_);
+            });
 }
 
 // initialization
@@ -290,27 +456,38 @@ void hpxfft::fft2D::distributed::loop::initialize(
     dim_c_x_part_ = 2 * dim_c_x_ / num_localities_;
     // resize other data structures
     trans_values_vec_ = std::move(hpxfft::fft2D::distributed::vector_2d(n_y_local_, 2 * dim_c_x_));
-    values_prep_.resize(num_localities_);
-    trans_values_prep_.resize(num_localities_);
-    for (std::size_t i = 0; i < num_localities_; ++i)
-    {
-        values_prep_[i].resize(n_x_local_ * dim_c_y_part_);
-        trans_values_prep_[i].resize(n_y_local_ * dim_c_x_part_);
-    }
+    PLAN_FLAG_ = PLAN_FLAG;
     // create FFTW plans
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
     // r2c in y-direction
-    fft_r2c_adapter_ = hpxfft::util::fftw_adapter::r2c_1d();
-    fft_r2c_adapter_.plan(
-        dim_r_y_, PLAN_FLAG, trans_values_vec_.row(0), reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)));
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          1,
+                          r2c_aligned);
     // c2c in x-direction
-    fft_c2c_adapter_ = hpxfft::util::fftw_adapter::c2c_1d();
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
     fft_c2c_adapter_.plan(dim_c_x_,
                           PLAN_FLAG,
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
-                          hpxfft::util::fftw_adapter::direction::forward);
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          1,
+                          c2c_aligned);
+    // thread pools
+    // collectives are on the critical path
+    communication_executor_ = hpx::execution::experimental::with_priority(hpxfft::util::communication_executor(),
+                                                                          hpx::threads::thread_priority::high);
+    compute_executor_ = hpxfft::util::compute_executor();
     // communication specific initialization
     COMM_FLAG_ = COMM_FLAG;
+    generation_ = 0;
     if (COMM_FLAG_ == "scatter")
     {
         communication_vec_.resize(num_localities_);
@@ -346,5 +523,24 @@ void hpxfft::fft2D::distributed::loop::initialize(
     }
 }
 
+void hpxfft::fft2D::distributed::loop::set_values(vector_2d values_vec)
+{
+    if (values_vec.n_row() != n_x_local_ || values_vec.n_col() != 2 * dim_c_y_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    values_vec_ = std::move(values_vec);
+    // a buffer of another alignment than the planned one needs an unaligned r2c plan
+    if (!fft_r2c_adapter_.accepts(values_vec_.row(0), values_vec_.n_col()))
+    {
+        fft_r2c_adapter_.plan(dim_r_y_,
+                              PLAN_FLAG_,
+                              trans_values_vec_.row(0),
+                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                              1,
+                              false);
+    }
+}
+
 // helpers
 real hpxfft::fft2D::distributed::loop::get_measurement(std::string name) { return measurements_[name]; }
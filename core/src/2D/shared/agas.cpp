@@ -43,46 +43,44 @@ void hpxfft::fft2D::shared::agas_server::transpose_shared_x_to_y(const std::size
     }
 }
 
-// 2D FFT algorithm
-hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::agas_server::fft_2d_r2c()
+// task graph
+void hpxfft::fft2D::shared::agas_server::build_task_graph()
 {
+    task_graph_.clear();
+    // global synchronization
+    std::size_t all_r2c = task_graph_.add_node({});
     // first dimension
     for (std::size_t i = 0; i < dim_c_x_; ++i)
     {
         // 1d FFT r2c in y-direction
-        r2c_futures_[i] = hpx::async(fft_1d_r2c_inplace_action(), get_id(), i);
+        std::size_t r2c = task_graph_.add_node([this, i] { fft_1d_r2c_inplace(i); });
+        task_graph_.add_edge(r2c, all_r2c);
     }
-    // global synchronization
-    hpx::shared_future<vector_future> all_r2c_futures = hpx::when_all(r2c_futures_);
     for (std::size_t i = 0; i < dim_c_y_; ++i)
     {
         // transpose from y-direction to x-direction
-        trans_y_to_x_futures_[i] = all_r2c_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
-            {
-                r.get();
-                return hpx::async(transpose_shared_y_to_x_action(), get_id(), i);
-            });
+        std::size_t trans_y_to_x = task_graph_.add_node([this, i] { transpose_shared_y_to_x(i); });
+        task_graph_.add_edge(all_r2c, trans_y_to_x);
         // second dimension
         // 1D FFT in x-direction
-        c2c_futures_[i] = trans_y_to_x_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(fft_1d_c2c_inplace_action(), get_id(), i);
-            });
+        std::size_t c2c = task_graph_.add_node([this, i] { fft_1d_c2c_inplace(i); });
+        task_graph_.add_edge(trans_y_to_x, c2c);
         // transpose from x-direction to y-direction
-        trans_x_to_y_futures_[i] = c2c_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(transpose_shared_x_to_y_action(), get_id(), i);
-            });
+        std::size_t trans_x_to_y = task_graph_.add_node([this, i] { transpose_shared_x_to_y(i); });
+        task_graph_.add_edge(c2c, trans_x_to_y);
     }
-    // global synchronization
-    hpx::wait_all(trans_x_to_y_futures_);
+}
 
-    return std::move(values_vec_);
+// 2D FFT algorithm
+hpx::future<hpxfft::fft2D::shared::vector_2d> hpxfft::fft2D::shared::agas_server::fft_2d_r2c()
+{
+    // replay prebuilt task graph
+    return task_graph_.run_async().then(
+        [this](hpx::future<void> r)
+        {
+            r.get();
+            return std::move(values_vec_);
+        });
 }
 
 // initialization
@@ -97,20 +95,28 @@ void hpxfft::fft2D::shared::agas_server::initialize(hpxfft::fft2D::shared::vecto
     // resize transposed data structure
     trans_values_vec_ = std::move(hpxfft::fft2D::shared::vector_2d(dim_c_y_, 2 * dim_c_x_));
     // create FFTW plans
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
     // r2c in y-direction
-    fft_r2c_adapter_ = hpxfft::util::fftw_adapter::r2c_1d();
-    fft_r2c_adapter_.plan(
-        dim_r_y_, PLAN_FLAG, trans_values_vec_.row(0), reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)));
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          1,
+                          r2c_aligned);
     // c2c in x-direction
-    fft_c2c_adapter_ = hpxfft::util::fftw_adapter::c2c_1d();
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
     fft_c2c_adapter_.plan(dim_c_x_,
                           PLAN_FLAG,
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
-                          hpxfft::util::fftw_adapter::direction::forward);
-    // resize futures
-    r2c_futures_.resize(dim_c_x_);
-    trans_y_to_x_futures_.resize(dim_c_x_);
-    c2c_futures_.resize(dim_c_y_);
-    trans_x_to_y_futures_.resize(dim_c_y_);
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          1,
+                          c2c_aligned);
+    // dependency structure of the transform
+    build_task_graph();
 }
@@ -1,6 +1,9 @@
 #include "../../../include/hpxfft/2D/shared/loop.hpp"
 
+#include "../../../include/hpxfft/util/thread_pools.hpp"
+#include <algorithm>
 #include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/runtime.hpp>
 
 // FFT backend
 void hpxfft::fft2D::shared::loop::fft_1d_r2c_inplace(const std::size_t i)
@@ -52,64 +55,157 @@ void hpxfft::fft2D::shared::loop::transpose_shared_x_to_y(const std::size_t inde
     }
 }
 
-// 2D FFT algorithm
-hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::loop::fft_2d_r2c_par()
+// transpose of a block of rows with write running index inside the block
+void hpxfft::fft2D::shared::loop::transpose_y_to_x_rows(const std::size_t begin, const std::size_t end)
 {
-    /////////////////////////////////////////////////////////////////
-    // first dimension
-    auto start_total = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_x_,
-        [&](auto i)
-        {
-            // 1d FFT r2c in y-direction
-            fft_1d_r2c_inplace(i);
-        });
-    auto start_first_trans = t_.now();
-    // hpx::experimental::for_loop(hpx::execution::par, 0, dim_c_x_, [&](auto i) for other transpose
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_y_,
-        [&](auto i)
+    for (std::size_t index = 0; index < dim_c_y_; ++index)
+    {
+        for (std::size_t index_trans = begin; index_trans < end; ++index_trans)
         {
-            // transpose from y-direction to x-direction
-            transpose_shared_y_to_x(i);
-        });
-    // second dimension
-    auto start_second_fft = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_y_,
-        [&](auto i)
+            trans_values_vec_(index, 2 * index_trans) = values_vec_(index_trans, 2 * index);
+            trans_values_vec_(index, 2 * index_trans + 1) = values_vec_(index_trans, 2 * index + 1);
+        }
+    }
+}
+
+// worker affinity
+hpx::future<void> hpxfft::fft2D::shared::loop::for_each_worker_block(
+    const std::size_t n, const std::function<void(std::size_t, std::size_t)> &f)
+{
+    const std::size_t n_workers = hpxfft::util::compute_thread_count();
+    std::vector<hpx::future<void>> blocks;
+    blocks.reserve(n_workers);
+    for (std::size_t worker = 0; worker < n_workers; ++worker)
+    {
+        const std::size_t begin = worker * n / n_workers;
+        const std::size_t end = (worker + 1) * n / n_workers;
+        if (begin < end)
         {
-            // 1D FFT c2c in x-direction
-            fft_1d_c2c_inplace(i);
-        });
-    auto start_second_trans = t_.now();
-    // hpx::experimental::for_loop(hpx::execution::par, 0, dim_c_x_, [&](auto i) for other transpose
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_y_,
-        [&](auto i)
+            blocks.push_back(hpx::async(hpxfft::util::worker_executor(worker), f, begin, end));
+        }
+    }
+    return hpx::when_all(blocks).then(
+        [](hpx::future<std::vector<hpx::future<void>>> r)
         {
-            // transpose from x-direction to y-direction
-            transpose_shared_x_to_y(i);
+            for (hpx::future<void> &block : r.get())
+            {
+                // rethrow exceptions
+                block.get();
+            }
         });
-    auto stop_total = t_.now();
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
-    measurements_["first_fftw"] = start_first_trans - start_total;
-    measurements_["first_trans"] = start_second_fft - start_first_trans;
-    measurements_["second_fftw"] = start_second_trans - start_second_fft;
-    measurements_["second_trans"] = stop_total - start_second_trans;
+}
 
-    return std::move(values_vec_);
+// threads of one multi-threaded FFT when only n_rows rows run in parallel
+std::size_t hpxfft::fft2D::shared::loop::threads_per_row(const std::size_t n_rows, const std::size_t n_threads)
+{
+    return n_rows < n_threads ? n_threads / std::max(n_rows, std::size_t(1)) : 1;
+}
+
+// chunking
+const hpxfft::util::chunk_param &hpxfft::fft2D::shared::loop::chunk_param_of(
+    const hpxfft::util::chunk_param &param, const hpxfft::util::chunk_tuner &tuner) const
+{
+    return param.policy == hpxfft::util::chunk_policy::tune ? tuner.current() : param;
+}
+
+void hpxfft::fft2D::shared::loop::record_chunk_runtimes()
+{
+    // tuned phases advance to the next candidate until the best one is locked
+    if (chunking_.first_fftw.policy == hpxfft::util::chunk_policy::tune)
+    {
+        first_fftw_tuner_.record(measurements_["first_fftw"]);
+    }
+    if (chunking_.first_trans.policy == hpxfft::util::chunk_policy::tune)
+    {
+        first_trans_tuner_.record(measurements_["first_trans"]);
+    }
+    if (chunking_.second_fftw.policy == hpxfft::util::chunk_policy::tune)
+    {
+        second_fftw_tuner_.record(measurements_["second_fftw"]);
+    }
+    if (chunking_.second_trans.policy == hpxfft::util::chunk_policy::tune)
+    {
+        second_trans_tuner_.record(measurements_["second_trans"]);
+    }
+}
+
+// 2D FFT algorithm
+hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::loop::fft_2d_r2c_par() { return fft_2d_r2c_async().get(); }
+
+hpx::future<hpxfft::fft2D::shared::vector_2d> hpxfft::fft2D::shared::loop::fft_2d_r2c_async()
+{
+    /////////////////////////////////////////////////////////////////
+    // first dimension
+    start_total_ = t_.now();
+    return hpxfft::util::for_loop_chunked_async(chunk_param_of(chunking_.first_fftw, first_fftw_tuner_),
+                                                0,
+                                                dim_c_x_,
+                                                [this](auto i)
+                                                {
+                                                    // 1d FFT r2c in y-direction
+                                                    fft_1d_r2c_inplace(i);
+                                                })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_first_trans_ = t_.now();
+                return hpxfft::util::for_loop_chunked_async(
+                    chunk_param_of(chunking_.first_trans, first_trans_tuner_),
+                    0,
+                    dim_c_y_,
+                    [this](auto i)
+                    {
+                        // transpose from y-direction to x-direction
+                        transpose_shared_y_to_x(i);
+                    });
+            })
+        // second dimension
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_second_fft_ = t_.now();
+                return hpxfft::util::for_loop_chunked_async(chunk_param_of(chunking_.second_fftw, second_fftw_tuner_),
+                                                            0,
+                                                            dim_c_y_,
+                                                            [this](auto i)
+                                                            {
+                                                                // 1D FFT c2c in x-direction
+                                                                fft_1d_c2c_inplace(i);
+                                                            });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_second_trans_ = t_.now();
+                return hpxfft::util::for_loop_chunked_async(
+                    chunk_param_of(chunking_.second_trans, second_trans_tuner_),
+                    0,
+                    dim_c_y_,
+                    [this](auto i)
+                    {
+                        // transpose from x-direction to y-direction
+                        transpose_shared_x_to_y(i);
+                    });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_first_trans_ - start_total_;
+                measurements_["first_trans"] = start_second_fft_ - start_first_trans_;
+                measurements_["second_fftw"] = start_second_trans_ - start_second_fft_;
+                measurements_["second_trans"] = stop_total - start_second_trans_;
+                record_chunk_runtimes();
+
+                return std::move(values_vec_);
+            });
 }
 
 hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::loop::fft_2d_r2c_seq()
@@ -154,8 +250,90 @@ hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::loop::fft_2d_r2c_seq()
     return std::move(values_vec_);
 }
 
+hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::loop::fft_2d_r2c_affinity()
+{
+    return fft_2d_r2c_affinity_async().get();
+}
+
+hpx::future<hpxfft::fft2D::shared::vector_2d> hpxfft::fft2D::shared::loop::fft_2d_r2c_affinity_async()
+{
+    /////////////////////////////////////////////////////////////////
+    // first dimension
+    start_total_ = t_.now();
+    return for_each_worker_block(dim_c_x_,
+                                 [this](std::size_t begin, std::size_t end)
+                                 {
+                                     for (std::size_t i = begin; i < end; ++i)
+                                     {
+                                         // 1d FFT r2c in y-direction
+                                         fft_1d_r2c_inplace(i);
+                                     }
+                                 })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_first_trans_ = t_.now();
+                // same row blocks: each worker reads the rows it just transformed
+                return for_each_worker_block(dim_c_x_,
+                                             [this](std::size_t begin, std::size_t end)
+                                             {
+                                                 // transpose from y-direction to x-direction
+                                                 transpose_y_to_x_rows(begin, end);
+                                             });
+            })
+        // second dimension
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_second_fft_ = t_.now();
+                return for_each_worker_block(dim_c_y_,
+                                             [this](std::size_t begin, std::size_t end)
+                                             {
+                                                 for (std::size_t i = begin; i < end; ++i)
+                                                 {
+                                                     // 1d FFT c2c in x-direction
+                                                     fft_1d_c2c_inplace(i);
+                                                 }
+                                             });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_second_trans_ = t_.now();
+                return for_each_worker_block(dim_c_y_,
+                                             [this](std::size_t begin, std::size_t end)
+                                             {
+                                                 for (std::size_t i = begin; i < end; ++i)
+                                                 {
+                                                     // transpose from x-direction to y-direction
+                                                     transpose_shared_x_to_y(i);
+                                                 }
+                                             });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_first_trans_ - start_total_;
+                measurements_["first_trans"] = start_second_fft_ - start_first_trans_;
+                measurements_["second_fftw"] = start_second_trans_ - start_second_fft_;
+                measurements_["second_trans"] = stop_total - start_second_trans_;
+
+                return std::move(values_vec_);
+            });
+}
+
 // initialization
-void hpxfft::fft2D::shared::loop::initialize(vector_2d values_vec, const std::string PLAN_FLAG)
+void hpxfft::fft2D::shared::loop::initialize(vector_2d values_vec,
+                                             const std::string PLAN_FLAG,
+                                             const hpxfft::fft2D::shared::loop_chunking &CHUNKING)
 {
     // move data into own data structure
     values_vec_ = std::move(values_vec);
@@ -165,19 +343,43 @@ void hpxfft::fft2D::shared::loop::initialize(vector_2d values_vec, const std::st
     dim_r_y_ = 2 * dim_c_y_ - 2;
     // resize transposed data structure
     trans_values_vec_ = std::move(vector_2d(dim_c_y_, 2 * dim_c_x_));
+    // row-parallel or intra-row-parallel execution:
+    // with fewer rows than threads, each FFT itself runs on the remaining threads
+    const std::size_t n_threads = hpx::get_num_worker_threads();
+    // native kernels are single-threaded
+    const bool fftw_threads =
+        hpxfft::util::fft_backend::string_to_backend(PLAN_FLAG) == hpxfft::util::fft_backend::backend::fftw &&
+        hpxfft::util::fftw_adapter::init_threads();
+    const int r2c_threads = fftw_threads ? static_cast<int>(threads_per_row(dim_c_x_, n_threads)) : 1;
+    const int c2c_threads = fftw_threads ? static_cast<int>(threads_per_row(dim_c_y_, n_threads)) : 1;
+    measurements_["first_fftw_threads"] = r2c_threads;
+    measurements_["second_fftw_threads"] = c2c_threads;
+    PLAN_FLAG_ = PLAN_FLAG;
+    r2c_threads_ = r2c_threads;
     // create FFTW plans
     auto start_plan = t_.now();
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
     // r2c in y-direction
-    fft_r2c_adapter_ = hpxfft::util::fftw_adapter::r2c_1d();
-    fft_r2c_adapter_.plan(
-        dim_r_y_, PLAN_FLAG, trans_values_vec_.row(0), reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)));
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          r2c_threads,
+                          r2c_aligned);
     // c2c in x-direction
-    fft_c2c_adapter_ = hpxfft::util::fftw_adapter::c2c_1d();
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
     fft_c2c_adapter_.plan(dim_c_x_,
                           PLAN_FLAG,
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
-                          hpxfft::util::fftw_adapter::direction::forward);
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          c2c_threads,
+                          c2c_aligned);
     auto stop_plan = t_.now();
     measurements_["plan"] = stop_plan - start_plan;
     // compute overall plan flops
@@ -186,6 +388,31 @@ void hpxfft::fft2D::shared::loop::initialize(vector_2d values_vec, const std::st
     double add_c2c, mul_c2c, fma_c2c;
     fft_c2c_adapter_.flops(&add_c2c, &mul_c2c, &fma_c2c);
     measurements_["plan_flops"] = dim_r_y_ * (add_r2c + mul_r2c + fma_r2c) + dim_c_x_ * (add_c2c + mul_c2c + fma_c2c);
+    // chunking of the parallel phases
+    chunking_ = CHUNKING;
+    first_fftw_tuner_.initialize(dim_c_x_, n_threads);
+    first_trans_tuner_.initialize(dim_c_y_, n_threads);
+    second_fftw_tuner_.initialize(dim_c_y_, n_threads);
+    second_trans_tuner_.initialize(dim_c_y_, n_threads);
+}
+
+void hpxfft::fft2D::shared::loop::set_values(vector_2d values_vec)
+{
+    if (values_vec.n_row() != dim_c_x_ || values_vec.n_col() != 2 * dim_c_y_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    values_vec_ = std::move(values_vec);
+    // a buffer of another alignment than the planned one needs an unaligned r2c plan
+    if (!fft_r2c_adapter_.accepts(values_vec_.row(0), values_vec_.n_col()))
+    {
+        fft_r2c_adapter_.plan(dim_r_y_,
+                              PLAN_FLAG_,
+                              trans_values_vec_.row(0),
+                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                              r2c_threads_,
+                              false);
+    }
 }
 
 // helpers
@@ -1,5 +1,8 @@
 #include "../../../include/hpxfft/2D/shared/naive.hpp"
 
+#include "../../../include/hpxfft/util/thread_pools.hpp"
+#include <stdexcept>
+
 // FFT backend
 void hpxfft::fft2D::shared::naive::fft_1d_r2c_inplace(const std::size_t i)
 {
@@ -31,66 +34,58 @@ void hpxfft::fft2D::shared::naive::transpose_shared_x_to_y(const std::size_t ind
     }
 }
 
-// wrappers
-void hpxfft::fft2D::shared::naive::fft_1d_r2c_inplace_wrapper(naive *th, const std::size_t i) { th->fft_1d_r2c_inplace(i); }
-
-void hpxfft::fft2D::shared::naive::fft_1d_c2c_inplace_wrapper(naive *th, const std::size_t i) { th->fft_1d_c2c_inplace(i); }
-
-void hpxfft::fft2D::shared::naive::transpose_shared_y_to_x_wrapper(naive *th, const std::size_t index_trans)
-{
-    th->transpose_shared_y_to_x(index_trans);
-}
-
-void hpxfft::fft2D::shared::naive::transpose_shared_x_to_y_wrapper(naive *th, const std::size_t index_trans)
-{
-    th->transpose_shared_x_to_y(index_trans);
-}
-
-// 2D FFT algorithm
-hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::naive::fft_2d_r2c()
+// task graph
+void hpxfft::fft2D::shared::naive::build_task_graph()
 {
-    auto start_total = t_.now();
+    task_graph_.clear();
+    // background tasks may not occupy all threads while critical tasks are pending
+    task_graph_.set_background_limit(hpxfft::util::background_task_limit());
+    // global synchronization between the dimensions
+    std::size_t all_trans_y_to_x = task_graph_.add_node({});
     // first dimension
+    // critical path: every column FFT waits for all of these tasks
     for (std::size_t i = 0; i < dim_c_x_; ++i)
     {
         // 1d FFT r2c in y-direction
-        r2c_futures_[i] = hpx::async(&fft_1d_r2c_inplace_wrapper, this, i);
+        std::size_t r2c = task_graph_.add_node([this, i] { fft_1d_r2c_inplace(i); });
+        task_graph_.set_priority(r2c, hpx::threads::thread_priority::high);
         // transpose from y-direction to x-direction
-        trans_y_to_x_futures_[i] = r2c_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(&hpxfft::fft2D::shared::naive::transpose_shared_y_to_x_wrapper, this, i);
-            });
+        std::size_t trans_y_to_x = task_graph_.add_node([this, i] { transpose_shared_y_to_x(i); });
+        task_graph_.set_priority(trans_y_to_x, hpx::threads::thread_priority::high);
+        task_graph_.add_edge(r2c, trans_y_to_x);
+        task_graph_.add_edge(trans_y_to_x, all_trans_y_to_x);
     }
-    hpx::shared_future<vector_future> all_trans_y_to_x_futures = hpx::when_all(trans_y_to_x_futures_);
+    task_graph_.set_priority(all_trans_y_to_x, hpx::threads::thread_priority::high);
     // second dimension
     for (std::size_t i = 0; i < dim_c_y_; ++i)
     {
         // 1D FFT in x-direction
-        c2c_futures_[i] = all_trans_y_to_x_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
-            {
-                r.get();
-                return hpx::async(&fft_1d_c2c_inplace_wrapper, this, i);
-            });
+        std::size_t c2c = task_graph_.add_node([this, i] { fft_1d_c2c_inplace(i); });
+        task_graph_.add_edge(all_trans_y_to_x, c2c);
         // transpose from x-direction to y-direction
-        trans_x_to_y_futures_[i] = c2c_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(&hpxfft::fft2D::shared::naive::transpose_shared_x_to_y_wrapper, this, i);
-            });
+        std::size_t trans_x_to_y = task_graph_.add_node([this, i] { transpose_shared_x_to_y(i); });
+        task_graph_.add_edge(c2c, trans_x_to_y);
     }
-    hpx::shared_future<vector_future> all_trans_x_to_y_futures = hpx::when_all(trans_x_to_y_futures_);
-    // global synchronization step
-    all_trans_x_to_y_futures.get();
-    auto stop_total = t_.now();
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
+}
+
+// 2D FFT algorithm
+hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::naive::fft_2d_r2c() { return fft_2d_r2c_async().get(); }
 
-    return std::move(values_vec_);
+hpx::future<hpxfft::fft2D::shared::vector_2d> hpxfft::fft2D::shared::naive::fft_2d_r2c_async()
+{
+    auto start_total = t_.now();
+    // replay prebuilt task graph
+    return task_graph_.run_async().then(
+        [this, start_total](hpx::future<void> r)
+        {
+            r.get();
+            auto stop_total = t_.now();
+            ////////////////////////////////////////////////////////////////
+            // additional runtimes
+            measurements_["total"] = stop_total - start_total;
+
+            return std::move(values_vec_);
+        });
 }
 
 // initialization
@@ -104,23 +99,51 @@ void hpxfft::fft2D::shared::naive::initialize(hpxfft::fft2D::shared::vector_2d v
     dim_r_y_ = 2 * dim_c_y_ - 2;
     // resize transposed data structure
     trans_values_vec_ = std::move(hpxfft::fft2D::shared::vector_2d(dim_c_y_, 2 * dim_c_x_));
+    PLAN_FLAG_ = PLAN_FLAG;
     // create FFTW plans
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
     // r2c in y-direction
-    fft_r2c_adapter_ = hpxfft::util::fftw_adapter::r2c_1d();
-    fft_r2c_adapter_.plan(
-        dim_r_y_, PLAN_FLAG, trans_values_vec_.row(0), reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)));
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          1,
+                          r2c_aligned);
     // c2c in x-direction
-    fft_c2c_adapter_ = hpxfft::util::fftw_adapter::c2c_1d();
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
     fft_c2c_adapter_.plan(dim_c_x_,
                           PLAN_FLAG,
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
-                          hpxfft::util::fftw_adapter::direction::forward);
-    // resize futures
-    r2c_futures_.resize(dim_c_x_);
-    trans_y_to_x_futures_.resize(dim_c_x_);
-    c2c_futures_.resize(dim_c_y_);
-    trans_x_to_y_futures_.resize(dim_c_y_);
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          1,
+                          c2c_aligned);
+    // dependency structure of the transform
+    build_task_graph();
+}
+
+void hpxfft::fft2D::shared::naive::set_values(vector_2d values_vec)
+{
+    if (values_vec.n_row() != dim_c_x_ || values_vec.n_col() != 2 * dim_c_y_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    values_vec_ = std::move(values_vec);
+    // a buffer of another alignment than the planned one needs an unaligned r2c plan
+    if (!fft_r2c_adapter_.accepts(values_vec_.row(0), values_vec_.n_col()))
+    {
+        fft_r2c_adapter_.plan(dim_r_y_,
+                              PLAN_FLAG_,
+                              trans_values_vec_.row(0),
+                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                              1,
+                              false);
+    }
 }
 
 // helpers
@@ -1,5 +1,9 @@
 #include "../../../include/hpxfft/2D/shared/opt.hpp"
 
+#include "../../../include/hpxfft/util/thread_pools.hpp"
+#include <algorithm>
+#include <stdexcept>
+
 // FFT backend
 void hpxfft::fft2D::shared::opt::fft_1d_r2c_inplace(const std::size_t i)
 {
@@ -12,13 +16,38 @@ void hpxfft::fft2D::shared::opt::fft_1d_c2c_inplace(const std::size_t i)
                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(i)));
 }
 
-// transpose with write running index
-void hpxfft::fft2D::shared::opt::transpose_shared_y_to_x(const std::size_t index)
+// blocked FFT backend
+void hpxfft::fft2D::shared::opt::fft_1d_r2c_block(const std::size_t tile_x)
+{
+    const std::size_t end = std::min((tile_x + 1) * dim_tile_, dim_c_x_);
+    for (std::size_t i = tile_x * dim_tile_; i < end; ++i)
+    {
+        fft_1d_r2c_inplace(i);
+    }
+}
+
+void hpxfft::fft2D::shared::opt::fft_1d_c2c_block(const std::size_t tile_y)
+{
+    const std::size_t end = std::min((tile_y + 1) * dim_tile_, dim_c_y_);
+    for (std::size_t i = tile_y * dim_tile_; i < end; ++i)
+    {
+        fft_1d_c2c_inplace(i);
+    }
+}
+
+// transpose of a single tile with write running index
+void hpxfft::fft2D::shared::opt::transpose_tile_y_to_x(const std::size_t tile_x, const std::size_t tile_y)
 {
-    for (std::size_t index_trans = 0; index_trans < dim_c_x_; ++index_trans)
+    const std::size_t begin_trans = tile_x * dim_tile_;
+    const std::size_t end_trans = std::min(begin_trans + dim_tile_, dim_c_x_);
+    const std::size_t end = std::min((tile_y + 1) * dim_tile_, dim_c_y_);
+    for (std::size_t index = tile_y * dim_tile_; index < end; ++index)
     {
-        trans_values_vec_(index, 2 * index_trans) = values_vec_(index_trans, 2 * index);
-        trans_values_vec_(index, 2 * index_trans + 1) = values_vec_(index_trans, 2 * index + 1);
+        for (std::size_t index_trans = begin_trans; index_trans < end_trans; ++index_trans)
+        {
+            trans_values_vec_(index, 2 * index_trans) = values_vec_(index_trans, 2 * index);
+            trans_values_vec_(index, 2 * index_trans + 1) = values_vec_(index_trans, 2 * index + 1);
+        }
     }
 }
 
@@ -32,71 +61,75 @@ void hpxfft::fft2D::shared::opt::transpose_shared_x_to_y(const std::size_t index
     }
 }
 
-// wrappers
-void hpxfft::fft2D::shared::opt::fft_1d_r2c_inplace_wrapper(opt *th, const std::size_t i) { th->fft_1d_r2c_inplace(i); }
-
-void hpxfft::fft2D::shared::opt::fft_1d_c2c_inplace_wrapper(opt *th, const std::size_t i) { th->fft_1d_c2c_inplace(i); }
-
-void hpxfft::fft2D::shared::opt::transpose_shared_y_to_x_wrapper(opt *th, const std::size_t index)
+void hpxfft::fft2D::shared::opt::transpose_block_x_to_y(const std::size_t tile_y)
 {
-    th->transpose_shared_y_to_x(index);
-}
-
-void hpxfft::fft2D::shared::opt::transpose_shared_x_to_y_wrapper(opt *th, const std::size_t index_trans)
-{
-    th->transpose_shared_x_to_y(index_trans);
+    const std::size_t end = std::min((tile_y + 1) * dim_tile_, dim_c_y_);
+    for (std::size_t i = tile_y * dim_tile_; i < end; ++i)
+    {
+        transpose_shared_x_to_y(i);
+    }
 }
 
-// 2D FFT algorithm
-hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::opt::fft_2d_r2c()
+// task graph
+void hpxfft::fft2D::shared::opt::build_task_graph()
 {
-    auto start_total = t_.now();
+    task_graph_.clear();
+    // background tasks may not occupy all threads while critical tasks are pending
+    task_graph_.set_background_limit(hpxfft::util::background_task_limit());
     // first dimension
-    for (std::size_t i = 0; i < dim_c_x_; ++i)
+    // critical path: row blocks and tiles feed the column blocks
+    std::vector<std::size_t> r2c(n_tile_x_);
+    for (std::size_t tile_x = 0; tile_x < n_tile_x_; ++tile_x)
     {
-        // 1d FFT r2c in y-direction
-        r2c_futures_[i] = hpx::async(&fft_1d_r2c_inplace_wrapper, this, i);
+        // 1d FFT r2c in y-direction for a block of rows
+        r2c[tile_x] = task_graph_.add_node([this, tile_x] { fft_1d_r2c_block(tile_x); });
+        task_graph_.set_priority(r2c[tile_x], hpx::threads::thread_priority::high);
     }
-    // global synchronization
-    hpx::shared_future<vector_future> all_r2c_futures = hpx::when_all(r2c_futures_);
-    for (std::size_t i = 0; i < dim_c_y_; ++i)
+    for (std::size_t tile_y = 0; tile_y < n_tile_y_; ++tile_y)
     {
-        // transpose from y-direction to x-direction
-        trans_y_to_x_futures_[i] = all_r2c_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
-            {
-                r.get();
-                return hpx::async(&hpxfft::fft2D::shared::opt::transpose_shared_y_to_x_wrapper, this, i);
-            });
         // second dimension
-        // 1D FFT in x-direction
-        c2c_futures_[i] = trans_y_to_x_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(&fft_1d_c2c_inplace_wrapper, this, i);
-            });
-        // transpose from x-direction to y-direction
-        trans_x_to_y_futures_[i] = c2c_futures_[i].then(
-            [=, this](hpx::future<void> r)
-            {
-                r.get();
-                return hpx::async(&hpxfft::fft2D::shared::opt::transpose_shared_x_to_y_wrapper, this, i);
-            });
+        // 1D FFT in x-direction once all tiles of the column block are in place
+        std::size_t c2c = task_graph_.add_node([this, tile_y] { fft_1d_c2c_block(tile_y); });
+        for (std::size_t tile_x = 0; tile_x < n_tile_x_; ++tile_x)
+        {
+            // transpose from y-direction to x-direction:
+            // each tile only waits for the row block it is built from
+            std::size_t trans_y_to_x =
+                task_graph_.add_node([this, tile_x, tile_y] { transpose_tile_y_to_x(tile_x, tile_y); });
+            task_graph_.set_priority(trans_y_to_x, hpx::threads::thread_priority::high);
+            task_graph_.add_edge(r2c[tile_x], trans_y_to_x);
+            task_graph_.add_edge(trans_y_to_x, c2c);
+        }
+        // transpose from x-direction to y-direction, background task
+        std::size_t trans_x_to_y = task_graph_.add_node([this, tile_y] { transpose_block_x_to_y(tile_y); });
+        task_graph_.add_edge(c2c, trans_x_to_y);
     }
-    hpx::shared_future<vector_future> all_trans_x_to_y_futures = hpx::when_all(trans_x_to_y_futures_);
-    // global synchronization step
-    all_trans_x_to_y_futures.get();
-    auto stop_total = t_.now();
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
+}
+
+// 2D FFT algorithm
+hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::opt::fft_2d_r2c() { return fft_2d_r2c_async().get(); }
 
-    return std::move(values_vec_);
+hpx::future<hpxfft::fft2D::shared::vector_2d> hpxfft::fft2D::shared::opt::fft_2d_r2c_async()
+{
+    auto start_total = t_.now();
+    // replay prebuilt task graph
+    return task_graph_.run_async().then(
+        [this, start_total](hpx::future<void> r)
+        {
+            r.get();
+            auto stop_total = t_.now();
+            ////////////////////////////////////////////////////////////////
+            // additional runtimes
+            measurements_["total"] = stop_total - start_total;
+
+            return std::move(values_vec_);
+        });
 }
 
 // initialization
-void hpxfft::fft2D::shared::opt::initialize(hpxfft::fft2D::shared::vector_2d values_vec, const std::string PLAN_FLAG)
+void hpxfft::fft2D::shared::opt::initialize(hpxfft::fft2D::shared::vector_2d values_vec,
+                                            const std::string PLAN_FLAG,
+                                            const std::size_t TILE_DIM)
 {
     // move data into own data structure
     values_vec_ = std::move(values_vec);
@@ -104,25 +137,57 @@ void hpxfft::fft2D::shared::opt::initialize(hpxfft::fft2D::shared::vector_2d val
     dim_c_x_ = values_vec_.n_row();
     dim_c_y_ = values_vec_.n_col() / 2;
     dim_r_y_ = 2 * dim_c_y_ - 2;
+    // tiling
+    dim_tile_ = std::max(TILE_DIM, std::size_t(1));
+    n_tile_x_ = (dim_c_x_ + dim_tile_ - 1) / dim_tile_;
+    n_tile_y_ = (dim_c_y_ + dim_tile_ - 1) / dim_tile_;
     // resize transposed data structure
     trans_values_vec_ = std::move(hpxfft::fft2D::shared::vector_2d(dim_c_y_, 2 * dim_c_x_));
+    PLAN_FLAG_ = PLAN_FLAG;
     // create FFTW plans
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
     // r2c in y-direction
-    fft_r2c_adapter_ = hpxfft::util::fftw_adapter::r2c_1d();
-    fft_r2c_adapter_.plan(
-        dim_r_y_, PLAN_FLAG, trans_values_vec_.row(0), reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)));
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          1,
+                          r2c_aligned);
     // c2c in x-direction
-    fft_c2c_adapter_ = hpxfft::util::fftw_adapter::c2c_1d();
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
     fft_c2c_adapter_.plan(dim_c_x_,
                           PLAN_FLAG,
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
-                          hpxfft::util::fftw_adapter::direction::forward);
-    // resize futures
-    r2c_futures_.resize(dim_c_x_);
-    trans_y_to_x_futures_.resize(dim_c_x_);
-    c2c_futures_.resize(dim_c_y_);
-    trans_x_to_y_futures_.resize(dim_c_y_);
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          1,
+                          c2c_aligned);
+    // dependency structure of the transform
+    build_task_graph();
+}
+
+void hpxfft::fft2D::shared::opt::set_values(vector_2d values_vec)
+{
+    if (values_vec.n_row() != dim_c_x_ || values_vec.n_col() != 2 * dim_c_y_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    values_vec_ = std::move(values_vec);
+    // a buffer of another alignment than the planned one needs an unaligned r2c plan
+    if (!fft_r2c_adapter_.accepts(values_vec_.row(0), values_vec_.n_col()))
+    {
+        fft_r2c_adapter_.plan(dim_r_y_,
+                              PLAN_FLAG_,
+                              trans_values_vec_.row(0),
+                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                              1,
+                              false);
+    }
 }
 
 // helpers
@@ -0,0 +1,117 @@
+#include "../../../include/hpxfft/2D/shared/sender.hpp"
+
+#include <stdexcept>
+
+// FFT backend
+void hpxfft::fft2D::shared::sender::fft_1d_r2c_inplace(const std::size_t i)
+{
+    fft_r2c_adapter_.execute(values_vec_.row(i), reinterpret_cast<fftw_complex *>(values_vec_.row(i)));
+}
+
+void hpxfft::fft2D::shared::sender::fft_1d_c2c_inplace(const std::size_t i)
+{
+    fft_c2c_adapter_.execute(reinterpret_cast<fftw_complex *>(trans_values_vec_.row(i)),
+                             reinterpret_cast<fftw_complex *>(trans_values_vec_.row(i)));
+}
+
+// transpose with write running index
+void hpxfft::fft2D::shared::sender::transpose_shared_y_to_x(const std::size_t index)
+{
+    for (std::size_t index_trans = 0; index_trans < dim_c_x_; ++index_trans)
+    {
+        trans_values_vec_(index, 2 * index_trans) = values_vec_(index_trans, 2 * index);
+        trans_values_vec_(index, 2 * index_trans + 1) = values_vec_(index_trans, 2 * index + 1);
+    }
+}
+
+// transpose with read running index
+void hpxfft::fft2D::shared::sender::transpose_shared_x_to_y(const std::size_t index_trans)
+{
+    for (std::size_t index = 0; index < dim_c_x_; ++index)
+    {
+        values_vec_(index, 2 * index_trans) = trans_values_vec_(index_trans, 2 * index);
+        values_vec_(index, 2 * index_trans + 1) = trans_values_vec_(index_trans, 2 * index + 1);
+    }
+}
+
+// 2D FFT algorithm
+hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::sender::fft_2d_r2c()
+{
+    // the only blocking point of the engine
+    auto result = hpx::this_thread::experimental::sync_wait(fft_2d_r2c_sender());
+    return std::move(hpx::get<0>(*result));
+}
+
+hpx::future<hpxfft::fft2D::shared::vector_2d> hpxfft::fft2D::shared::sender::fft_2d_r2c_async()
+{
+    return hpx::execution::experimental::make_future(fft_2d_r2c_sender());
+}
+
+// initialization
+void hpxfft::fft2D::shared::sender::initialize(hpxfft::fft2D::shared::vector_2d values_vec, const std::string PLAN_FLAG)
+{
+    // move data into own data structure
+    values_vec_ = std::move(values_vec);
+    // parameters
+    dim_c_x_ = values_vec_.n_row();
+    dim_c_y_ = values_vec_.n_col() / 2;
+    dim_r_y_ = 2 * dim_c_y_ - 2;
+    // resize transposed data structure
+    trans_values_vec_ = std::move(hpxfft::fft2D::shared::vector_2d(dim_c_y_, 2 * dim_c_x_));
+    PLAN_FLAG_ = PLAN_FLAG;
+    // create FFTW plans
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
+    // r2c in y-direction
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          1,
+                          r2c_aligned);
+    // c2c in x-direction
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
+    fft_c2c_adapter_.plan(dim_c_x_,
+                          PLAN_FLAG,
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          1,
+                          c2c_aligned);
+}
+
+void hpxfft::fft2D::shared::sender::set_values(vector_2d values_vec)
+{
+    if (values_vec.n_row() != dim_c_x_ || values_vec.n_col() != 2 * dim_c_y_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    values_vec_ = std::move(values_vec);
+    // a buffer of another alignment than the planned one needs an unaligned r2c plan
+    if (!fft_r2c_adapter_.accepts(values_vec_.row(0), values_vec_.n_col()))
+    {
+        fft_r2c_adapter_.plan(dim_r_y_,
+                              PLAN_FLAG_,
+                              trans_values_vec_.row(0),
+                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                              1,
+                              false);
+    }
+}
+
+// helpers
+void hpxfft::fft2D::shared::sender::finalize_measurements()
+{
+    auto stop_total = t_.now();
+    measurements_["total"] = stop_total - start_total_;
+    measurements_["first_fftw"] = start_first_trans_ - start_total_;
+    measurements_["first_trans"] = start_second_fft_ - start_first_trans_;
+    measurements_["second_fftw"] = start_second_trans_ - start_second_fft_;
+    measurements_["second_trans"] = stop_total - start_second_trans_;
+}
+
+real hpxfft::fft2D::shared::sender::get_measurement(std::string name) { return measurements_[name]; }
@@ -0,0 +1,169 @@
+#include "../../../include/hpxfft/2D/shared/service.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <hpx/thread.hpp>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+
+hpxfft::fft2D::shared::service::service(const std::string PLAN_FLAG, const std::size_t MAX_BATCH) :
+    PLAN_FLAG_(PLAN_FLAG),
+    max_batch_(std::max(MAX_BATCH, std::size_t(1)))
+{
+    // check plan flag once instead of on every planning
+    hpxfft::util::fftw_adapter::string_to_fftw_plan_flag(PLAN_FLAG_);
+}
+
+// submission
+hpx::future<hpxfft::fft2D::shared::vector_2d>
+hpxfft::fft2D::shared::service::fft_2d_r2c_async(hpxfft::fft2D::shared::vector_2d values_vec)
+{
+    if (values_vec.n_col() < 4 || values_vec.n_col() % 2 != 0 || values_vec.n_row() == 0)
+    {
+        return hpx::make_exceptional_future<vector_2d>(
+            std::invalid_argument("Input rows have to be padded to 2 * (n_y / 2 + 1) reals"));
+    }
+    request req{ std::move(values_vec), hpx::promise<vector_2d>() };
+    hpx::future<vector_2d> result = req.promise_.get_future();
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    queue_.enqueue(std::move(req));
+    // start a drain task unless one is already running, the task counts as pending
+    if (!draining_.exchange(true, std::memory_order_acq_rel))
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        hpx::post(&service::drain, this);
+    }
+    return result;
+}
+
+hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::service::fft_2d_r2c(hpxfft::fft2D::shared::vector_2d values_vec)
+{
+    return fft_2d_r2c_async(std::move(values_vec)).get();
+}
+
+// batching
+void hpxfft::fft2D::shared::service::drain()
+{
+    while (true)
+    {
+        std::vector<request> requests;
+        while (queue_.try_dequeue_bulk(std::back_inserter(requests), 4 * max_batch_) > 0)
+        {
+            // group by shape, requests submitted while grouping join the next round
+            std::map<shape, std::vector<request>> groups;
+            for (request &req : requests)
+            {
+                groups[shape(req.values_vec_.n_row(), req.values_vec_.n_col())].push_back(std::move(req));
+            }
+            requests.clear();
+            for (auto &[key, group] : groups)
+            {
+                // split group into batches of at most max_batch_ transforms
+                for (std::size_t begin = 0; begin < group.size(); begin += max_batch_)
+                {
+                    const std::size_t end = std::min(begin + max_batch_, group.size());
+                    std::vector<request> batch(std::make_move_iterator(group.begin() + begin),
+                                               std::make_move_iterator(group.begin() + end));
+                    hpx::post([this, batch = std::move(batch)]() mutable { run_batch(std::move(batch)); });
+                }
+            }
+        }
+        draining_.store(false, std::memory_order_release);
+        // requests enqueued after the last dequeue and before the reset
+        if (queue_.size_approx() == 0 || draining_.exchange(true, std::memory_order_acq_rel))
+        {
+            pending_.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void hpxfft::fft2D::shared::service::run_batch(std::vector<request> batch)
+{
+    const std::size_t n_row = batch[0].values_vec_.n_row();
+    const std::size_t n_col = batch[0].values_vec_.n_col();
+    const std::size_t size = n_row * n_col;
+    const std::size_t count = batch.size();
+    real *buffer = nullptr;
+    hpxfft::util::fftw_adapter::r2c_2d_many *plan = nullptr;
+    try
+    {
+        {
+            std::lock_guard<hpx::mutex> lock(mutex_);
+            shape_cache &cache = shapes_[shape(n_row, n_col)];
+            // reuse buffer that holds max_batch_ transforms
+            if (cache.buffers_.empty())
+            {
+                buffer = fftw_alloc_real(max_batch_ * size);
+                if (!buffer)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+            else
+            {
+                buffer = cache.buffers_.back();
+                cache.buffers_.pop_back();
+            }
+            // plan once per batch size, planning may overwrite the buffer
+            std::unique_ptr<hpxfft::util::fftw_adapter::r2c_2d_many> &cached_plan = cache.plans_[count];
+            if (!cached_plan)
+            {
+                cached_plan = std::make_unique<hpxfft::util::fftw_adapter::r2c_2d_many>();
+                cached_plan->plan(
+                    static_cast<int>(n_row), static_cast<int>(n_col), static_cast<int>(count), PLAN_FLAG_, buffer);
+            }
+            plan = cached_plan.get();
+        }
+        // gather, transform and scatter the batch
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            std::copy(batch[j].values_vec_.begin(), batch[j].values_vec_.end(), buffer + j * size);
+        }
+        plan->execute(buffer);
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            std::copy(buffer + j * size, buffer + (j + 1) * size, batch[j].values_vec_.begin());
+            batch[j].promise_.set_value(std::move(batch[j].values_vec_));
+        }
+    }
+    catch (...)
+    {
+        for (request &req : batch)
+        {
+            try
+            {
+                req.promise_.set_exception(std::current_exception());
+            }
+            catch (...)
+            {
+                // promise already satisfied
+            }
+        }
+    }
+    if (buffer)
+    {
+        std::lock_guard<hpx::mutex> lock(mutex_);
+        shapes_[shape(n_row, n_col)].buffers_.push_back(buffer);
+    }
+    pending_.fetch_sub(count, std::memory_order_release);
+}
+
+hpxfft::fft2D::shared::service::~service()
+{
+    // wait for submitted transforms and the drain task
+    while (pending_.load(std::memory_order_acquire) > 0)
+    {
+        hpx::this_thread::yield();
+    }
+    for (auto &[key, cache] : shapes_)
+    {
+        cache.plans_.clear();
+        for (real *buffer : cache.buffers_)
+        {
+            fftw_free(buffer);
+        }
+    }
+    // global FFTW cleanup is left to the application, other engines may hold live plans
+}
@@ -1,5 +1,8 @@
 #include "../../../include/hpxfft/2D/shared/sync.hpp"
 
+#include "../../../include/hpxfft/util/thread_pools.hpp"
+#include <stdexcept>
+
 // FFT backend
 void hpxfft::fft2D::shared::sync::fft_1d_r2c_inplace(const std::size_t i)
 {
@@ -32,72 +35,130 @@ void hpxfft::fft2D::shared::sync::transpose_shared_x_to_y(const std::size_t inde
     }
 }
 
-// wrappers
-void hpxfft::fft2D::shared::sync::fft_1d_r2c_inplace_wrapper(sync *th, const std::size_t i) { th->fft_1d_r2c_inplace(i); }
-
-void hpxfft::fft2D::shared::sync::fft_1d_c2c_inplace_wrapper(sync *th, const std::size_t i) { th->fft_1d_c2c_inplace(i); }
-
-void hpxfft::fft2D::shared::sync::transpose_shared_y_to_x_wrapper(sync *th, const std::size_t index)
+// transpose of a block of rows with write running index inside the block
+void hpxfft::fft2D::shared::sync::transpose_y_to_x_rows(const std::size_t begin, const std::size_t end)
 {
-    th->transpose_shared_y_to_x(index);
-}
-
-void hpxfft::fft2D::shared::sync::transpose_shared_x_to_y_wrapper(sync *th, const std::size_t index_trans)
-{
-    th->transpose_shared_x_to_y(index_trans);
+    for (std::size_t index = 0; index < dim_c_y_; ++index)
+    {
+        for (std::size_t index_trans = begin; index_trans < end; ++index_trans)
+        {
+            trans_values_vec_(index, 2 * index_trans) = values_vec_(index_trans, 2 * index);
+            trans_values_vec_(index, 2 * index_trans + 1) = values_vec_(index_trans, 2 * index + 1);
+        }
+    }
 }
 
-// 2D FFT algorithm
-hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::sync::fft_2d_r2c()
+// task graph
+void hpxfft::fft2D::shared::sync::build_task_graph()
 {
-    auto start_total = t_.now();
+    task_graph_.clear();
+    // global synchronization steps, each one takes a time stamp
+    std::size_t all_r2c = task_graph_.add_node([this] { start_first_trans_ = t_.now(); });
+    std::size_t all_trans_y_to_x = task_graph_.add_node([this] { start_second_fft_ = t_.now(); });
+    std::size_t all_c2c = task_graph_.add_node([this] { start_second_trans_ = t_.now(); });
     // first dimension
     for (std::size_t i = 0; i < dim_c_x_; ++i)
     {
         // 1d FFT r2c in y-direction
-        r2c_futures_[i] = hpx::async(&fft_1d_r2c_inplace_wrapper, this, i);
+        std::size_t r2c = task_graph_.add_node([this, i] { fft_1d_r2c_inplace(i); });
+        task_graph_.add_edge(r2c, all_r2c);
     }
-    // global synchronization step
-    hpx::wait_all(r2c_futures_);
-    auto start_first_trans = t_.now();
-    // for(std::size_t i = 0; i < dim_c_x_; ++i) for other transpose
     for (std::size_t i = 0; i < dim_c_y_; ++i)
     {
         // transpose from y-direction to x-direction
-        trans_y_to_x_futures_[i] = hpx::async(&hpxfft::fft2D::shared::sync::transpose_shared_y_to_x_wrapper, this, i);
+        std::size_t trans_y_to_x = task_graph_.add_node([this, i] { transpose_shared_y_to_x(i); });
+        task_graph_.add_edge(all_r2c, trans_y_to_x);
+        task_graph_.add_edge(trans_y_to_x, all_trans_y_to_x);
     }
-    // global synchronization step
-    hpx::wait_all(trans_y_to_x_futures_);
     // second dimension
-    auto start_second_fft = t_.now();
     for (std::size_t i = 0; i < dim_c_y_; ++i)
     {
         // 1D FFT in x-direction
-        c2c_futures_[i] = hpx::async(&hpxfft::fft2D::shared::sync::fft_1d_c2c_inplace_wrapper, this, i);
+        std::size_t c2c = task_graph_.add_node([this, i] { fft_1d_c2c_inplace(i); });
+        task_graph_.add_edge(all_trans_y_to_x, c2c);
+        task_graph_.add_edge(c2c, all_c2c);
     }
-    // global synchronization step
-    hpx::wait_all(c2c_futures_);
-    auto start_second_trans = t_.now();
     for (std::size_t i = 0; i < dim_c_y_; ++i)
     {
-        trans_x_to_y_futures_[i] = hpx::async(&hpxfft::fft2D::shared::sync::transpose_shared_x_to_y_wrapper, this, i);
+        // transpose from x-direction to y-direction
+        std::size_t trans_x_to_y = task_graph_.add_node([this, i] { transpose_shared_x_to_y(i); });
+        task_graph_.add_edge(all_c2c, trans_x_to_y);
     }
-    // global synchronization step
-    hpx::wait_all(trans_x_to_y_futures_);
-    auto stop_total = t_.now();
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
-    measurements_["first_fftw"] = start_first_trans - start_total;
-    measurements_["first_trans"] = start_second_fft - start_first_trans;
-    measurements_["second_fftw"] = start_second_trans - start_second_fft;
-    measurements_["second_trans"] = stop_total - start_second_trans;
+}
 
-    return std::move(values_vec_);
+// task graph with row blocks pinned to worker threads
+void hpxfft::fft2D::shared::sync::build_task_graph_affinity()
+{
+    task_graph_.clear();
+    const std::size_t n_workers = hpxfft::util::compute_thread_count();
+    // global synchronization steps, each one takes a time stamp
+    std::size_t all_r2c = task_graph_.add_node([this] { start_first_trans_ = t_.now(); });
+    std::size_t all_trans_y_to_x = task_graph_.add_node([this] { start_second_fft_ = t_.now(); });
+    std::size_t all_c2c = task_graph_.add_node([this] { start_second_trans_ = t_.now(); });
+    for (std::size_t worker = 0; worker < n_workers; ++worker)
+    {
+        const hpx::execution::parallel_executor executor = hpxfft::util::worker_executor(worker);
+        // first dimension
+        const std::size_t begin_x = worker * dim_c_x_ / n_workers;
+        const std::size_t end_x = (worker + 1) * dim_c_x_ / n_workers;
+        if (begin_x < end_x)
+        {
+            for (std::size_t i = begin_x; i < end_x; ++i)
+            {
+                // 1d FFT r2c in y-direction
+                std::size_t r2c = task_graph_.add_node([this, i] { fft_1d_r2c_inplace(i); }, executor);
+                task_graph_.add_edge(r2c, all_r2c);
+            }
+            // transpose from y-direction to x-direction on the worker that owns the rows
+            std::size_t trans_y_to_x = task_graph_.add_node(
+                [this, begin_x, end_x] { transpose_y_to_x_rows(begin_x, end_x); }, executor);
+            task_graph_.add_edge(all_r2c, trans_y_to_x);
+            task_graph_.add_edge(trans_y_to_x, all_trans_y_to_x);
+        }
+        // second dimension
+        const std::size_t begin_y = worker * dim_c_y_ / n_workers;
+        const std::size_t end_y = (worker + 1) * dim_c_y_ / n_workers;
+        for (std::size_t i = begin_y; i < end_y; ++i)
+        {
+            // 1D FFT in x-direction
+            std::size_t c2c = task_graph_.add_node([this, i] { fft_1d_c2c_inplace(i); }, executor);
+            task_graph_.add_edge(all_trans_y_to_x, c2c);
+            task_graph_.add_edge(c2c, all_c2c);
+            // transpose from x-direction to y-direction on the same worker
+            std::size_t trans_x_to_y = task_graph_.add_node([this, i] { transpose_shared_x_to_y(i); }, executor);
+            task_graph_.add_edge(all_c2c, trans_x_to_y);
+        }
+    }
+}
+
+// 2D FFT algorithm
+hpxfft::fft2D::shared::vector_2d hpxfft::fft2D::shared::sync::fft_2d_r2c() { return fft_2d_r2c_async().get(); }
+
+hpx::future<hpxfft::fft2D::shared::vector_2d> hpxfft::fft2D::shared::sync::fft_2d_r2c_async()
+{
+    auto start_total = t_.now();
+    // replay prebuilt task graph
+    return task_graph_.run_async().then(
+        [this, start_total](hpx::future<void> r)
+        {
+            r.get();
+            auto stop_total = t_.now();
+            ////////////////////////////////////////////////////////////////
+            // additional runtimes
+            measurements_["total"] = stop_total - start_total;
+            measurements_["first_fftw"] = start_first_trans_ - start_total;
+            measurements_["first_trans"] = start_second_fft_ - start_first_trans_;
+            measurements_["second_fftw"] = start_second_trans_ - start_second_fft_;
+            measurements_["second_trans"] = stop_total - start_second_trans_;
+
+            return std::move(values_vec_);
+        });
 }
 
 // initialization
-void hpxfft::fft2D::shared::sync::initialize(hpxfft::fft2D::shared::vector_2d values_vec, const std::string PLAN_FLAG)
+void hpxfft::fft2D::shared::sync::initialize(hpxfft::fft2D::shared::vector_2d values_vec,
+                                             const std::string PLAN_FLAG,
+                                             const bool AFFINITY)
 {
     // move data into own data structure
     values_vec_ = std::move(values_vec);
@@ -107,23 +168,59 @@ void hpxfft::fft2D::shared::sync::initialize(hpxfft::fft2D::shared::vector_2d va
     dim_r_y_ = 2 * dim_c_y_ - 2;
     // resize transposed data structure
     trans_values_vec_ = std::move(hpxfft::fft2D::shared::vector_2d(dim_c_y_, 2 * dim_c_x_));
+    PLAN_FLAG_ = PLAN_FLAG;
     // create FFTW plans
+    // the plans execute on every row: SIMD codelets only if the rows keep the planned alignment
+    const bool r2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), values_vec_.row(0), values_vec_.n_col());
+    const bool c2c_aligned = hpxfft::util::fftw_adapter::keeps_alignment(
+        trans_values_vec_.row(0), trans_values_vec_.row(0), trans_values_vec_.n_col());
     // r2c in y-direction
-    fft_r2c_adapter_ = hpxfft::util::fftw_adapter::r2c_1d();
-    fft_r2c_adapter_.plan(
-        dim_r_y_, PLAN_FLAG, trans_values_vec_.row(0), reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)));
+    fft_r2c_adapter_ = hpxfft::util::fft_backend::r2c_1d();
+    fft_r2c_adapter_.plan(dim_r_y_,
+                          PLAN_FLAG,
+                          trans_values_vec_.row(0),
+                          reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                          1,
+                          r2c_aligned);
     // c2c in x-direction
-    fft_c2c_adapter_ = hpxfft::util::fftw_adapter::c2c_1d();
+    fft_c2c_adapter_ = hpxfft::util::fft_backend::c2c_1d();
     fft_c2c_adapter_.plan(dim_c_x_,
                           PLAN_FLAG,
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
                           reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
-                          hpxfft::util::fftw_adapter::direction::forward);
-    // resize futures
-    r2c_futures_.resize(dim_c_x_);
-    trans_y_to_x_futures_.resize(dim_c_x_);
-    c2c_futures_.resize(dim_c_y_);
-    trans_x_to_y_futures_.resize(dim_c_y_);
+                          hpxfft::util::fftw_adapter::direction::forward,
+                          1,
+                          c2c_aligned);
+    // dependency structure of the transform
+    affinity_ = AFFINITY;
+    if (affinity_)
+    {
+        build_task_graph_affinity();
+    }
+    else
+    {
+        build_task_graph();
+    }
+}
+
+void hpxfft::fft2D::shared::sync::set_values(vector_2d values_vec)
+{
+    if (values_vec.n_row() != dim_c_x_ || values_vec.n_col() != 2 * dim_c_y_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    values_vec_ = std::move(values_vec);
+    // a buffer of another alignment than the planned one needs an unaligned r2c plan
+    if (!fft_r2c_adapter_.accepts(values_vec_.row(0), values_vec_.n_col()))
+    {
+        fft_r2c_adapter_.plan(dim_r_y_,
+                              PLAN_FLAG_,
+                              trans_values_vec_.row(0),
+                              reinterpret_cast<fftw_complex *>(trans_values_vec_.row(0)),
+                              1,
+                              false);
+    }
 }
 
 // helpers
@@ -0,0 +1,570 @@
+#include "../../../include/hpxfft/3D/distributed/loop.hpp"
+
+#include "../../../include/hpxfft/util/thread_pools.hpp"
+#include <hpx/hpx_init.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <stdexcept>
+
+// split data for communication
+void hpxfft::fft3D::distributed::loop::split_vec(const std::size_t i)
+{
+    const std::size_t part = 2 * n_y_local_;
+    for (std::size_t l = 0; l < num_localities_; ++l)
+    {
+        // block of this locality is transposed locally
+        if (l == this_locality_)
+        {
+            continue;
+        }
+        for (std::size_t k = 0; k < dim_c_z_; ++k)
+        {
+            std::copy(permuted_vec_.vector_z(i, k) + l * part,
+                      permuted_vec_.vector_z(i, k) + (l + 1) * part,
+                      values_prep_[l].begin() + (i * dim_c_z_ + k) * part);
+        }
+    }
+}
+
+void hpxfft::fft3D::distributed::loop::split_trans_vec(const std::size_t j)
+{
+    const std::size_t part = 2 * n_x_local_;
+    for (std::size_t l = 0; l < num_localities_; ++l)
+    {
+        // block of this locality is transposed locally
+        if (l == this_locality_)
+        {
+            continue;
+        }
+        for (std::size_t k = 0; k < dim_c_z_; ++k)
+        {
+            std::copy(values_vec_.vector_z(j, k) + l * part,
+                      values_vec_.vector_z(j, k) + (l + 1) * part,
+                      trans_values_prep_[l].begin() + (j * dim_c_z_ + k) * part);
+        }
+    }
+}
+
+// scatter communication
+void hpxfft::fft3D::distributed::loop::communicate_scatter_vec(const std::size_t l)
+{
+    if (this_locality_ != l)
+    {
+        // receive from other locality
+        communication_futures_[l] = hpx::collectives::scatter_from<std::vector<real>>(
+            communicators_[l], hpx::collectives::generation_arg(generation_));
+    }
+    else
+    {
+        // send from this locality
+        communication_futures_[l] = hpx::collectives::scatter_to(
+            communicators_[l], std::move(values_prep_), hpx::collectives::generation_arg(generation_));
+    }
+}
+
+void hpxfft::fft3D::distributed::loop::communicate_scatter_trans_vec(const std::size_t l)
+{
+    if (this_locality_ != l)
+    {
+        // receive from other locality
+        communication_futures_[l] = hpx::collectives::scatter_from<std::vector<real>>(
+            communicators_[l], hpx::collectives::generation_arg(generation_));
+    }
+    else
+    {
+        // send from this locality
+        communication_futures_[l] = hpx::collectives::scatter_to(
+            communicators_[l], std::move(trans_values_prep_), hpx::collectives::generation_arg(generation_));
+    }
+}
+
+// all to all communication
+void hpxfft::fft3D::distributed::loop::communicate_all_to_all_vec()
+{
+    all_to_all_future_ = hpx::collectives::all_to_all(
+        communicators_[0], std::move(values_prep_), hpx::collectives::generation_arg(generation_));
+}
+
+void hpxfft::fft3D::distributed::loop::communicate_all_to_all_trans_vec()
+{
+    all_to_all_future_ = hpx::collectives::all_to_all(
+        communicators_[0], std::move(trans_values_prep_), hpx::collectives::generation_arg(generation_));
+}
+
+// start communication
+hpx::future<void> hpxfft::fft3D::distributed::loop::communicate_vec()
+{
+    ++generation_;
+    if (COMM_FLAG_ == "scatter")
+    {
+        for (std::size_t l = 0; l < num_localities_; ++l)
+        {
+            // scatter operation from all localities
+            communicate_scatter_vec(l);
+        }
+    }
+    else
+    {
+        // all to all operation
+        communicate_all_to_all_vec();
+    }
+    return collect_communication();
+}
+
+hpx::future<void> hpxfft::fft3D::distributed::loop::communicate_trans_vec()
+{
+    ++generation_;
+    if (COMM_FLAG_ == "scatter")
+    {
+        for (std::size_t l = 0; l < num_localities_; ++l)
+        {
+            // scatter operation from all localities
+            communicate_scatter_trans_vec(l);
+        }
+    }
+    else
+    {
+        // all to all operation
+        communicate_all_to_all_trans_vec();
+    }
+    return collect_communication();
+}
+
+// communication results
+hpx::future<void> hpxfft::fft3D::distributed::loop::collect_communication()
+{
+    if (COMM_FLAG_ == "scatter")
+    {
+        return hpx::when_all(communication_futures_)
+            .then(communication_executor_,
+                  [this](hpx::future<std::vector<hpx::future<std::vector<real>>>> r)
+                  {
+                      std::vector<hpx::future<std::vector<real>>> received = r.get();
+                      for (std::size_t l = 0; l < num_localities_; ++l)
+                      {
+                          communication_vec_[l] = received[l].get();
+                      }
+                  });
+    }
+    return all_to_all_future_.then(communication_executor_,
+                                   [this](hpx::future<vector_comm> r) { communication_vec_ = r.get(); });
+}
+
+void hpxfft::fft3D::distributed::loop::prepare_communication(vector_comm &prep)
+{
+    // the previous exchange moved the buffers out
+    prep.resize(num_localities_);
+    for (std::size_t l = 0; l < num_localities_; ++l)
+    {
+        // block of this locality is never communicated and stays empty
+        if (l != this_locality_)
+        {
+            prep[l].resize(block_size_);
+        }
+    }
+}
+
+// transpose after communication:
+// the block from locality l holds (x, z, y) for the x-slices of l and the y-slices of this locality
+void hpxfft::fft3D::distributed::loop::transpose_y_to_x(const std::size_t j, const std::size_t l)
+{
+    std::size_t index_in;
+    std::size_t index_out;
+    const std::vector<real> &block = communication_vec_[l];
+
+    for (std::size_t i = 0; i < n_x_local_; ++i)
+    {
+        index_out = 2 * (l * n_x_local_ + i);
+        for (std::size_t k = 0; k < dim_c_z_; ++k)
+        {
+            index_in = 2 * ((i * dim_c_z_ + k) * n_y_local_ + j);
+            // transpose
+            values_vec_(j, k, index_out) = block[index_in];
+            values_vec_(j, k, index_out + 1) = block[index_in + 1];
+        }
+    }
+}
+
+// the block from locality l holds (y, z, x) for the y-slices of l and the x-slices of this locality
+void hpxfft::fft3D::distributed::loop::transpose_x_to_y(const std::size_t i, const std::size_t l)
+{
+    std::size_t index_in;
+    const std::vector<real> &block = communication_vec_[l];
+
+    for (std::size_t j = 0; j < n_y_local_; ++j)
+    {
+        real *out = permuted_vec_.vector_z(i, l * n_y_local_ + j);
+        for (std::size_t k = 0; k < dim_c_z_; ++k)
+        {
+            index_in = 2 * ((j * dim_c_z_ + k) * n_x_local_ + i);
+            // transpose
+            out[2 * k] = block[index_in];
+            out[2 * k + 1] = block[index_in + 1];
+        }
+    }
+}
+
+// transpose of the local block directly from the source vector
+void hpxfft::fft3D::distributed::loop::transpose_y_to_x_local(const std::size_t j)
+{
+    std::size_t index_out;
+    const std::size_t index_in = 2 * (this_locality_ * n_y_local_ + j);
+
+    for (std::size_t i = 0; i < n_x_local_; ++i)
+    {
+        index_out = 2 * (this_locality_ * n_x_local_ + i);
+        for (std::size_t k = 0; k < dim_c_z_; ++k)
+        {
+            // transpose
+            values_vec_(j, k, index_out) = permuted_vec_(i, k, index_in);
+            values_vec_(j, k, index_out + 1) = permuted_vec_(i, k, index_in + 1);
+        }
+    }
+}
+
+void hpxfft::fft3D::distributed::loop::transpose_x_to_y_local(const std::size_t i)
+{
+    const std::size_t index_in = 2 * (this_locality_ * n_x_local_ + i);
+
+    for (std::size_t j = 0; j < n_y_local_; ++j)
+    {
+        real *out = permuted_vec_.vector_z(i, this_locality_ * n_y_local_ + j);
+        for (std::size_t k = 0; k < dim_c_z_; ++k)
+        {
+            // transpose
+            out[2 * k] = values_vec_(j, k, index_in);
+            out[2 * k + 1] = values_vec_(j, k, index_in + 1);
+        }
+    }
+}
+
+// 3D FFT algorithm
+hpxfft::fft3D::distributed::vector_3d hpxfft::fft3D::distributed::loop::fft_3d_r2c()
+{
+    return fft_3d_r2c_async().get();
+}
+
+hpx::future<hpxfft::fft3D::distributed::vector_3d> hpxfft::fft3D::distributed::loop::fft_3d_r2c_async()
+{
+    if (COMM_FLAG_ != "scatter" && COMM_FLAG_ != "all_to_all")
+    {
+        std::cout << "Communication scheme not specified during initialization\n";
+        hpx::finalize();
+    }
+    // FFTs and transposes run on the compute pool:
+    // loops feeding a collective are critical and run with high priority,
+    // local transposes overlapping with communication are background work on at most
+    // background_task_limit() tasks, so one worker thread stays free for critical work
+    const auto policy = hpx::execution::par(hpx::execution::task).on(compute_executor_);
+    const auto critical_policy = hpx::execution::par(hpx::execution::task)
+                                     .on(hpx::execution::experimental::with_priority(
+                                         compute_executor_, hpx::threads::thread_priority::high));
+    /////////////////////////////////////////////////////////////////
+    // first dimension
+    start_total_ = t_.now();
+    return hpx::experimental::for_loop(critical_policy,
+                                       0,
+                                       n_x_local_,
+                                       [this](auto i)
+                                       {
+                                           // batched 1D FFT r2c in z-direction
+                                           fft_1d_r2c_slice(i);
+                                       })
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_first_permute_ = t_.now();
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_x_local_,
+                                                   [this](auto i)
+                                                   {
+                                                       // permute from x-y-z to x-z-y
+                                                       permute_shared_x_z_y(i);
+                                                   });
+            })
+        // second dimension
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_second_fft_ = t_.now();
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_x_local_,
+                                                   [this](auto i)
+                                                   {
+                                                       // batched 1D FFT c2c in y-direction
+                                                       fft_1d_c2c_y_slice(i);
+                                                   });
+            })
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_first_split_ = t_.now();
+                prepare_communication(values_prep_);
+                // input is consumed, reuse as y-z-x target of the global transpose
+                values_vec_.rearrange(n_y_local_, dim_c_z_, 2 * dim_c_x_);
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_x_local_,
+                                                   [this](auto i)
+                                                   {
+                                                       // rearrange for communication step
+                                                       split_vec(i);
+                                                   });
+            })
+        // communication for FFT in third dimension
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_first_comm_ = t_.now();
+                // collectives are started on the communication pool
+                hpx::future<void> received = hpx::async(communication_executor_, &loop::communicate_vec, this);
+                // overlap communication with transpose of the local block
+                return hpx::dataflow(
+                    [](hpx::future<void> received, hpx::future<void> local)
+                    {
+                        received.get();
+                        local.get();
+                    },
+                    std::move(received),
+                    hpxfft::util::background_for_loop(compute_executor_,
+                                                      0,
+                                                      n_y_local_,
+                                                      [this](std::size_t j)
+                                                      {
+                                                          // transpose from x-z-y to y-z-x
+                                                          transpose_y_to_x_local(j);
+                                                      }));
+            })
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_first_trans_ = t_.now();
+                // one iteration per y-slice and communicated block
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   num_localities_ * n_y_local_,
+                                                   [this](auto index)
+                                                   {
+                                                       const std::size_t l = index / n_y_local_;
+                                                       const std::size_t j = index % n_y_local_;
+                                                       if (l == this_locality_)
+                                                       {
+                                                           return;
+                                                       }
+                                                       // transpose from x-z-y to y-z-x
+                                                       transpose_y_to_x(j, l);
+                                                   });
+            })
+        // third dimension
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_third_fft_ = t_.now();
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_y_local_,
+                                                   [this](auto j)
+                                                   {
+                                                       // batched 1D FFT c2c in x-direction
+                                                       fft_1d_c2c_x_slice(j);
+                                                   });
+            })
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_second_split_ = t_.now();
+                prepare_communication(trans_values_prep_);
+                // reuse as x-y-z target of the transpose back
+                permuted_vec_.rearrange(n_x_local_, dim_c_y_, 2 * dim_c_z_);
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_y_local_,
+                                                   [this](auto j)
+                                                   {
+                                                       // rearrange for communication step
+                                                       split_trans_vec(j);
+                                                   });
+            })
+        // communication to get original data layout
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                start_second_comm_ = t_.now();
+                // collectives are started on the communication pool
+                hpx::future<void> received = hpx::async(communication_executor_, &loop::communicate_trans_vec, this);
+                // overlap communication with transpose of the local block
+                return hpx::dataflow(
+                    [](hpx::future<void> received, hpx::future<void> local)
+                    {
+                        received.get();
+                        local.get();
+                    },
+                    std::move(received),
+                    hpxfft::util::background_for_loop(compute_executor_,
+                                                      0,
+                                                      n_x_local_,
+                                                      [this](std::size_t i)
+                                                      {
+                                                          // transpose from y-z-x to x-y-z
+                                                          transpose_x_to_y_local(i);
+                                                      }));
+            })
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                start_second_trans_ = t_.now();
+                // one iteration per x-slice and communicated block
+                return hpx::experimental::for_loop(policy,
+                                                   0,
+                                                   num_localities_ * n_x_local_,
+                                                   [this](auto index)
+                                                   {
+                                                       const std::size_t l = index / n_x_local_;
+                                                       const std::size_t i = index % n_x_local_;
+                                                       if (l == this_locality_)
+                                                       {
+                                                           return;
+                                                       }
+                                                       // transpose from y-z-x to x-y-z
+                                                       transpose_x_to_y(i, l);
+                                                   });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_first_permute_ - start_total_;
+                measurements_["first_permute"] = start_second_fft_ - start_first_permute_;
+                measurements_["second_fftw"] = start_first_split_ - start_second_fft_;
+                measurements_["first_split"] = start_first_comm_ - start_first_split_;
+                measurements_["first_comm"] = start_first_trans_ - start_first_comm_;
+                measurements_["first_trans"] = start_third_fft_ - start_first_trans_;
+                measurements_["third_fftw"] = start_second_split_ - start_third_fft_;
+                measurements_["second_split"] = start_second_comm_ - start_second_split_;
+                measurements_["second_comm"] = start_second_trans_ - start_second_comm_;
+                measurements_["second_trans"] = stop_total - start_second_trans_;
+                ////////////////////////////////////////////////////////////////
+                return std::move(permuted_vec_);
+            });
+}
+
+// initialization
+void hpxfft::fft3D::distributed::loop::initialize(
+    hpxfft::fft3D::distributed::vector_3d values_vec, const std::string COMM_FLAG, const std::string PLAN_FLAG)
+{
+    // move data into own structure
+    values_vec_ = std::move(values_vec);
+    // locality information
+    this_locality_ = hpx::get_locality_id();
+    num_localities_ = hpx::get_num_localities(hpx::launch::sync);
+    // parameters
+    n_x_local_ = values_vec_.n_x();
+    dim_c_x_ = n_x_local_ * num_localities_;
+    dim_c_y_ = values_vec_.n_y();
+    dim_c_z_ = values_vec_.n_z() / 2;
+    dim_r_z_ = 2 * dim_c_z_ - 2;
+    if (dim_c_y_ % num_localities_ != 0)
+    {
+        throw std::invalid_argument("Slab decomposition requires n_y to be divisible by the number of localities");
+    }
+    n_y_local_ = dim_c_y_ / num_localities_;
+    block_size_ = 2 * n_x_local_ * n_y_local_ * dim_c_z_;
+    // resize permuted data structure, holds x-z-y and later the x-y-z result
+    permuted_vec_ = vector_3d(n_x_local_, dim_c_z_, 2 * dim_c_y_);
+    PLAN_FLAG_ = PLAN_FLAG;
+    auto start_plan = t_.now();
+    // batched plans per slice, x-direction over the global extent,
+    // planning must not overwrite the input
+    plan_slices(permuted_vec_.data());
+    auto stop_plan = t_.now();
+    measurements_["plan"] = stop_plan - start_plan;
+    // compute local plan flops
+    double add_z, mul_z, fma_z;
+    fftw_r2c_adapter_dir_z_.flops(&add_z, &mul_z, &fma_z);
+    double add_y, mul_y, fma_y;
+    fftw_c2c_adapter_dir_y_.flops(&add_y, &mul_y, &fma_y);
+    double add_x, mul_x, fma_x;
+    fftw_c2c_adapter_dir_x_.flops(&add_x, &mul_x, &fma_x);
+    measurements_["plan_flops"] = n_x_local_ * (add_z + mul_z + fma_z)
+                                + n_x_local_ * (add_y + mul_y + fma_y)
+                                + n_y_local_ * (add_x + mul_x + fma_x);
+    // thread pools
+    // collectives are on the critical path
+    communication_executor_ = hpx::execution::experimental::with_priority(hpxfft::util::communication_executor(),
+                                                                          hpx::threads::thread_priority::high);
+    compute_executor_ = hpxfft::util::compute_executor();
+    // communication specific initialization
+    COMM_FLAG_ = COMM_FLAG;
+    generation_ = 0;
+    if (COMM_FLAG_ == "scatter")
+    {
+        communication_vec_.resize(num_localities_);
+        communication_futures_.resize(num_localities_);
+        // setup communicators, one per root locality
+        basenames_.resize(num_localities_);
+        communicators_.resize(num_localities_);
+        for (std::size_t l = 0; l < num_localities_; ++l)
+        {
+            basenames_[l] = "hpxfft_3d_slab_" + std::to_string(l);
+            communicators_[l] = hpx::collectives::create_communicator(
+                basenames_[l].c_str(),
+                hpx::collectives::num_sites_arg(num_localities_),
+                hpx::collectives::this_site_arg(this_locality_));
+        }
+    }
+    else if (COMM_FLAG_ == "all_to_all")
+    {
+        communication_vec_.resize(1);
+        // setup communicators
+        basenames_.resize(1);
+        communicators_.resize(1);
+        basenames_[0] = "hpxfft_3d_slab";
+        communicators_[0] = hpx::collectives::create_communicator(
+            basenames_[0].c_str(),
+            hpx::collectives::num_sites_arg(num_localities_),
+            hpx::collectives::this_site_arg(this_locality_));
+    }
+    else
+    {
+        std::cout << "Specify communication scheme: scatter or all_to_all\n";
+        hpx::finalize();
+    }
+}
+
+void hpxfft::fft3D::distributed::loop::write_plans_to_file(std::string file_path)
+{
+    // Open file
+    FILE *file_name = fopen(file_path.c_str(), "a");
+    if (!file_name)
+    {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+    // Write first plan
+    fprintf(file_name, "FFTW r2c 1D plan:\n");
+    fftw_r2c_adapter_dir_z_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write second plan
+    fprintf(file_name, "FFTW c2c 1D plan direction y:\n");
+    fftw_c2c_adapter_dir_y_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write third plan
+    fprintf(file_name, "FFTW c2c 1D plan direction x:\n");
+    fftw_c2c_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n\n");
+    // Close file
+    fclose(file_name);
+}
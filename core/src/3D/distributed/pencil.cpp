@@ -0,0 +1,524 @@
+#include "../../../include/hpxfft/3D/distributed/pencil.hpp"
+
+#include "../../../include/hpxfft/util/thread_pools.hpp"
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+const char *const phase_names[4] = { "first", "second", "third", "fourth" };
+}  // namespace
+
+// process grid
+std::size_t hpxfft::fft3D::distributed::pencil::default_grid_rows(const std::size_t num_localities)
+{
+    std::size_t rows = 1;
+    for (std::size_t r = 1; r * r <= num_localities; ++r)
+    {
+        if (num_localities % r == 0)
+        {
+            rows = r;
+        }
+    }
+    return rows;
+}
+
+std::size_t hpxfft::fft3D::distributed::pencil::n_z_part(const std::size_t c) const
+{
+    return dim_c_z_ / n_cols_ + (c < dim_c_z_ % n_cols_ ? 1 : 0);
+}
+
+std::size_t hpxfft::fft3D::distributed::pencil::z_offset(const std::size_t c) const
+{
+    return c * (dim_c_z_ / n_cols_) + std::min(c, dim_c_z_ % n_cols_);
+}
+
+// batched FFTs of one slice
+void hpxfft::fft3D::distributed::pencil::fft_z_r2c(const std::size_t i)
+{
+    fft_r2c_adapter_dir_z_.execute(values_vec_.slice_yz(i));
+}
+
+void hpxfft::fft3D::distributed::pencil::fft_y_c2c(const std::size_t i)
+{
+    fft_c2c_adapter_dir_y_.execute(reinterpret_cast<fftw_complex *>(trans_vec_.slice_yz(i)));
+}
+
+void hpxfft::fft3D::distributed::pencil::fft_x_c2c(const std::size_t j)
+{
+    fft_c2c_adapter_dir_x_.execute(reinterpret_cast<fftw_complex *>(trans_vec_.slice_yz(j)));
+}
+
+// split data for communication
+void hpxfft::fft3D::distributed::pencil::split_z_to_y(const std::size_t i)
+{
+    for (std::size_t c = 0; c < n_cols_; ++c)
+    {
+        const std::size_t n_z = n_z_part(c);
+        const std::size_t offset = 2 * z_offset(c);
+        for (std::size_t j = 0; j < n_y_local_; ++j)
+        {
+            std::copy(values_vec_.vector_z(i, j) + offset,
+                      values_vec_.vector_z(i, j) + offset + 2 * n_z,
+                      send_vec_[c].begin() + 2 * (i * n_y_local_ + j) * n_z);
+        }
+    }
+}
+
+void hpxfft::fft3D::distributed::pencil::split_y_to_x(const std::size_t i)
+{
+    const std::size_t part = 2 * n_y_part_;
+    for (std::size_t r = 0; r < n_rows_; ++r)
+    {
+        for (std::size_t k = 0; k < n_z_local_; ++k)
+        {
+            std::copy(trans_vec_.vector_z(i, k) + r * part,
+                      trans_vec_.vector_z(i, k) + (r + 1) * part,
+                      send_vec_[r].begin() + (i * n_z_local_ + k) * part);
+        }
+    }
+}
+
+void hpxfft::fft3D::distributed::pencil::split_x_to_y(const std::size_t j)
+{
+    const std::size_t part = 2 * n_x_local_;
+    for (std::size_t r = 0; r < n_rows_; ++r)
+    {
+        for (std::size_t k = 0; k < n_z_local_; ++k)
+        {
+            std::copy(trans_vec_.vector_z(j, k) + r * part,
+                      trans_vec_.vector_z(j, k) + (r + 1) * part,
+                      send_vec_[r].begin() + (j * n_z_local_ + k) * part);
+        }
+    }
+}
+
+void hpxfft::fft3D::distributed::pencil::split_y_to_z(const std::size_t i)
+{
+    const std::size_t part = 2 * n_y_local_;
+    for (std::size_t c = 0; c < n_cols_; ++c)
+    {
+        for (std::size_t k = 0; k < n_z_local_; ++k)
+        {
+            std::copy(trans_vec_.vector_z(i, k) + c * part,
+                      trans_vec_.vector_z(i, k) + (c + 1) * part,
+                      send_vec_[c].begin() + (i * n_z_local_ + k) * part);
+        }
+    }
+}
+
+// transpose after communication:
+// block from grid column c holds (x, y, z) for the y-block of c and the z-part of this locality
+void hpxfft::fft3D::distributed::pencil::transpose_z_to_y(const std::size_t i)
+{
+    std::size_t index_in;
+    for (std::size_t c = 0; c < n_cols_; ++c)
+    {
+        const std::vector<real> &block = communication_vec_[c];
+        for (std::size_t k = 0; k < n_z_local_; ++k)
+        {
+            real *out = trans_vec_.vector_z(i, k) + 2 * c * n_y_local_;
+            for (std::size_t j = 0; j < n_y_local_; ++j)
+            {
+                index_in = 2 * ((i * n_y_local_ + j) * n_z_local_ + k);
+                out[2 * j] = block[index_in];
+                out[2 * j + 1] = block[index_in + 1];
+            }
+        }
+    }
+}
+
+// block from grid row r holds (x, z, y) for the x-block of r and the y-part of this locality
+void hpxfft::fft3D::distributed::pencil::transpose_y_to_x(const std::size_t j)
+{
+    std::size_t index_in;
+    for (std::size_t r = 0; r < n_rows_; ++r)
+    {
+        const std::vector<real> &block = communication_vec_[r];
+        for (std::size_t k = 0; k < n_z_local_; ++k)
+        {
+            real *out = trans_vec_.vector_z(j, k) + 2 * r * n_x_local_;
+            for (std::size_t i = 0; i < n_x_local_; ++i)
+            {
+                index_in = 2 * ((i * n_z_local_ + k) * n_y_part_ + j);
+                out[2 * i] = block[index_in];
+                out[2 * i + 1] = block[index_in + 1];
+            }
+        }
+    }
+}
+
+// block from grid row r holds (y, z, x) for the y-part of r and the x-block of this locality
+void hpxfft::fft3D::distributed::pencil::transpose_x_to_y(const std::size_t i)
+{
+    std::size_t index_in;
+    for (std::size_t r = 0; r < n_rows_; ++r)
+    {
+        const std::vector<real> &block = communication_vec_[r];
+        for (std::size_t k = 0; k < n_z_local_; ++k)
+        {
+            real *out = trans_vec_.vector_z(i, k) + 2 * r * n_y_part_;
+            for (std::size_t j = 0; j < n_y_part_; ++j)
+            {
+                index_in = 2 * ((j * n_z_local_ + k) * n_x_local_ + i);
+                out[2 * j] = block[index_in];
+                out[2 * j + 1] = block[index_in + 1];
+            }
+        }
+    }
+}
+
+// block from grid column c holds (x, z, y) for the z-part of c and the y-block of this locality
+void hpxfft::fft3D::distributed::pencil::transpose_y_to_z(const std::size_t i)
+{
+    std::size_t index_in;
+    for (std::size_t c = 0; c < n_cols_; ++c)
+    {
+        const std::vector<real> &block = communication_vec_[c];
+        const std::size_t n_z = n_z_part(c);
+        const std::size_t offset = 2 * z_offset(c);
+        for (std::size_t j = 0; j < n_y_local_; ++j)
+        {
+            real *out = values_vec_.vector_z(i, j) + offset;
+            for (std::size_t k = 0; k < n_z; ++k)
+            {
+                index_in = 2 * ((i * n_z + k) * n_y_local_ + j);
+                out[2 * k] = block[index_in];
+                out[2 * k + 1] = block[index_in + 1];
+            }
+        }
+    }
+}
+
+// all to all communication
+hpx::future<void> hpxfft::fft3D::distributed::pencil::communicate(const std::size_t phase)
+{
+    // z <-> y within the grid row, y <-> x within the grid column
+    const bool row = phase == 0 || phase == 3;
+    hpx::collectives::communicator &communicator = row ? row_communicator_ : col_communicator_;
+    const std::size_t generation = row ? ++row_generation_ : ++col_generation_;
+    return hpx::collectives::all_to_all(
+               communicator, std::move(send_vec_), hpx::collectives::generation_arg(generation))
+        .then(communication_executor_, [this](hpx::future<vector_comm> r) { communication_vec_ = r.get(); });
+}
+
+hpx::future<void> hpxfft::fft3D::distributed::pencil::exchange(const std::size_t phase)
+{
+    // loops feeding a collective are critical and run with high priority
+    const auto policy = hpx::execution::par(hpx::execution::task).on(compute_executor_);
+    const auto critical_policy = hpx::execution::par(hpx::execution::task)
+                                     .on(hpx::execution::experimental::with_priority(
+                                         compute_executor_, hpx::threads::thread_priority::high));
+    start_split_[phase] = t_.now();
+    // the previous exchange moved the buffers out
+    const bool row = phase == 0 || phase == 3;
+    send_vec_.resize(row ? n_cols_ : n_rows_);
+    for (std::size_t p = 0; p < send_vec_.size(); ++p)
+    {
+        std::size_t block_size = 2 * n_x_local_ * n_z_local_ * n_y_part_;
+        if (phase == 0)
+        {
+            block_size = 2 * n_x_local_ * n_y_local_ * n_z_part(p);
+        }
+        else if (phase == 3)
+        {
+            block_size = 2 * n_x_local_ * n_y_local_ * n_z_local_;
+        }
+        send_vec_[p].resize(block_size);
+    }
+    hpx::future<void> split;
+    switch (phase)
+    {
+    case 0:
+        split = hpx::experimental::for_loop(
+            critical_policy, 0, n_x_local_, [this](auto i) { split_z_to_y(i); });
+        break;
+    case 1:
+        split = hpx::experimental::for_loop(
+            critical_policy, 0, n_x_local_, [this](auto i) { split_y_to_x(i); });
+        break;
+    case 2:
+        split = hpx::experimental::for_loop(
+            critical_policy, 0, n_y_part_, [this](auto j) { split_x_to_y(j); });
+        break;
+    default:
+        split = hpx::experimental::for_loop(
+            critical_policy, 0, n_x_local_, [this](auto i) { split_y_to_z(i); });
+        break;
+    }
+    return split
+        .then(
+            [this, phase](hpx::future<void> r)
+            {
+                r.get();
+                start_comm_[phase] = t_.now();
+                // collectives are started on the communication pool
+                hpx::future<void> received = hpx::async(communication_executor_, &pencil::communicate, this, phase);
+                return received;
+            })
+        .then(
+            [this, phase, policy, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_trans_[phase] = t_.now();
+                switch (phase)
+                {
+                case 0:
+                    // y-pencils (x, z, y)
+                    trans_vec_.rearrange(n_x_local_, n_z_local_, 2 * dim_c_y_);
+                    return hpx::experimental::for_loop(
+                        critical_policy, 0, n_x_local_, [this](auto i) { transpose_z_to_y(i); });
+                case 1:
+                    // x-pencils (y, z, x)
+                    trans_vec_.rearrange(n_y_part_, n_z_local_, 2 * dim_c_x_);
+                    return hpx::experimental::for_loop(
+                        critical_policy, 0, n_y_part_, [this](auto j) { transpose_y_to_x(j); });
+                case 2:
+                    // y-pencils (x, z, y)
+                    trans_vec_.rearrange(n_x_local_, n_z_local_, 2 * dim_c_y_);
+                    return hpx::experimental::for_loop(
+                        critical_policy, 0, n_x_local_, [this](auto i) { transpose_x_to_y(i); });
+                default:
+                    // z-pencils (x, y, z)
+                    return hpx::experimental::for_loop(
+                        policy, 0, n_x_local_, [this](auto i) { transpose_y_to_z(i); });
+                }
+            });
+}
+
+// 3D FFT algorithm
+hpxfft::fft3D::distributed::vector_3d hpxfft::fft3D::distributed::pencil::fft_3d_r2c()
+{
+    return fft_3d_r2c_async().get();
+}
+
+hpx::future<hpxfft::fft3D::distributed::vector_3d> hpxfft::fft3D::distributed::pencil::fft_3d_r2c_async()
+{
+    const auto critical_policy = hpx::execution::par(hpx::execution::task)
+                                     .on(hpx::execution::experimental::with_priority(
+                                         compute_executor_, hpx::threads::thread_priority::high));
+    /////////////////////////////////////////////////////////////////
+    // first dimension
+    start_total_ = t_.now();
+    start_fft_[0] = start_total_;
+    return hpx::experimental::for_loop(critical_policy,
+                                       0,
+                                       n_x_local_,
+                                       [this](auto i)
+                                       {
+                                           // batched 1D FFT r2c in z-direction
+                                           fft_z_r2c(i);
+                                       })
+        // communication within grid row for FFT in second dimension
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                return exchange(0);
+            })
+        // second dimension
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_fft_[1] = t_.now();
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_x_local_,
+                                                   [this](auto i)
+                                                   {
+                                                       // batched 1D FFT c2c in y-direction
+                                                       fft_y_c2c(i);
+                                                   });
+            })
+        // communication within grid column for FFT in third dimension
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                return exchange(1);
+            })
+        // third dimension
+        .then(
+            [this, critical_policy](hpx::future<void> r)
+            {
+                r.get();
+                start_fft_[2] = t_.now();
+                return hpx::experimental::for_loop(critical_policy,
+                                                   0,
+                                                   n_y_part_,
+                                                   [this](auto j)
+                                                   {
+                                                       // batched 1D FFT c2c in x-direction
+                                                       fft_x_c2c(j);
+                                                   });
+            })
+        // communication to get original data layout
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                return exchange(2);
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                return exchange(3);
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_split_[0] - start_fft_[0];
+                measurements_["second_fftw"] = start_split_[1] - start_fft_[1];
+                measurements_["third_fftw"] = start_split_[2] - start_fft_[2];
+                for (std::size_t phase = 0; phase < 4; ++phase)
+                {
+                    const std::string name = phase_names[phase];
+                    const real stop_phase = phase == 0 ? start_fft_[1]
+                                          : phase == 1 ? start_fft_[2]
+                                          : phase == 2 ? start_split_[3]
+                                                       : stop_total;
+                    measurements_[name + "_split"] = start_comm_[phase] - start_split_[phase];
+                    measurements_[name + "_comm"] = start_trans_[phase] - start_comm_[phase];
+                    measurements_[name + "_trans"] = stop_phase - start_trans_[phase];
+                }
+                ////////////////////////////////////////////////////////////////
+                return std::move(values_vec_);
+            });
+}
+
+// initialization
+void hpxfft::fft3D::distributed::pencil::initialize(hpxfft::fft3D::distributed::vector_3d values_vec,
+                                                    const std::size_t P_ROW,
+                                                    const std::string PLAN_FLAG)
+{
+    // move data into own structure
+    values_vec_ = std::move(values_vec);
+    // process grid
+    this_locality_ = hpx::get_locality_id();
+    num_localities_ = hpx::get_num_localities(hpx::launch::sync);
+    n_rows_ = P_ROW == 0 ? default_grid_rows(num_localities_) : P_ROW;
+    if (num_localities_ % n_rows_ != 0)
+    {
+        throw std::invalid_argument("Number of grid rows has to divide the number of localities");
+    }
+    n_cols_ = num_localities_ / n_rows_;
+    this_row_ = this_locality_ / n_cols_;
+    this_col_ = this_locality_ % n_cols_;
+    // parameters
+    n_x_local_ = values_vec_.n_x();
+    n_y_local_ = values_vec_.n_y();
+    dim_c_x_ = n_x_local_ * n_rows_;
+    dim_c_y_ = n_y_local_ * n_cols_;
+    dim_c_z_ = values_vec_.n_z() / 2;
+    dim_r_z_ = 2 * dim_c_z_ - 2;
+    if (dim_c_y_ % n_rows_ != 0)
+    {
+        throw std::invalid_argument("Pencil decomposition requires n_y to be divisible by the grid rows");
+    }
+    if (dim_c_z_ < n_cols_)
+    {
+        throw std::invalid_argument("Pencil decomposition requires n_z / 2 + 1 to be at least the grid columns");
+    }
+    n_y_part_ = dim_c_y_ / n_rows_;
+    n_z_local_ = n_z_part(this_col_);
+    // resize transposed data structure, y- and x-pencils have the same size
+    trans_vec_ = vector_3d(n_x_local_, n_z_local_, 2 * dim_c_y_);
+    // create FFTW plans on a scratch slice, planning must not overwrite the input
+    PLAN_FLAG_ = PLAN_FLAG;
+    auto start_plan = t_.now();
+    std::vector<real> scratch(
+        std::max({ values_vec_.n_y() * values_vec_.n_z(), 2 * n_z_local_ * dim_c_y_, 2 * n_z_local_ * dim_c_x_ }));
+    // plans run on the x-slices of the values and the transposed pencils
+    const bool aligned_z = hpxfft::util::fftw_adapter::keeps_alignment(
+        scratch.data(), values_vec_.data(), values_vec_.n_y() * values_vec_.n_z());
+    const bool aligned_y = hpxfft::util::fftw_adapter::keeps_alignment(
+        scratch.data(), trans_vec_.data(), 2 * n_z_local_ * dim_c_y_);
+    const bool aligned_x = hpxfft::util::fftw_adapter::keeps_alignment(
+        scratch.data(), trans_vec_.data(), 2 * n_z_local_ * dim_c_x_);
+    // r2c in z-direction, one plan per x-slice
+    fft_r2c_adapter_dir_z_ = hpxfft::util::fft_backend::r2c_1d_many();
+    fft_r2c_adapter_dir_z_.plan(
+        static_cast<int>(dim_r_z_), static_cast<int>(n_y_local_), PLAN_FLAG_, scratch.data(), aligned_z);
+    // c2c in y-direction, one plan per x-slice
+    fft_c2c_adapter_dir_y_ = hpxfft::util::fft_backend::c2c_1d_many();
+    fft_c2c_adapter_dir_y_.plan(static_cast<int>(dim_c_y_),
+                                static_cast<int>(n_z_local_),
+                                1,
+                                static_cast<int>(dim_c_y_),
+                                PLAN_FLAG_,
+                                reinterpret_cast<fftw_complex *>(scratch.data()),
+                                hpxfft::util::fftw_adapter::direction::forward,
+                                aligned_y);
+    // c2c in x-direction, one plan per y-slice
+    fft_c2c_adapter_dir_x_ = hpxfft::util::fft_backend::c2c_1d_many();
+    fft_c2c_adapter_dir_x_.plan(static_cast<int>(dim_c_x_),
+                                static_cast<int>(n_z_local_),
+                                1,
+                                static_cast<int>(dim_c_x_),
+                                PLAN_FLAG_,
+                                reinterpret_cast<fftw_complex *>(scratch.data()),
+                                hpxfft::util::fftw_adapter::direction::forward,
+                                aligned_x);
+    auto stop_plan = t_.now();
+    measurements_["plan"] = stop_plan - start_plan;
+    // compute local plan flops
+    double add_z, mul_z, fma_z;
+    fft_r2c_adapter_dir_z_.flops(&add_z, &mul_z, &fma_z);
+    double add_y, mul_y, fma_y;
+    fft_c2c_adapter_dir_y_.flops(&add_y, &mul_y, &fma_y);
+    double add_x, mul_x, fma_x;
+    fft_c2c_adapter_dir_x_.flops(&add_x, &mul_x, &fma_x);
+    measurements_["plan_flops"] = n_x_local_ * (add_z + mul_z + fma_z) + n_x_local_ * (add_y + mul_y + fma_y)
+                                + n_y_part_ * (add_x + mul_x + fma_x);
+    // thread pools
+    // collectives are on the critical path
+    communication_executor_ = hpx::execution::experimental::with_priority(hpxfft::util::communication_executor(),
+                                                                          hpx::threads::thread_priority::high);
+    compute_executor_ = hpxfft::util::compute_executor();
+    // sub-communicators of the grid row and the grid column
+    row_generation_ = 0;
+    col_generation_ = 0;
+    row_basename_ = "hpxfft_3d_pencil_row_" + std::to_string(this_row_);
+    col_basename_ = "hpxfft_3d_pencil_col_" + std::to_string(this_col_);
+    row_communicator_ = hpx::collectives::create_communicator(row_basename_.c_str(),
+                                                              hpx::collectives::num_sites_arg(n_cols_),
+                                                              hpx::collectives::this_site_arg(this_col_));
+    col_communicator_ = hpx::collectives::create_communicator(col_basename_.c_str(),
+                                                              hpx::collectives::num_sites_arg(n_rows_),
+                                                              hpx::collectives::this_site_arg(this_row_));
+}
+
+// helpers
+real hpxfft::fft3D::distributed::pencil::get_measurement(std::string name) { return measurements_[name]; }
+
+void hpxfft::fft3D::distributed::pencil::write_plans_to_file(std::string file_path)
+{
+    // Open file
+    FILE *file_name = fopen(file_path.c_str(), "a");
+    if (!file_name)
+    {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+    // Write first plan
+    fprintf(file_name, "FFTW r2c 1D batched plan:\n");
+    fft_r2c_adapter_dir_z_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write second plan
+    fprintf(file_name, "FFTW c2c 1D batched plan direction y:\n");
+    fft_c2c_adapter_dir_y_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write third plan
+    fprintf(file_name, "FFTW c2c 1D batched plan direction x:\n");
+    fft_c2c_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n\n");
+    // Close file
+    fclose(file_name);
+}
@@ -1,6 +1,10 @@
 #include "../../../include/hpxfft/3D/shared/loop.hpp"
 
-void hpxfft::fft3D::shared::loop::initialize(vector_3d values_vec, const std::string PLAN_FLAG)
+#include <algorithm>
+
+void hpxfft::fft3D::shared::loop::initialize(vector_3d values_vec,
+                                             const std::string PLAN_FLAG,
+                                             const std::size_t TILE_DIM)
 {
     values_vec_ = std::move(values_vec);
     dim_c_x_ = values_vec_.n_x();
@@ -9,23 +13,11 @@ void hpxfft::fft3D::shared::loop::initialize(vector_3d values_vec, const std::st
     dim_r_z_ = 2 * dim_c_z_ - 2;
     //resize transposed data structure
     permuted_vec_ = vector_3d(dim_c_x_, dim_c_z_, 2*dim_c_y_);
-    PLAN_FLAG_ = hpxfft::util::string_to_fftw_plan_flag(PLAN_FLAG);
+    PLAN_FLAG_ = PLAN_FLAG;
+    dim_tile_ = std::max(TILE_DIM, std::size_t(1));
     auto start_plan = t_.now();
-    // initialize FFTW adapters
-    fftw_r2c_adapter_dir_z_ = hpxfft::util::fftw_adapter_r2c();
-    fftw_r2c_adapter_dir_z_.initialize(dim_r_z_, PLAN_FLAG_,
-                                      permuted_vec_.slice_yz(0),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)));
-    fftw_c2c_adapter_dir_y_ = hpxfft::util::fftw_adapter_c2c();
-    fftw_c2c_adapter_dir_y_.initialize(dim_c_y_, PLAN_FLAG_,
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      hpxfft::util::fftw_direction::forward);
-    fftw_c2c_adapter_dir_x_ = hpxfft::util::fftw_adapter_c2c();
-    fftw_c2c_adapter_dir_x_.initialize(dim_c_x_, PLAN_FLAG_,
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      hpxfft::util::fftw_direction::forward);
+    // batched plans per slice, planning must not overwrite the input
+    plan_slices(permuted_vec_.data());
     auto stop_plan = t_.now();
     measurements_["plan"] = stop_plan - start_plan;
     // compute overall plan flops
@@ -35,102 +27,134 @@ void hpxfft::fft3D::shared::loop::initialize(vector_3d values_vec, const std::st
     fftw_c2c_adapter_dir_y_.flops(&add_y, &mul_y, &fma_y);
     double add_x, mul_x, fma_x;
     fftw_c2c_adapter_dir_x_.flops(&add_x, &mul_x, &fma_x);
-    measurements_["plan_flops"] = dim_r_z_ * (add_z + mul_z + fma_z)
-                                + dim_c_y_ * (add_y + mul_y + fma_y)
-                                + dim_c_x_ * (add_x + mul_x + fma_x);
+    measurements_["plan_flops"] = dim_c_x_ * (add_z + mul_z + fma_z)
+                                + dim_c_x_ * (add_y + mul_y + fma_y)
+                                + dim_c_y_ * (add_x + mul_x + fma_x);
+}
+
+void hpxfft::fft3D::shared::loop::set_values(vector_3d values_vec)
+{
+    swap_in_values(std::move(values_vec));
 }
 
 hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_r2c_par()
 {
-     /////////////////////////////////////////////////////////////////
+    return fft_3d_r2c_async().get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::loop::fft_3d_r2c_async()
+{
+    const auto policy = hpx::execution::par(hpx::execution::task);
+    /////////////////////////////////////////////////////////////////
     // first dimension
-    auto start_total = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
+    start_total_ = t_.now();
+    return hpx::experimental::for_loop(
+        policy,
         0,
         dim_c_x_,
-        [&](auto i)
+        [this](auto i)
         {
-            for (std::size_t j = 0; j < dim_c_y_; ++j)
+            // batched 1D FFT r2c in z-direction
+            fft_1d_r2c_slice(i);
+        })
+        .then(
+            [this, policy](hpx::future<void> r)
             {
-                // 1D FFT r2c in z-direction
-                fft_1d_r2c_inplace(i, j);
-            }
-        });
-    auto start_first_permute = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_x_,
-        [&](auto i)
-        {
-            // permute from x-y-z to x-z-y
-            permute_shared_x_z_y(i);
-        });
-    // second dimension
-
-    auto start_second_fft = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_x_,
-        [&](auto i)
-        {
-            for (std::size_t j = 0; j < dim_c_z_; ++j)
+                r.get();
+                start_first_permute_ = t_.now();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_x_,
+                    [this](auto i)
+                    {
+                        // permute from x-y-z to x-z-y
+                        permute_shared_x_z_y(i);
+                    });
+            })
+        // second dimension
+        .then(
+            [this, policy](hpx::future<void> r)
             {
-                // 1D FFT c2c in y-direction
-                fft_1d_c2c_y_inplace(i, j);
-            }
-    });
-    auto start_second_permute = t_.now();
-    values_vec_ = vector_3d(dim_c_y_, dim_c_z_, 2*dim_c_x_);
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_z_,
-        [&](auto i)
-        {
-            // permute from x-z-y to y-z-x
-            permute_shared_z_y_x(i);
-        });
-
-    // third dimension
-    auto start_third_fft = t_.now();
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_y_,
-        [&](auto i)
-        {
-            for (std::size_t j = 0; j < dim_c_z_; ++j)
+                r.get();
+                start_second_fft_ = t_.now();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_x_,
+                    [this](auto i)
+                    {
+                        // batched 1D FFT c2c in y-direction
+                        fft_1d_c2c_y_slice(i);
+                    });
+            })
+        .then(
+            [this, policy](hpx::future<void> r)
             {
-                // 1D FFT c2c in x-direction
-                fft_1d_c2c_x_inplace(i, j);
-            }
-        });
-    auto start_third_permute = t_.now();
-    permuted_vec_ = vector_3d(dim_c_x_, dim_c_y_, 2*dim_c_z_);
-    hpx::experimental::for_loop(
-        hpx::execution::par,
-        0,
-        dim_c_y_,
-        [&](auto i)
-        {
-            // permute from y-z-x to x-y-z
-            permute_shared_z_x_y(i);
-        });
-    auto stop_total = t_.now();
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
-    measurements_["first_fftw"] = start_first_permute - start_total;
-    measurements_["first_permute"] = start_second_fft - start_first_permute;
-    measurements_["second_fftw"] = start_second_permute - start_second_fft;
-    measurements_["second_permute"] = start_third_fft - start_second_permute;
-    measurements_["third_fftw"] = start_third_permute - start_third_fft;
-    measurements_["third_permute"] = stop_total - start_third_permute;
-    ///////////////////////////////////////////////////////////////
-    return std::move(permuted_vec_);
+                r.get();
+                start_second_permute_ = t_.now();
+                // input is consumed, reuse as y-z-x target
+                values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_z_,
+                    [this](auto i)
+                    {
+                        // permute from x-z-y to y-z-x
+                        permute_shared_z_y_x(i);
+                    });
+            })
+        // third dimension
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                start_third_fft_ = t_.now();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_y_,
+                    [this](auto i)
+                    {
+                        // batched 1D FFT c2c in x-direction
+                        fft_1d_c2c_x_slice(i);
+                    });
+            })
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                start_third_permute_ = t_.now();
+                // reuse as x-y-z target
+                permuted_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_y_,
+                    [this](auto i)
+                    {
+                        // permute from y-z-x to x-y-z
+                        permute_shared_z_x_y(i);
+                    });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_first_permute_ - start_total_;
+                measurements_["first_permute"] = start_second_fft_ - start_first_permute_;
+                measurements_["second_fftw"] = start_second_permute_ - start_second_fft_;
+                measurements_["second_permute"] = start_third_fft_ - start_second_permute_;
+                measurements_["third_fftw"] = start_third_permute_ - start_third_fft_;
+                measurements_["third_permute"] = stop_total - start_third_permute_;
+                ///////////////////////////////////////////////////////////////
+                return std::move(permuted_vec_);
+            });
 }
 
 hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_r2c_seq()
@@ -140,11 +164,8 @@ hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_r2c_seq()
     auto start_total = t_.now();
     for (std::size_t i = 0; i < dim_c_x_; ++i)
     {
-        for (std::size_t j = 0; j < dim_c_y_; ++j)
-        {
-            // 1D FFT r2c in z-direction
-            fft_1d_r2c_inplace(i, j);
-        }
+        // batched 1D FFT r2c in z-direction
+        fft_1d_r2c_slice(i);
     }
     auto start_first_permute = t_.now();
     for (std::size_t i = 0; i < dim_c_x_; ++i)
@@ -156,14 +177,12 @@ hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_r2c_seq()
     auto start_second_fft = t_.now();
     for (std::size_t i = 0; i < dim_c_x_; ++i)
     {
-        for (std::size_t j = 0; j < dim_c_z_; ++j)
-        {
-            // 1D FFT c2c in y-direction
-            fft_1d_c2c_y_inplace(i, j);
-        }
+        // batched 1D FFT c2c in y-direction
+        fft_1d_c2c_y_slice(i);
     }
     auto start_second_permute = t_.now();
-    values_vec_ = vector_3d(dim_c_y_, dim_c_z_, 2*dim_c_x_);
+    // input is consumed, reuse as y-z-x target
+    values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
     for (std::size_t i = 0; i < dim_c_z_; ++i)
     {
         // permute from x-z-y to y-z-x
@@ -173,14 +192,12 @@ hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_r2c_seq()
     auto start_third_fft = t_.now();
     for (std::size_t i = 0; i < dim_c_y_; ++i)
     {
-        for (std::size_t j = 0; j < dim_c_z_; ++j)
-        {
-            // 1D FFT c2c in x-direction
-            fft_1d_c2c_x_inplace(i, j);
-        }
+        // batched 1D FFT c2c in x-direction
+        fft_1d_c2c_x_slice(i);
     }
     auto start_third_permute = t_.now();
-    permuted_vec_ = vector_3d(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+    // reuse as x-y-z target
+    permuted_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
     for (std::size_t i = 0; i < dim_c_y_; ++i)
     {
         // permute from y-z-x to x-y-z
@@ -200,6 +217,141 @@ hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_r2c_seq()
     return std::move(permuted_vec_);
 }
 
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_c2r_par(vector_3d values_vec)
+{
+    return fft_3d_c2r_async(std::move(values_vec)).get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::loop::fft_3d_c2r_async(vector_3d values_vec)
+{
+    const auto policy = hpx::execution::par(hpx::execution::task);
+    start_inverse_total_ = t_.now();
+    swap_in_spectrum(std::move(values_vec));
+    values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
+    return hpx::experimental::for_loop(
+        policy,
+        0,
+        dim_c_x_,
+        [this](auto i)
+        {
+            // permute from x-y-z to y-z-x
+            permute_inverse_y_z_x(i);
+        })
+        // third dimension
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_y_,
+                    [this](auto i)
+                    {
+                        // batched backward 1D FFT c2c in x-direction
+                        fft_1d_c2c_x_inv_slice(i);
+                    });
+            })
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                // spectrum is consumed, reuse as x-z-y target
+                permuted_vec_.rearrange(dim_c_x_, dim_c_z_, 2*dim_c_y_);
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_z_,
+                    [this](auto i)
+                    {
+                        // permute from y-z-x to x-z-y
+                        permute_inverse_x_z_y(i);
+                    });
+            })
+        // second dimension
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_x_,
+                    [this](auto i)
+                    {
+                        // batched backward 1D FFT c2c in y-direction
+                        fft_1d_c2c_y_inv_slice(i);
+                    });
+            })
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                // reuse as x-y-z target
+                values_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_x_,
+                    [this](auto i)
+                    {
+                        // permute from x-z-y to x-y-z
+                        permute_inverse_x_y_z(i);
+                        // batched 1D FFT c2r in z-direction, the slice is complete
+                        fft_1d_c2r_slice(i);
+                    });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                measurements_["inverse_total"] = t_.now() - start_inverse_total_;
+                return std::move(values_vec_);
+            });
+}
+
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::loop::fft_3d_c2r_seq(vector_3d values_vec)
+{
+    auto start_total = t_.now();
+    swap_in_spectrum(std::move(values_vec));
+    values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
+    for (std::size_t i = 0; i < dim_c_x_; ++i)
+    {
+        // permute from x-y-z to y-z-x
+        permute_inverse_y_z_x(i);
+    }
+    // third dimension
+    for (std::size_t i = 0; i < dim_c_y_; ++i)
+    {
+        // batched backward 1D FFT c2c in x-direction
+        fft_1d_c2c_x_inv_slice(i);
+    }
+    // spectrum is consumed, reuse as x-z-y target
+    permuted_vec_.rearrange(dim_c_x_, dim_c_z_, 2*dim_c_y_);
+    for (std::size_t i = 0; i < dim_c_z_; ++i)
+    {
+        // permute from y-z-x to x-z-y
+        permute_inverse_x_z_y(i);
+    }
+    // second dimension
+    for (std::size_t i = 0; i < dim_c_x_; ++i)
+    {
+        // batched backward 1D FFT c2c in y-direction
+        fft_1d_c2c_y_inv_slice(i);
+    }
+    // reuse as x-y-z target
+    values_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+    for (std::size_t i = 0; i < dim_c_x_; ++i)
+    {
+        // permute from x-z-y to x-y-z
+        permute_inverse_x_y_z(i);
+        // batched 1D FFT c2r in z-direction
+        fft_1d_c2r_slice(i);
+    }
+    measurements_["inverse_total"] = t_.now() - start_total;
+    return std::move(values_vec_);
+}
+
 void hpxfft::fft3D::shared::loop::write_plans_to_file(std::string file_path)
 {
     // Open file
@@ -210,15 +362,25 @@ void hpxfft::fft3D::shared::loop::write_plans_to_file(std::string file_path)
     }
     // Write first plan
     fprintf(file_name, "FFTW r2c 1D plan:\n");
-    fftw_r2c_adapter_dir_z_.fprintf_plan(file_name);
+    fftw_r2c_adapter_dir_z_.print_plan(file_name);
     fprintf(file_name, "\n");
     // Write second plan
     fprintf(file_name, "FFTW c2c 1D plan direction y:\n");
-    fftw_c2c_adapter_dir_y_.fprintf_plan(file_name);
+    fftw_c2c_adapter_dir_y_.print_plan(file_name);
     fprintf(file_name, "\n");
     // Write third plan
     fprintf(file_name, "FFTW c2c 1D plan direction x:\n");
-    fftw_c2c_adapter_dir_x_.fprintf_plan(file_name);
+    fftw_c2c_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write inverse plans
+    fprintf(file_name, "FFTW backward c2c 1D plan direction x:\n");
+    fftw_c2c_inv_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW backward c2c 1D plan direction y:\n");
+    fftw_c2c_inv_adapter_dir_y_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW c2r 1D plan:\n");
+    fftw_c2r_adapter_dir_z_.print_plan(file_name);
     fprintf(file_name, "\n\n");
     // Close file
     fclose(file_name);
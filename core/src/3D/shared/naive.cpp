@@ -1,6 +1,10 @@
 #include "../../../include/hpxfft/3D/shared/naive.hpp"
 
-void hpxfft::fft3D::shared::naive::initialize(vector_3d values_vec, const std::string PLAN_FLAG)
+#include <algorithm>
+
+void hpxfft::fft3D::shared::naive::initialize(vector_3d values_vec,
+                                              const std::string PLAN_FLAG,
+                                              const std::size_t TILE_DIM)
 {
     values_vec_ = std::move(values_vec);
     dim_c_x_ = values_vec_.n_x();
@@ -9,23 +13,11 @@ void hpxfft::fft3D::shared::naive::initialize(vector_3d values_vec, const std::s
     dim_r_z_ = 2 * dim_c_z_ - 2;
     //resize transposed data structure
     permuted_vec_ = vector_3d(dim_c_x_, dim_c_z_, 2*dim_c_y_);
-    PLAN_FLAG_ = hpxfft::util::string_to_fftw_plan_flag(PLAN_FLAG);
+    PLAN_FLAG_ = PLAN_FLAG;
+    dim_tile_ = std::max(TILE_DIM, std::size_t(1));
     auto start_plan = t_.now();
-   // initialize FFTW adapters
-    fftw_r2c_adapter_dir_z_ = hpxfft::util::fftw_adapter_r2c();
-    fftw_r2c_adapter_dir_z_.initialize(dim_r_z_, PLAN_FLAG_,
-                                      permuted_vec_.slice_yz(0),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)));
-    fftw_c2c_adapter_dir_y_ = hpxfft::util::fftw_adapter_c2c();
-    fftw_c2c_adapter_dir_y_.initialize(dim_c_y_, PLAN_FLAG_,
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      hpxfft::util::fftw_direction::forward);
-    fftw_c2c_adapter_dir_x_ = hpxfft::util::fftw_adapter_c2c();
-    fftw_c2c_adapter_dir_x_.initialize(dim_c_x_, PLAN_FLAG_,
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      hpxfft::util::fftw_direction::forward);
+    // batched plans per slice, planning must not overwrite the input
+    plan_slices(permuted_vec_.data());
     auto stop_plan = t_.now();
     measurements_["plan"] = stop_plan - start_plan;
     // compute overall plan flops
@@ -35,32 +27,37 @@ void hpxfft::fft3D::shared::naive::initialize(vector_3d values_vec, const std::s
     fftw_c2c_adapter_dir_y_.flops(&add_y, &mul_y, &fma_y);
     double add_x, mul_x, fma_x;
     fftw_c2c_adapter_dir_x_.flops(&add_x, &mul_x, &fma_x);
-    measurements_["plan_flops"] = dim_r_z_ * (add_z + mul_z + fma_z)
-                                + dim_c_y_ * (add_y + mul_y + fma_y)
-                                + dim_c_x_ * (add_x + mul_x + fma_x);
+    measurements_["plan_flops"] = dim_c_x_ * (add_z + mul_z + fma_z)
+                                + dim_c_x_ * (add_y + mul_y + fma_y)
+                                + dim_c_y_ * (add_x + mul_x + fma_x);
     // resize futures
-    fft_z_r2c_futures_.resize(dim_c_x_*dim_c_y_);
+    fft_z_r2c_futures_.resize(dim_c_x_);
     permute_first_futures_.resize(dim_c_x_);
-    fft_y_c2c_futures_.resize(dim_c_x_*dim_c_z_);
+    fft_y_c2c_futures_.resize(dim_c_x_);
     permute_second_futures_.resize(dim_c_z_);
-    fft_x_c2c_futures_.resize(dim_c_y_*dim_c_z_);
+    fft_x_c2c_futures_.resize(dim_c_y_);
     permute_third_futures_.resize(dim_c_y_);
     }
 
-// wrapper for fft_1d_r2c_inplace to use with hpx::async
-void hpxfft::fft3D::shared::naive::fft_1d_r2c_inplace_wrapper(naive *th, const std::size_t i, const std::size_t j)
+void hpxfft::fft3D::shared::naive::set_values(vector_3d values_vec)
 {
-    th->fft_1d_r2c_inplace(i, j);
+    swap_in_values(std::move(values_vec));
 }
 
-void hpxfft::fft3D::shared::naive::fft_1d_c2c_y_inplace_wrapper(naive *th, const std::size_t i, const std::size_t j)
+// wrapper for fft_1d_r2c_slice to use with hpx::async
+void hpxfft::fft3D::shared::naive::fft_1d_r2c_slice_wrapper(naive *th, const std::size_t i)
 {
-    th->fft_1d_c2c_y_inplace(i, j);
+    th->fft_1d_r2c_slice(i);
 }
 
-void hpxfft::fft3D::shared::naive::fft_1d_c2c_x_inplace_wrapper(naive *th, const std::size_t i, const std::size_t j)
+void hpxfft::fft3D::shared::naive::fft_1d_c2c_y_slice_wrapper(naive *th, const std::size_t i)
 {
-    th->fft_1d_c2c_x_inplace(i, j);
+    th->fft_1d_c2c_y_slice(i);
+}
+
+void hpxfft::fft3D::shared::naive::fft_1d_c2c_x_slice_wrapper(naive *th, const std::size_t i)
+{
+    th->fft_1d_c2c_x_slice(i);
 }
 
 void hpxfft::fft3D::shared::naive::permute_shared_x_z_y_wrapper(naive *th, const std::size_t slice_x)
@@ -73,107 +70,200 @@ void hpxfft::fft3D::shared::naive::permute_shared_z_y_x_wrapper(naive *th, const
     th->permute_shared_z_y_x(slice_y);
 }
 
-void hpxfft::fft3D::shared::naive::permute_shared_z_x_y_wrapper(naive *th, const std::size_t slice_x)
+void hpxfft::fft3D::shared::naive::permute_shared_z_x_y_wrapper(naive *th, const std::size_t slice_y)
+{
+    th->permute_shared_z_x_y(slice_y);
+}
+
+void hpxfft::fft3D::shared::naive::fft_1d_c2c_x_inv_slice_wrapper(naive *th, const std::size_t i)
+{
+    th->fft_1d_c2c_x_inv_slice(i);
+}
+
+void hpxfft::fft3D::shared::naive::fft_1d_c2c_y_inv_slice_wrapper(naive *th, const std::size_t i)
+{
+    th->fft_1d_c2c_y_inv_slice(i);
+}
+
+void hpxfft::fft3D::shared::naive::fft_1d_c2r_slice_wrapper(naive *th, const std::size_t i)
+{
+    th->fft_1d_c2r_slice(i);
+}
+
+void hpxfft::fft3D::shared::naive::permute_inverse_y_z_x_wrapper(naive *th, const std::size_t slice_x)
+{
+    th->permute_inverse_y_z_x(slice_x);
+}
+
+void hpxfft::fft3D::shared::naive::permute_inverse_x_z_y_wrapper(naive *th, const std::size_t slice_z)
 {
-    th->permute_shared_z_x_y(slice_x);
+    th->permute_inverse_x_z_y(slice_z);
+}
+
+void hpxfft::fft3D::shared::naive::permute_inverse_x_y_z_wrapper(naive *th, const std::size_t slice_x)
+{
+    th->permute_inverse_x_y_z(slice_x);
 }
 
 hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::naive::fft_3d_r2c()
+{
+    return fft_3d_r2c_async().get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::naive::fft_3d_r2c_async()
 {
     auto start_total = t_.now();
 
     /////////////////////////////////////////////////////////////////
-    // First dimension (Z)
+    // First (Z) and second (Y) dimension: every x-slice flows independently
+    // FFT z -> permute (X, Y, Z) -> (X, Z, Y) -> FFT y, the slices do not share data
     for (std::size_t i = 0; i < dim_c_x_; ++i)
     {
-        for (std::size_t j = 0; j < dim_c_y_; ++j)
-        {
-            fft_z_r2c_futures_[i*dim_c_y_ + j] = hpx::async(&fft_1d_r2c_inplace_wrapper, this, i, j);
-        }
-    }
-    hpx::shared_future<vector_future> all_fft_z_r2c_futures = hpx::when_all(fft_z_r2c_futures_);
-    
-    /////////////////////////////////////////////////////////////////
-    // Permute (X, Y, Z) -> (X, Z, Y)
-    for (std::size_t slice_x = 0; slice_x < dim_c_x_; ++slice_x)
-    {
-        permute_first_futures_[slice_x] = all_fft_z_r2c_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
+        fft_z_r2c_futures_[i] = hpx::async(&fft_1d_r2c_slice_wrapper, this, i);
+        permute_first_futures_[i] = fft_z_r2c_futures_[i].then(
+            [=, this](hpx::future<void> r)
             {
                 r.get();
-                return hpx::async(&permute_shared_x_z_y_wrapper, this, slice_x);
+                return hpx::async(&permute_shared_x_z_y_wrapper, this, i);
+            });
+        fft_y_c2c_futures_[i] = permute_first_futures_[i].then(
+            [=, this](hpx::future<void> r)
+            {
+                r.get();
+                return hpx::async(&fft_1d_c2c_y_slice_wrapper, this, i);
             });
     }
-    hpx::shared_future<vector_future> all_permute_first_futures = hpx::when_all(permute_first_futures_);
-    
-    /////////////////////////////////////////////////////////////////
-    // Second dimension (Y)
-    for (std::size_t i = 0; i < dim_c_x_; ++i)
-    {
-        for (std::size_t j = 0; j < dim_c_z_; ++j)
-        {
-            fft_y_c2c_futures_[i*dim_c_z_ + j] = all_permute_first_futures.then(
-                [=, this](hpx::shared_future<vector_future> r)
-                {
-                    r.get();
-                    return hpx::async(&fft_1d_c2c_y_inplace_wrapper, this, i, j);
-                });
-        }
-    }
-    hpx::shared_future<vector_future> all_fft_y_c2c_futures = hpx::when_all(fft_y_c2c_futures_);
-    all_permute_first_futures.get();
-    values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
-    
+
     /////////////////////////////////////////////////////////////////
     // Permute (X, Z, Y) -> (Y, Z, X)
-    for (std::size_t slice_y = 0; slice_y < dim_c_z_; ++slice_y)
-    {
-        permute_second_futures_[slice_y] = all_fft_y_c2c_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
+    // global barrier: every y-slice of the target gathers data from all x-slices
+    return hpx::when_all(fft_y_c2c_futures_)
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                // source of first permute is no longer read
+                values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
+                for (std::size_t slice_y = 0; slice_y < dim_c_z_; ++slice_y)
+                {
+                    permute_second_futures_[slice_y] = hpx::async(&permute_shared_z_y_x_wrapper, this, slice_y);
+                }
+                return hpx::when_all(permute_second_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
             {
                 r.get();
-                return hpx::async(&permute_shared_z_y_x_wrapper, this, slice_y);
+                // source of second permute is no longer read
+                permuted_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+                /////////////////////////////////////////////////////////////////
+                // Third dimension (X): every y-slice flows independently
+                // FFT x -> permute (Y, Z, X) -> (X, Y, Z)
+                for (std::size_t j = 0; j < dim_c_y_; ++j)
+                {
+                    fft_x_c2c_futures_[j] = hpx::async(&fft_1d_c2c_x_slice_wrapper, this, j);
+                    permute_third_futures_[j] = fft_x_c2c_futures_[j].then(
+                        [=, this](hpx::future<void> r)
+                        {
+                            r.get();
+                            return hpx::async(&permute_shared_z_x_y_wrapper, this, j);
+                        });
+                }
+                return hpx::when_all(permute_third_futures_);
+            })
+        .then(
+            [this, start_total](hpx::future<vector_future> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total;
+
+                return std::move(permuted_vec_);
             });
-    }
-    hpx::shared_future<vector_future> all_permute_second_futures = hpx::when_all(permute_second_futures_);
-    
+}
+
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::naive::fft_3d_c2r(vector_3d values_vec)
+{
+    return fft_3d_c2r_async(std::move(values_vec)).get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::naive::fft_3d_c2r_async(vector_3d values_vec)
+{
+    auto start_total = t_.now();
+    swap_in_spectrum(std::move(values_vec));
+    values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
+
     /////////////////////////////////////////////////////////////////
-    // Third dimension (X)
-    for (std::size_t i = 0; i < dim_c_y_; ++i)
+    // Permute (X, Y, Z) -> (Y, Z, X)
+    for (std::size_t slice_x = 0; slice_x < dim_c_x_; ++slice_x)
     {
-        for (std::size_t j = 0; j < dim_c_z_; ++j)
-        {
-            fft_x_c2c_futures_[i*dim_c_z_ + j] = all_permute_second_futures.then(
-                [=, this](hpx::shared_future<vector_future> r)
-                {
-                    r.get();
-                    return hpx::async(&fft_1d_c2c_x_inplace_wrapper, this, i, j);
-                });
-        }
+        permute_first_futures_[slice_x] = hpx::async(&permute_inverse_y_z_x_wrapper, this, slice_x);
     }
-    hpx::shared_future<vector_future> all_fft_x_c2c_futures = hpx::when_all(fft_x_c2c_futures_);
-    all_permute_second_futures.get();
-    permuted_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
-    
-    /////////////////////////////////////////////////////////////////
-    // Permute (Y, Z, X) -> (X, Y, Z)
-    for (std::size_t slice_x = 0; slice_x < dim_c_y_; ++slice_x)
-    {
-        permute_third_futures_[slice_x] = all_fft_x_c2c_futures.then(
-            [=, this](hpx::shared_future<vector_future> r)
+    // global barrier: every y-slice of the target gathers data from all x-slices
+    return hpx::when_all(permute_first_futures_)
+        .then(
+            [this](hpx::future<vector_future> r)
             {
                 r.get();
-                return hpx::async(&permute_shared_z_x_y_wrapper, this, slice_x);
-            });
-    }
-    hpx::wait_all(permute_third_futures_);
-    
-    auto stop_total = t_.now();
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
+                /////////////////////////////////////////////////////////////////
+                // Third dimension (X)
+                for (std::size_t j = 0; j < dim_c_y_; ++j)
+                {
+                    fft_x_c2c_futures_[j] = hpx::async(&fft_1d_c2c_x_inv_slice_wrapper, this, j);
+                }
+                return hpx::when_all(fft_x_c2c_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                // spectrum is consumed, reuse as target
+                permuted_vec_.rearrange(dim_c_x_, dim_c_z_, 2*dim_c_y_);
+                /////////////////////////////////////////////////////////////////
+                // Permute (Y, Z, X) -> (X, Z, Y)
+                for (std::size_t slice_z = 0; slice_z < dim_c_z_; ++slice_z)
+                {
+                    permute_second_futures_[slice_z] = hpx::async(&permute_inverse_x_z_y_wrapper, this, slice_z);
+                }
+                return hpx::when_all(permute_second_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                // source of first permute is no longer read
+                values_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+                /////////////////////////////////////////////////////////////////
+                // Second (Y) and first dimension (Z): every x-slice flows independently
+                // FFT y -> permute (X, Z, Y) -> (X, Y, Z) -> FFT z
+                for (std::size_t i = 0; i < dim_c_x_; ++i)
+                {
+                    fft_y_c2c_futures_[i] = hpx::async(&fft_1d_c2c_y_inv_slice_wrapper, this, i);
+                    permute_first_futures_[i] = fft_y_c2c_futures_[i].then(
+                        [=, this](hpx::future<void> r)
+                        {
+                            r.get();
+                            return hpx::async(&permute_inverse_x_y_z_wrapper, this, i);
+                        });
+                    fft_z_r2c_futures_[i] = permute_first_futures_[i].then(
+                        [=, this](hpx::future<void> r)
+                        {
+                            r.get();
+                            return hpx::async(&fft_1d_c2r_slice_wrapper, this, i);
+                        });
+                }
+                return hpx::when_all(fft_z_r2c_futures_);
+            })
+        .then(
+            [this, start_total](hpx::future<vector_future> r)
+            {
+                r.get();
+                measurements_["inverse_total"] = t_.now() - start_total;
 
-    return std::move(permuted_vec_);
+                return std::move(values_vec_);
+            });
 }
 
 void hpxfft::fft3D::shared::naive::write_plans_to_file(std::string file_path)
@@ -186,15 +276,25 @@ void hpxfft::fft3D::shared::naive::write_plans_to_file(std::string file_path)
     }
     // Write first plan
     fprintf(file_name, "FFTW r2c 1D plan:\n");
-    fftw_r2c_adapter_dir_z_.fprintf_plan(file_name);
+    fftw_r2c_adapter_dir_z_.print_plan(file_name);
     fprintf(file_name, "\n");
     // Write second plan
     fprintf(file_name, "FFTW c2c 1D plan direction y:\n");
-    fftw_c2c_adapter_dir_y_.fprintf_plan(file_name);
+    fftw_c2c_adapter_dir_y_.print_plan(file_name);
     fprintf(file_name, "\n");
     // Write third plan
     fprintf(file_name, "FFTW c2c 1D plan direction x:\n");
-    fftw_c2c_adapter_dir_x_.fprintf_plan(file_name);
+    fftw_c2c_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write inverse plans
+    fprintf(file_name, "FFTW backward c2c 1D plan direction x:\n");
+    fftw_c2c_inv_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW backward c2c 1D plan direction y:\n");
+    fftw_c2c_inv_adapter_dir_y_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW c2r 1D plan:\n");
+    fftw_c2r_adapter_dir_z_.print_plan(file_name);
     fprintf(file_name, "\n\n");
     // Close file
     fclose(file_name);
@@ -0,0 +1,322 @@
+#include "../../../include/hpxfft/3D/shared/strided.hpp"
+
+void hpxfft::fft3D::shared::strided::initialize(vector_3d values_vec, const std::string PLAN_FLAG)
+{
+    values_vec_ = std::move(values_vec);
+    dim_c_x_ = values_vec_.n_x();
+    dim_c_y_ = values_vec_.n_y();
+    dim_c_z_ = values_vec_.n_z() / 2;
+    dim_r_z_ = 2 * dim_c_z_ - 2;
+    PLAN_FLAG_ = PLAN_FLAG;
+    auto start_plan = t_.now();
+    plan_strided();
+    auto stop_plan = t_.now();
+    measurements_["plan"] = stop_plan - start_plan;
+    // compute overall plan flops
+    double add_z, mul_z, fma_z;
+    fftw_r2c_adapter_dir_z_.flops(&add_z, &mul_z, &fma_z);
+    double add_y, mul_y, fma_y;
+    fftw_c2c_adapter_dir_y_.flops(&add_y, &mul_y, &fma_y);
+    double add_x, mul_x, fma_x;
+    fftw_c2c_adapter_dir_x_.flops(&add_x, &mul_x, &fma_x);
+    measurements_["plan_flops"] = dim_c_x_ * (add_z + mul_z + fma_z)
+                                + dim_c_x_ * (add_y + mul_y + fma_y)
+                                + dim_c_y_ * (add_x + mul_x + fma_x);
+}
+
+void hpxfft::fft3D::shared::strided::set_values(vector_3d values_vec)
+{
+    if (values_vec.n_x() != dim_c_x_ || values_vec.n_y() != dim_c_y_ || values_vec.n_z() != 2 * dim_c_z_)
+    {
+        throw std::invalid_argument("Input dimensions do not match the initialized plans");
+    }
+    values_vec_ = std::move(values_vec);
+    // z/y-plans run on x-slices and x-plans on y-rows of the caller's buffer
+    if (!plans_accept(values_vec_.data(), 2 * dim_c_y_ * dim_c_z_, 2 * dim_c_z_))
+    {
+        plan_unaligned_ = true;
+        plan_strided();
+    }
+}
+
+void hpxfft::fft3D::shared::strided::plan_strided()
+{
+    // the x-plan spans the whole volume, measuring planners overwrite it:
+    // plan on temporary scratch unless the planner leaves the data untouched
+    vector_3d scratch;
+    real *plan_data = values_vec_.data();
+    if (PLAN_FLAG_ != "estimate" && PLAN_FLAG_ != "native")
+    {
+        scratch = vector_3d(dim_c_x_, dim_c_y_, 2 * dim_c_z_);
+        plan_data = scratch.data();
+    }
+    // z/y-plans run on x-slices and x-plans on y-rows of the values
+    const bool aligned_yz = !plan_unaligned_
+                         && hpxfft::util::fftw_adapter::keeps_alignment(
+                             plan_data, values_vec_.data(), 2 * dim_c_y_ * dim_c_z_);
+    const bool aligned_x = !plan_unaligned_
+                        && hpxfft::util::fftw_adapter::keeps_alignment(plan_data, values_vec_.data(), 2 * dim_c_z_);
+    // r2c in z-direction: dim_c_y contiguous rows per x-slice
+    fftw_r2c_adapter_dir_z_.plan(dim_r_z_, dim_c_y_, PLAN_FLAG_, plan_data, aligned_yz);
+    // c2c in y-direction: dim_c_z interleaved columns per x-slice
+    fftw_c2c_adapter_dir_y_.plan(dim_c_y_,
+                                 dim_c_z_,
+                                 dim_c_z_,
+                                 1,
+                                 PLAN_FLAG_,
+                                 reinterpret_cast<fftw_complex *>(plan_data),
+                                 hpxfft::util::fftw_adapter::direction::forward,
+                                 aligned_yz);
+    // c2c in x-direction: dim_c_z interleaved columns per y-slice, stride of one x-slice
+    fftw_c2c_adapter_dir_x_.plan(dim_c_x_,
+                                 dim_c_z_,
+                                 dim_c_y_ * dim_c_z_,
+                                 1,
+                                 PLAN_FLAG_,
+                                 reinterpret_cast<fftw_complex *>(plan_data),
+                                 hpxfft::util::fftw_adapter::direction::forward,
+                                 aligned_x);
+    // inverse plans on the same layouts
+    fftw_c2r_adapter_dir_z_.plan(dim_r_z_, dim_c_y_, PLAN_FLAG_, plan_data, aligned_yz);
+    fftw_c2c_inv_adapter_dir_y_.plan(dim_c_y_,
+                                     dim_c_z_,
+                                     dim_c_z_,
+                                     1,
+                                     PLAN_FLAG_,
+                                     reinterpret_cast<fftw_complex *>(plan_data),
+                                     hpxfft::util::fftw_adapter::direction::backward,
+                                     aligned_yz);
+    fftw_c2c_inv_adapter_dir_x_.plan(dim_c_x_,
+                                     dim_c_z_,
+                                     dim_c_y_ * dim_c_z_,
+                                     1,
+                                     PLAN_FLAG_,
+                                     reinterpret_cast<fftw_complex *>(plan_data),
+                                     hpxfft::util::fftw_adapter::direction::backward,
+                                     aligned_x);
+}
+
+void hpxfft::fft3D::shared::strided::fft_1d_c2c_y_strided(const std::size_t i)
+{
+    fftw_c2c_adapter_dir_y_.execute(reinterpret_cast<fftw_complex *>(values_vec_.slice_yz(i)));
+}
+
+void hpxfft::fft3D::shared::strided::fft_1d_c2c_x_strided(const std::size_t j)
+{
+    fftw_c2c_adapter_dir_x_.execute(reinterpret_cast<fftw_complex *>(values_vec_.vector_z(0, j)));
+}
+
+void hpxfft::fft3D::shared::strided::fft_1d_c2c_y_inv_strided(const std::size_t i)
+{
+    fftw_c2c_inv_adapter_dir_y_.execute(reinterpret_cast<fftw_complex *>(values_vec_.slice_yz(i)));
+}
+
+void hpxfft::fft3D::shared::strided::fft_1d_c2c_x_inv_strided(const std::size_t j)
+{
+    fftw_c2c_inv_adapter_dir_x_.execute(reinterpret_cast<fftw_complex *>(values_vec_.vector_z(0, j)));
+}
+
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::strided::fft_3d_r2c_par()
+{
+    return fft_3d_r2c_async().get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::strided::fft_3d_r2c_async()
+{
+    const auto policy = hpx::execution::par(hpx::execution::task);
+    /////////////////////////////////////////////////////////////////
+    // first dimension
+    start_total_ = t_.now();
+    return hpx::experimental::for_loop(
+        policy,
+        0,
+        dim_c_x_,
+        [this](auto i)
+        {
+            // batched 1D FFT r2c in z-direction
+            fft_1d_r2c_slice(i);
+        })
+        // second dimension
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                start_second_fft_ = t_.now();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_x_,
+                    [this](auto i)
+                    {
+                        // strided 1D FFT c2c in y-direction
+                        fft_1d_c2c_y_strided(i);
+                    });
+            })
+        // third dimension
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                start_third_fft_ = t_.now();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_y_,
+                    [this](auto j)
+                    {
+                        // strided 1D FFT c2c in x-direction
+                        fft_1d_c2c_x_strided(j);
+                    });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_second_fft_ - start_total_;
+                measurements_["second_fftw"] = start_third_fft_ - start_second_fft_;
+                measurements_["third_fftw"] = stop_total - start_third_fft_;
+                ///////////////////////////////////////////////////////////////
+                return std::move(values_vec_);
+            });
+}
+
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::strided::fft_3d_r2c_seq()
+{
+    /////////////////////////////////////////////////////////////////
+    // first dimension
+    auto start_total = t_.now();
+    for (std::size_t i = 0; i < dim_c_x_; ++i)
+    {
+        // batched 1D FFT r2c in z-direction
+        fft_1d_r2c_slice(i);
+    }
+    // second dimension
+    auto start_second_fft = t_.now();
+    for (std::size_t i = 0; i < dim_c_x_; ++i)
+    {
+        // strided 1D FFT c2c in y-direction
+        fft_1d_c2c_y_strided(i);
+    }
+    // third dimension
+    auto start_third_fft = t_.now();
+    for (std::size_t j = 0; j < dim_c_y_; ++j)
+    {
+        // strided 1D FFT c2c in x-direction
+        fft_1d_c2c_x_strided(j);
+    }
+    auto stop_total = t_.now();
+    ////////////////////////////////////////////////////////////////
+    // additional runtimes
+    measurements_["total"] = stop_total - start_total;
+    measurements_["first_fftw"] = start_second_fft - start_total;
+    measurements_["second_fftw"] = start_third_fft - start_second_fft;
+    measurements_["third_fftw"] = stop_total - start_third_fft;
+    ///////////////////////////////////////////////////////////////
+    return std::move(values_vec_);
+}
+
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::strided::fft_3d_c2r_par(vector_3d values_vec)
+{
+    return fft_3d_c2r_async(std::move(values_vec)).get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::strided::fft_3d_c2r_async(vector_3d values_vec)
+{
+    const auto policy = hpx::execution::par(hpx::execution::task);
+    start_inverse_total_ = t_.now();
+    set_values(std::move(values_vec));
+    // third dimension
+    return hpx::experimental::for_loop(
+        policy,
+        0,
+        dim_c_y_,
+        [this](auto j)
+        {
+            // strided backward 1D FFT c2c in x-direction
+            fft_1d_c2c_x_inv_strided(j);
+        })
+        // second dimension
+        .then(
+            [this, policy](hpx::future<void> r)
+            {
+                r.get();
+                return hpx::experimental::for_loop(
+                    policy,
+                    0,
+                    dim_c_x_,
+                    [this](auto i)
+                    {
+                        // strided backward 1D FFT c2c in y-direction
+                        fft_1d_c2c_y_inv_strided(i);
+                        // batched 1D FFT c2r in z-direction, the slice is complete
+                        fft_1d_c2r_slice(i);
+                    });
+            })
+        .then(
+            [this](hpx::future<void> r)
+            {
+                r.get();
+                measurements_["inverse_total"] = t_.now() - start_inverse_total_;
+                return std::move(values_vec_);
+            });
+}
+
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::strided::fft_3d_c2r_seq(vector_3d values_vec)
+{
+    auto start_total = t_.now();
+    set_values(std::move(values_vec));
+    // third dimension
+    for (std::size_t j = 0; j < dim_c_y_; ++j)
+    {
+        // strided backward 1D FFT c2c in x-direction
+        fft_1d_c2c_x_inv_strided(j);
+    }
+    // second and first dimension
+    for (std::size_t i = 0; i < dim_c_x_; ++i)
+    {
+        // strided backward 1D FFT c2c in y-direction
+        fft_1d_c2c_y_inv_strided(i);
+        // batched 1D FFT c2r in z-direction
+        fft_1d_c2r_slice(i);
+    }
+    measurements_["inverse_total"] = t_.now() - start_total;
+    return std::move(values_vec_);
+}
+
+void hpxfft::fft3D::shared::strided::write_plans_to_file(std::string file_path)
+{
+    // Open file
+    FILE *file_name = fopen(file_path.c_str(), "a");
+    if (!file_name)
+    {
+        throw std::runtime_error("Failed to open file: " + file_path);
+    }
+    // Write first plan
+    fprintf(file_name, "FFTW r2c 1D plan:\n");
+    fftw_r2c_adapter_dir_z_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write second plan
+    fprintf(file_name, "FFTW strided c2c 1D plan direction y:\n");
+    fftw_c2c_adapter_dir_y_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write third plan
+    fprintf(file_name, "FFTW strided c2c 1D plan direction x:\n");
+    fftw_c2c_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write inverse plans
+    fprintf(file_name, "FFTW strided backward c2c 1D plan direction x:\n");
+    fftw_c2c_inv_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW strided backward c2c 1D plan direction y:\n");
+    fftw_c2c_inv_adapter_dir_y_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW c2r 1D plan:\n");
+    fftw_c2r_adapter_dir_z_.print_plan(file_name);
+    fprintf(file_name, "\n\n");
+    // Close file
+    fclose(file_name);
+}
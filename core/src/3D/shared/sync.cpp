@@ -1,6 +1,10 @@
 #include "../../../include/hpxfft/3D/shared/sync.hpp"
 
-void hpxfft::fft3D::shared::sync::initialize(vector_3d values_vec, const std::string PLAN_FLAG)
+#include <algorithm>
+
+void hpxfft::fft3D::shared::sync::initialize(vector_3d values_vec,
+                                             const std::string PLAN_FLAG,
+                                             const std::size_t TILE_DIM)
 {
     values_vec_ = std::move(values_vec);
     dim_c_x_ = values_vec_.n_x();
@@ -9,23 +13,11 @@ void hpxfft::fft3D::shared::sync::initialize(vector_3d values_vec, const std::st
     dim_r_z_ = 2 * dim_c_z_ - 2;
     //resize transposed data structure
     permuted_vec_ = vector_3d(dim_c_x_, dim_c_z_, 2*dim_c_y_);
-    PLAN_FLAG_ = hpxfft::util::string_to_fftw_plan_flag(PLAN_FLAG);
+    PLAN_FLAG_ = PLAN_FLAG;
+    dim_tile_ = std::max(TILE_DIM, std::size_t(1));
     auto start_plan = t_.now();
-   // initialize FFTW adapters
-    fftw_r2c_adapter_dir_z_ = hpxfft::util::fftw_adapter_r2c();
-    fftw_r2c_adapter_dir_z_.initialize(dim_r_z_, PLAN_FLAG_,
-                                      permuted_vec_.slice_yz(0),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)));
-    fftw_c2c_adapter_dir_y_ = hpxfft::util::fftw_adapter_c2c();
-    fftw_c2c_adapter_dir_y_.initialize(dim_c_y_, PLAN_FLAG_,
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      hpxfft::util::fftw_direction::forward);
-    fftw_c2c_adapter_dir_x_ = hpxfft::util::fftw_adapter_c2c();
-    fftw_c2c_adapter_dir_x_.initialize(dim_c_x_, PLAN_FLAG_,
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      reinterpret_cast<fftw_complex *>(permuted_vec_.slice_yz(0)),
-                                      hpxfft::util::fftw_direction::forward);
+    // batched plans per slice, planning must not overwrite the input
+    plan_slices(permuted_vec_.data());
     auto stop_plan = t_.now();
     measurements_["plan"] = stop_plan - start_plan;
     // compute overall plan flops
@@ -35,32 +27,37 @@ void hpxfft::fft3D::shared::sync::initialize(vector_3d values_vec, const std::st
     fftw_c2c_adapter_dir_y_.flops(&add_y, &mul_y, &fma_y);
     double add_x, mul_x, fma_x;
     fftw_c2c_adapter_dir_x_.flops(&add_x, &mul_x, &fma_x);
-    measurements_["plan_flops"] = dim_r_z_ * (add_z + mul_z + fma_z)
-                                + dim_c_y_ * (add_y + mul_y + fma_y)
-                                + dim_c_x_ * (add_x + mul_x + fma_x);
+    measurements_["plan_flops"] = dim_c_x_ * (add_z + mul_z + fma_z)
+                                + dim_c_x_ * (add_y + mul_y + fma_y)
+                                + dim_c_y_ * (add_x + mul_x + fma_x);
     // resize futures
-    fft_z_r2c_futures_.resize(dim_c_x_*dim_c_y_);
+    fft_z_r2c_futures_.resize(dim_c_x_);
     permute_first_futures_.resize(dim_c_x_);
-    fft_y_c2c_futures_.resize(dim_c_x_*dim_c_z_);
+    fft_y_c2c_futures_.resize(dim_c_x_);
     permute_second_futures_.resize(dim_c_z_);
-    fft_x_c2c_futures_.resize(dim_c_y_*dim_c_z_);
+    fft_x_c2c_futures_.resize(dim_c_y_);
     permute_third_futures_.resize(dim_c_y_);
     }
 
-// wrapper for fft_1d_r2c_inplace to use with hpx::async
-void hpxfft::fft3D::shared::sync::fft_1d_r2c_inplace_wrapper(sync *th, const std::size_t i, const std::size_t j)
+void hpxfft::fft3D::shared::sync::set_values(vector_3d values_vec)
+{
+    swap_in_values(std::move(values_vec));
+}
+
+// wrapper for fft_1d_r2c_slice to use with hpx::async
+void hpxfft::fft3D::shared::sync::fft_1d_r2c_slice_wrapper(sync *th, const std::size_t i)
 {
-    th->fft_1d_r2c_inplace(i, j);
+    th->fft_1d_r2c_slice(i);
 }
 
-void hpxfft::fft3D::shared::sync::fft_1d_c2c_y_inplace_wrapper(sync *th, const std::size_t i, const std::size_t j)
+void hpxfft::fft3D::shared::sync::fft_1d_c2c_y_slice_wrapper(sync *th, const std::size_t i)
 {
-    th->fft_1d_c2c_y_inplace(i, j);
+    th->fft_1d_c2c_y_slice(i);
 }
 
-void hpxfft::fft3D::shared::sync::fft_1d_c2c_x_inplace_wrapper(sync *th, const std::size_t i, const std::size_t j)
+void hpxfft::fft3D::shared::sync::fft_1d_c2c_x_slice_wrapper(sync *th, const std::size_t i)
 {
-    th->fft_1d_c2c_x_inplace(i, j);
+    th->fft_1d_c2c_x_slice(i);
 }
 
 void hpxfft::fft3D::shared::sync::permute_shared_x_z_y_wrapper(sync *th, const std::size_t slice_x)
@@ -73,90 +70,232 @@ void hpxfft::fft3D::shared::sync::permute_shared_z_y_x_wrapper(sync *th, const s
     th->permute_shared_z_y_x(slice_y);
 }
 
-void hpxfft::fft3D::shared::sync::permute_shared_z_x_y_wrapper(sync *th, const std::size_t slice_x)
+void hpxfft::fft3D::shared::sync::permute_shared_z_x_y_wrapper(sync *th, const std::size_t slice_y)
+{
+    th->permute_shared_z_x_y(slice_y);
+}
+
+void hpxfft::fft3D::shared::sync::fft_1d_c2c_x_inv_slice_wrapper(sync *th, const std::size_t i)
+{
+    th->fft_1d_c2c_x_inv_slice(i);
+}
+
+void hpxfft::fft3D::shared::sync::fft_1d_c2c_y_inv_slice_wrapper(sync *th, const std::size_t i)
+{
+    th->fft_1d_c2c_y_inv_slice(i);
+}
+
+void hpxfft::fft3D::shared::sync::fft_1d_c2r_slice_wrapper(sync *th, const std::size_t i)
 {
-    th->permute_shared_z_x_y(slice_x);
+    th->fft_1d_c2r_slice(i);
+}
+
+void hpxfft::fft3D::shared::sync::permute_inverse_y_z_x_wrapper(sync *th, const std::size_t slice_x)
+{
+    th->permute_inverse_y_z_x(slice_x);
+}
+
+void hpxfft::fft3D::shared::sync::permute_inverse_x_z_y_wrapper(sync *th, const std::size_t slice_z)
+{
+    th->permute_inverse_x_z_y(slice_z);
+}
+
+void hpxfft::fft3D::shared::sync::permute_inverse_x_y_z_wrapper(sync *th, const std::size_t slice_x)
+{
+    th->permute_inverse_x_y_z(slice_x);
 }
 
 hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::sync::fft_3d_r2c()
 {
-    auto start_total = t_.now();
+    return fft_3d_r2c_async().get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::sync::fft_3d_r2c_async()
+{
+    start_total_ = t_.now();
 
     /////////////////////////////////////////////////////////////////
     // First dimension (Z)
     for (std::size_t i = 0; i < dim_c_x_; ++i)
     {
-        for (std::size_t j = 0; j < dim_c_y_; ++j)
-        {
-            fft_z_r2c_futures_[i*dim_c_y_ + j] = hpx::async(&fft_1d_r2c_inplace_wrapper, this, i, j);
-        }
+        fft_z_r2c_futures_[i] = hpx::async(&fft_1d_r2c_slice_wrapper, this, i);
     }
-    hpx::wait_all(fft_z_r2c_futures_);
-    auto start_first_trans = t_.now();
-    
-    /////////////////////////////////////////////////////////////////
-    // Permute (X, Y, Z) -> (X, Z, Y)
-    for (std::size_t slice_x = 0; slice_x < dim_c_x_; ++slice_x)
-    {
-        permute_first_futures_[slice_x] = hpx::async(&permute_shared_x_z_y_wrapper, this, slice_x);
-    }
-    hpx::wait_all(permute_first_futures_);
-    auto start_second_dim = t_.now();
-    
-    /////////////////////////////////////////////////////////////////
-    // Second dimension (Y)
-    for (std::size_t i = 0; i < dim_c_x_; ++i)
-    {
-        for (std::size_t j = 0; j < dim_c_z_; ++j)
-        {
-            fft_y_c2c_futures_[i*dim_c_z_ + j] = hpx::async(&fft_1d_c2c_y_inplace_wrapper, this, i, j);
-        }
-    }
-    hpx::wait_all(fft_y_c2c_futures_);
+    // each phase starts in the continuation of the previous synchronization step
+    return hpx::when_all(fft_z_r2c_futures_)
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                start_first_trans_ = t_.now();
+                /////////////////////////////////////////////////////////////////
+                // Permute (X, Y, Z) -> (X, Z, Y)
+                for (std::size_t slice_x = 0; slice_x < dim_c_x_; ++slice_x)
+                {
+                    permute_first_futures_[slice_x] = hpx::async(&permute_shared_x_z_y_wrapper, this, slice_x);
+                }
+                return hpx::when_all(permute_first_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                start_second_dim_ = t_.now();
+                /////////////////////////////////////////////////////////////////
+                // Second dimension (Y)
+                for (std::size_t i = 0; i < dim_c_x_; ++i)
+                {
+                    fft_y_c2c_futures_[i] = hpx::async(&fft_1d_c2c_y_slice_wrapper, this, i);
+                }
+                return hpx::when_all(fft_y_c2c_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
+                start_second_trans_ = t_.now();
+                /////////////////////////////////////////////////////////////////
+                // Permute (X, Z, Y) -> (Y, Z, X)
+                for (std::size_t slice_y = 0; slice_y < dim_c_z_; ++slice_y)
+                {
+                    permute_second_futures_[slice_y] = hpx::async(&permute_shared_z_y_x_wrapper, this, slice_y);
+                }
+                return hpx::when_all(permute_second_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                start_third_dim_ = t_.now();
+                /////////////////////////////////////////////////////////////////
+                // Third dimension (X)
+                for (std::size_t i = 0; i < dim_c_y_; ++i)
+                {
+                    fft_x_c2c_futures_[i] = hpx::async(&fft_1d_c2c_x_slice_wrapper, this, i);
+                }
+                return hpx::when_all(fft_x_c2c_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                permuted_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+                start_third_trans_ = t_.now();
+                /////////////////////////////////////////////////////////////////
+                // Permute (Y, Z, X) -> (X, Y, Z)
+                for (std::size_t slice_y = 0; slice_y < dim_c_y_; ++slice_y)
+                {
+                    permute_third_futures_[slice_y] = hpx::async(&permute_shared_z_x_y_wrapper, this, slice_y);
+                }
+                return hpx::when_all(permute_third_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                auto stop_total = t_.now();
+                ////////////////////////////////////////////////////////////////
+                // additional runtimes
+                measurements_["total"] = stop_total - start_total_;
+                measurements_["first_fftw"] = start_first_trans_ - start_total_;
+                measurements_["first_permute"] = start_second_dim_ - start_first_trans_;
+                measurements_["second_fftw"] = start_second_trans_ - start_second_dim_;
+                measurements_["second_permute"] = start_third_dim_ - start_second_trans_;
+                measurements_["third_fftw"] = start_third_trans_ - start_third_dim_;
+                measurements_["third_permute"] = stop_total - start_third_trans_;
+                ////////////////////////////////////////////////////////////////
+                return std::move(permuted_vec_);
+            });
+}
+
+hpxfft::fft3D::shared::vector_3d hpxfft::fft3D::shared::sync::fft_3d_c2r(vector_3d values_vec)
+{
+    return fft_3d_c2r_async(std::move(values_vec)).get();
+}
+
+hpx::future<hpxfft::fft3D::shared::vector_3d> hpxfft::fft3D::shared::sync::fft_3d_c2r_async(vector_3d values_vec)
+{
+    start_inverse_total_ = t_.now();
+    swap_in_spectrum(std::move(values_vec));
     values_vec_.rearrange(dim_c_y_, dim_c_z_, 2*dim_c_x_);
-    auto start_second_trans = t_.now();
-    
-    /////////////////////////////////////////////////////////////////
-    // Permute (X, Z, Y) -> (Y, Z, X)
-    for (std::size_t slice_y = 0; slice_y < dim_c_z_; ++slice_y)
-    {
-        permute_second_futures_[slice_y] = hpx::async(&permute_shared_z_y_x_wrapper, this, slice_y);
-    }
-    hpx::wait_all(permute_second_futures_);
-    auto start_third_dim = t_.now();
-    
-    /////////////////////////////////////////////////////////////////
-    // Third dimension (X)
-    for (std::size_t i = 0; i < dim_c_y_; ++i)
-    {
-        for (std::size_t j = 0; j < dim_c_z_; ++j)
-        {
-            fft_x_c2c_futures_[i*dim_c_z_ + j] = hpx::async(&fft_1d_c2c_x_inplace_wrapper, this, i, j);
-        }
-    }
-    hpx::wait_all(fft_x_c2c_futures_);
-    permuted_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
-    auto start_third_trans = t_.now();
-    
+
     /////////////////////////////////////////////////////////////////
-    // Permute (Y, Z, X) -> (X, Y, Z)
-    for (std::size_t slice_x = 0; slice_x < dim_c_y_; ++slice_x)
+    // Permute (X, Y, Z) -> (Y, Z, X)
+    for (std::size_t slice_x = 0; slice_x < dim_c_x_; ++slice_x)
     {
-        permute_third_futures_[slice_x] = hpx::async(&permute_shared_z_x_y_wrapper, this, slice_x);
+        permute_first_futures_[slice_x] = hpx::async(&permute_inverse_y_z_x_wrapper, this, slice_x);
     }
-    hpx::wait_all(permute_third_futures_);
-    auto stop_total = t_.now();
-    ////////////////////////////////////////////////////////////////
-    // additional runtimes
-    measurements_["total"] = stop_total - start_total;
-    measurements_["first_fftw"] = start_first_trans - start_total;
-    measurements_["first_permute"] = start_second_dim - start_first_trans;
-    measurements_["second_fftw"] = start_second_trans - start_second_dim;
-    measurements_["second_permute"] = start_third_dim - start_second_trans;
-    measurements_["third_fftw"] = start_third_trans - start_third_dim;
-    measurements_["third_permute"] = stop_total - start_third_trans;
-    ////////////////////////////////////////////////////////////////
-    return std::move(permuted_vec_);
+    // each phase starts in the continuation of the previous synchronization step
+    return hpx::when_all(permute_first_futures_)
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                /////////////////////////////////////////////////////////////////
+                // Third dimension (X)
+                for (std::size_t i = 0; i < dim_c_y_; ++i)
+                {
+                    fft_x_c2c_futures_[i] = hpx::async(&fft_1d_c2c_x_inv_slice_wrapper, this, i);
+                }
+                return hpx::when_all(fft_x_c2c_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                permuted_vec_.rearrange(dim_c_x_, dim_c_z_, 2*dim_c_y_);
+                /////////////////////////////////////////////////////////////////
+                // Permute (Y, Z, X) -> (X, Z, Y)
+                for (std::size_t slice_z = 0; slice_z < dim_c_z_; ++slice_z)
+                {
+                    permute_second_futures_[slice_z] = hpx::async(&permute_inverse_x_z_y_wrapper, this, slice_z);
+                }
+                return hpx::when_all(permute_second_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                /////////////////////////////////////////////////////////////////
+                // Second dimension (Y)
+                for (std::size_t i = 0; i < dim_c_x_; ++i)
+                {
+                    fft_y_c2c_futures_[i] = hpx::async(&fft_1d_c2c_y_inv_slice_wrapper, this, i);
+                }
+                return hpx::when_all(fft_y_c2c_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                values_vec_.rearrange(dim_c_x_, dim_c_y_, 2*dim_c_z_);
+                /////////////////////////////////////////////////////////////////
+                // Permute (X, Z, Y) -> (X, Y, Z)
+                for (std::size_t slice_x = 0; slice_x < dim_c_x_; ++slice_x)
+                {
+                    permute_first_futures_[slice_x] = hpx::async(&permute_inverse_x_y_z_wrapper, this, slice_x);
+                }
+                return hpx::when_all(permute_first_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                /////////////////////////////////////////////////////////////////
+                // First dimension (Z)
+                for (std::size_t i = 0; i < dim_c_x_; ++i)
+                {
+                    fft_z_r2c_futures_[i] = hpx::async(&fft_1d_c2r_slice_wrapper, this, i);
+                }
+                return hpx::when_all(fft_z_r2c_futures_);
+            })
+        .then(
+            [this](hpx::future<vector_future> r)
+            {
+                r.get();
+                measurements_["inverse_total"] = t_.now() - start_inverse_total_;
+                return std::move(values_vec_);
+            });
 }
 
 void hpxfft::fft3D::shared::sync::write_plans_to_file(std::string file_path)
@@ -169,15 +308,25 @@ void hpxfft::fft3D::shared::sync::write_plans_to_file(std::string file_path)
     }
     // Write first plan
     fprintf(file_name, "FFTW r2c 1D plan:\n");
-    fftw_r2c_adapter_dir_z_.fprintf_plan(file_name);
+    fftw_r2c_adapter_dir_z_.print_plan(file_name);
     fprintf(file_name, "\n");
     // Write second plan
     fprintf(file_name, "FFTW c2c 1D plan direction y:\n");
-    fftw_c2c_adapter_dir_y_.fprintf_plan(file_name);
+    fftw_c2c_adapter_dir_y_.print_plan(file_name);
     fprintf(file_name, "\n");
     // Write third plan
     fprintf(file_name, "FFTW c2c 1D plan direction x:\n");
-    fftw_c2c_adapter_dir_x_.fprintf_plan(file_name);
+    fftw_c2c_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    // Write inverse plans
+    fprintf(file_name, "FFTW backward c2c 1D plan direction x:\n");
+    fftw_c2c_inv_adapter_dir_x_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW backward c2c 1D plan direction y:\n");
+    fftw_c2c_inv_adapter_dir_y_.print_plan(file_name);
+    fprintf(file_name, "\n");
+    fprintf(file_name, "FFTW c2r 1D plan:\n");
+    fftw_c2r_adapter_dir_z_.print_plan(file_name);
     fprintf(file_name, "\n\n");
     // Close file
     fclose(file_name);
@@ -1,12 +1,144 @@
 #include "../../include/hpxfft/util/adapter_fftw.hpp"
 
+#include <cstdlib>
+#include <mutex>
+#ifdef HPXFFT_HAVE_FFTW_THREADS
+#include <cstddef>
+#include <hpx/execution.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#endif
+
+namespace
+{
+// the FFTW planner is global state: plans are created one at a time and the
+// thread count of a plan must not leak into a concurrently created one
+std::mutex fftw_planner_mutex;
+
+#ifdef HPXFFT_HAVE_FFTW_THREADS
+// fftw_init_threads() runs once per process, fftw_cleanup_threads() at exit
+bool fftw_threads_ready = false;
+
+// FFTW spawn loop: run the njobs work items of a parallel plan section as HPX tasks
+void hpx_spawn_loop(void *(*work)(char *), char *jobdata, std::size_t elsize, int njobs, void *)
+{
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, njobs, [work, jobdata, elsize](int i) { work(jobdata + elsize * i); });
+}
+#endif
+
+// create a plan with n_threads threads that replaces previous (may be nullptr),
+// the planner lock is held throughout
+template <typename Planner>
+fftw_plan create_plan(fftw_plan previous, int n_threads, Planner &&planner)
+{
+    std::lock_guard<std::mutex> lock(fftw_planner_mutex);
+    if (previous)
+    {
+        fftw_destroy_plan(previous);
+    }
+#ifdef HPXFFT_HAVE_FFTW_THREADS
+    if (fftw_threads_ready)
+    {
+        fftw_plan_with_nthreads(n_threads);
+    }
+#else
+    (void) n_threads;
+#endif
+    fftw_plan plan = planner();
+#ifdef HPXFFT_HAVE_FFTW_THREADS
+    if (fftw_threads_ready)
+    {
+        fftw_plan_with_nthreads(1);
+    }
+#endif
+    return plan;
+}
+
+// offsets k * step keep the alignment if one step does
+bool has_alignment(int alignment, double *data, std::size_t step)
+{
+    return fftw_alignment_of(data) == alignment && fftw_alignment_of(data + step) == alignment;
+}
+
+// alignment a plan requires from its execute pointers, -1 for FFTW_UNALIGNED plans
+int plan_alignment(double *planned, bool aligned) { return aligned ? fftw_alignment_of(planned) : -1; }
+
+// planner flags of a plan executed on pointers of the same or of any alignment
+unsigned plan_flags(const std::string &plan_flag, bool aligned)
+{
+    return static_cast<unsigned>(hpxfft::util::fftw_adapter::string_to_fftw_plan_flag(plan_flag))
+         | (aligned ? 0u : static_cast<unsigned>(FFTW_UNALIGNED));
+}
+}  // namespace
+
 // FFTW adapter implementation
-void hpxfft::util::fftw_adapter::cleanup() { fftw_cleanup(); }
+void hpxfft::util::fftw_adapter::cleanup()
+{
+    std::lock_guard<std::mutex> lock(fftw_planner_mutex);
+#ifdef HPXFFT_HAVE_FFTW_THREADS
+    if (fftw_threads_ready)
+    {
+        // also runs fftw_cleanup()
+        fftw_cleanup_threads();
+        fftw_threads_ready = false;
+        return;
+    }
+#endif
+    fftw_cleanup();
+}
 
-void hpxfft::util::fftw_adapter::r2c_1d::plan(int dim_r, std::string plan_flag, double *in, fftw_complex *out)
+bool hpxfft::util::fftw_adapter::init_threads()
 {
+#ifdef HPXFFT_HAVE_FFTW_THREADS
+    std::lock_guard<std::mutex> lock(fftw_planner_mutex);
+    if (!fftw_threads_ready)
+    {
+        fftw_threads_ready = fftw_init_threads() != 0;
+        if (fftw_threads_ready)
+        {
+            fftw_threads_set_callback(&hpx_spawn_loop, nullptr);
+            // process-level teardown, live plans of any engine stay valid until exit
+            static const bool registered = std::atexit(&hpxfft::util::fftw_adapter::cleanup) == 0;
+            (void) registered;
+        }
+    }
+    return fftw_threads_ready;
+#else
+    return false;
+#endif
+}
+
+bool hpxfft::util::fftw_adapter::import_wisdom(const std::string &file_path)
+{
+    // wisdom is planner state, a concurrent plan must not see it half-imported
+    std::lock_guard<std::mutex> lock(fftw_planner_mutex);
+    return fftw_import_wisdom_from_filename(file_path.c_str()) != 0;
+}
+
+bool hpxfft::util::fftw_adapter::export_wisdom(const std::string &file_path)
+{
+    std::lock_guard<std::mutex> lock(fftw_planner_mutex);
+    return fftw_export_wisdom_to_filename(file_path.c_str()) != 0;
+}
+
+bool hpxfft::util::fftw_adapter::keeps_alignment(double *planned, double *data, std::size_t step)
+{
+    return has_alignment(fftw_alignment_of(planned), data, step);
+}
+
+void hpxfft::util::fftw_adapter::r2c_1d::plan(
+    int dim_r, std::string plan_flag, double *in, fftw_complex *out, int n_threads, bool aligned)
+{
+    alignment_ = plan_alignment(in, aligned);
     // create FFTW plan
-    plan_r2c_1d_ = fftw_plan_dft_r2c_1d(dim_r, in, out, static_cast<unsigned>(string_to_fftw_plan_flag(plan_flag)));
+    plan_r2c_1d_ = create_plan(plan_r2c_1d_,
+                               n_threads,
+                               [&] { return fftw_plan_dft_r2c_1d(dim_r, in, out, plan_flags(plan_flag, aligned)); });
+}
+
+bool hpxfft::util::fftw_adapter::r2c_1d::accepts(double *in, std::size_t step) const
+{
+    return alignment_ < 0 || has_alignment(alignment_, in, step);
 }
 
 void hpxfft::util::fftw_adapter::r2c_1d::execute(double *in, fftw_complex *out)
@@ -21,12 +153,22 @@ void hpxfft::util::fftw_adapter::r2c_1d::flops(double *add, double *mul, double
 
 void hpxfft::util::fftw_adapter::r2c_1d::print_plan(FILE *stream) { fftw_fprint_plan(plan_r2c_1d_, stream); }
 
-void hpxfft::util::fftw_adapter::c2c_1d::plan(
-    int dim_c, std::string plan_flag, fftw_complex *in, fftw_complex *out, fftw_adapter::direction direction)
+void hpxfft::util::fftw_adapter::c2c_1d::plan(int dim_c,
+                                              std::string plan_flag,
+                                              fftw_complex *in,
+                                              fftw_complex *out,
+                                              fftw_adapter::direction direction,
+                                              int n_threads,
+                                              bool aligned)
 {
     // create FFTW plan
-    plan_c2c_1d_ = fftw_plan_dft_1d(
-        dim_c, in, out, static_cast<int>(direction), static_cast<unsigned>(string_to_fftw_plan_flag(plan_flag)));
+    plan_c2c_1d_ = create_plan(plan_c2c_1d_,
+                               n_threads,
+                               [&]
+                               {
+                                   return fftw_plan_dft_1d(
+                                       dim_c, in, out, static_cast<int>(direction), plan_flags(plan_flag, aligned));
+                               });
 }
 
 void hpxfft::util::fftw_adapter::c2c_1d::execute(fftw_complex *in, fftw_complex *out)
@@ -40,3 +182,178 @@ void hpxfft::util::fftw_adapter::c2c_1d::flops(double *add, double *mul, double
 }
 
 void hpxfft::util::fftw_adapter::c2c_1d::print_plan(FILE *stream) { fftw_fprint_plan(plan_c2c_1d_, stream); }
+
+void hpxfft::util::fftw_adapter::r2c_1d_many::plan(
+    int dim_r, int howmany, std::string plan_flag, double *values, bool aligned)
+{
+    // padded in-place layout
+    const int dim_c = dim_r / 2 + 1;
+    alignment_ = plan_alignment(values, aligned);
+    // create FFTW plan
+    plan_r2c_1d_many_ = create_plan(plan_r2c_1d_many_,
+                                    1,
+                                    [&]
+                                    {
+                                        return fftw_plan_many_dft_r2c(1,
+                                                                      &dim_r,
+                                                                      howmany,
+                                                                      values,
+                                                                      nullptr,
+                                                                      1,
+                                                                      2 * dim_c,
+                                                                      reinterpret_cast<fftw_complex *>(values),
+                                                                      nullptr,
+                                                                      1,
+                                                                      dim_c,
+                                                                      plan_flags(plan_flag, aligned));
+                                    });
+}
+
+bool hpxfft::util::fftw_adapter::r2c_1d_many::accepts(double *values, std::size_t step) const
+{
+    return alignment_ < 0 || has_alignment(alignment_, values, step);
+}
+
+void hpxfft::util::fftw_adapter::r2c_1d_many::execute(double *values)
+{
+    fftw_execute_dft_r2c(plan_r2c_1d_many_, values, reinterpret_cast<fftw_complex *>(values));
+}
+
+void hpxfft::util::fftw_adapter::r2c_1d_many::flops(double *add, double *mul, double *fma)
+{
+    fftw_flops(plan_r2c_1d_many_, add, mul, fma);
+}
+
+void hpxfft::util::fftw_adapter::r2c_1d_many::print_plan(FILE *stream)
+{
+    fftw_fprint_plan(plan_r2c_1d_many_, stream);
+}
+
+void hpxfft::util::fftw_adapter::c2r_1d_many::plan(
+    int dim_r, int howmany, std::string plan_flag, double *values, bool aligned)
+{
+    // padded in-place layout
+    const int dim_c = dim_r / 2 + 1;
+    alignment_ = plan_alignment(values, aligned);
+    // create FFTW plan
+    plan_c2r_1d_many_ = create_plan(plan_c2r_1d_many_,
+                                    1,
+                                    [&]
+                                    {
+                                        return fftw_plan_many_dft_c2r(1,
+                                                                      &dim_r,
+                                                                      howmany,
+                                                                      reinterpret_cast<fftw_complex *>(values),
+                                                                      nullptr,
+                                                                      1,
+                                                                      dim_c,
+                                                                      values,
+                                                                      nullptr,
+                                                                      1,
+                                                                      2 * dim_c,
+                                                                      plan_flags(plan_flag, aligned));
+                                    });
+}
+
+bool hpxfft::util::fftw_adapter::c2r_1d_many::accepts(double *values, std::size_t step) const
+{
+    return alignment_ < 0 || has_alignment(alignment_, values, step);
+}
+
+void hpxfft::util::fftw_adapter::c2r_1d_many::execute(double *values)
+{
+    fftw_execute_dft_c2r(plan_c2r_1d_many_, reinterpret_cast<fftw_complex *>(values), values);
+}
+
+void hpxfft::util::fftw_adapter::c2r_1d_many::flops(double *add, double *mul, double *fma)
+{
+    fftw_flops(plan_c2r_1d_many_, add, mul, fma);
+}
+
+void hpxfft::util::fftw_adapter::c2r_1d_many::print_plan(FILE *stream)
+{
+    fftw_fprint_plan(plan_c2r_1d_many_, stream);
+}
+
+void hpxfft::util::fftw_adapter::c2c_1d_many::plan(int dim_c,
+                                                   int howmany,
+                                                   int stride,
+                                                   int dist,
+                                                   std::string plan_flag,
+                                                   fftw_complex *values,
+                                                   fftw_adapter::direction direction,
+                                                   bool aligned)
+{
+    alignment_ = plan_alignment(reinterpret_cast<double *>(values), aligned);
+    // create FFTW plan
+    plan_c2c_1d_many_ = create_plan(plan_c2c_1d_many_,
+                                    1,
+                                    [&]
+                                    {
+                                        return fftw_plan_many_dft(1,
+                                                                  &dim_c,
+                                                                  howmany,
+                                                                  values,
+                                                                  nullptr,
+                                                                  stride,
+                                                                  dist,
+                                                                  values,
+                                                                  nullptr,
+                                                                  stride,
+                                                                  dist,
+                                                                  static_cast<int>(direction),
+                                                                  plan_flags(plan_flag, aligned));
+                                    });
+}
+
+bool hpxfft::util::fftw_adapter::c2c_1d_many::accepts(double *values, std::size_t step) const
+{
+    return alignment_ < 0 || has_alignment(alignment_, values, step);
+}
+
+void hpxfft::util::fftw_adapter::c2c_1d_many::execute(fftw_complex *values)
+{
+    fftw_execute_dft(plan_c2c_1d_many_, values, values);
+}
+
+void hpxfft::util::fftw_adapter::c2c_1d_many::flops(double *add, double *mul, double *fma)
+{
+    fftw_flops(plan_c2c_1d_many_, add, mul, fma);
+}
+
+void hpxfft::util::fftw_adapter::c2c_1d_many::print_plan(FILE *stream)
+{
+    fftw_fprint_plan(plan_c2c_1d_many_, stream);
+}
+
+void hpxfft::util::fftw_adapter::r2c_2d_many::plan(
+    int n_row, int n_col, int howmany, std::string plan_flag, double *values, bool aligned)
+{
+    // padded in-place layout, the real row length is n_col - 2
+    const int n[2] = { n_row, n_col - 2 };
+    const int inembed[2] = { n_row, n_col };
+    const int onembed[2] = { n_row, n_col / 2 };
+    // create FFTW plan
+    plan_r2c_2d_many_ = create_plan(plan_r2c_2d_many_,
+                                    1,
+                                    [&]
+                                    {
+                                        return fftw_plan_many_dft_r2c(2,
+                                                                      n,
+                                                                      howmany,
+                                                                      values,
+                                                                      inembed,
+                                                                      1,
+                                                                      n_row * n_col,
+                                                                      reinterpret_cast<fftw_complex *>(values),
+                                                                      onembed,
+                                                                      1,
+                                                                      n_row * n_col / 2,
+                                                                      plan_flags(plan_flag, aligned));
+                                    });
+}
+
+void hpxfft::util::fftw_adapter::r2c_2d_many::execute(double *values)
+{
+    fftw_execute_dft_r2c(plan_r2c_2d_many_, values, reinterpret_cast<fftw_complex *>(values));
+}
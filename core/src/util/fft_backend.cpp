@@ -0,0 +1,359 @@
+#include "../../include/hpxfft/util/fft_backend.hpp"
+
+#include <vector>
+
+namespace
+{
+// gather buffer of the calling thread for strided native transforms
+std::vector<double> &strided_buffer(std::size_t size)
+{
+    thread_local std::vector<double> buffer;
+    if (buffer.size() < size)
+    {
+        buffer.resize(size);
+    }
+    return buffer;
+}
+}  // namespace
+
+// r2c backend
+void hpxfft::util::fft_backend::r2c_1d::plan(
+    int dim_r, std::string plan_flag, double *in, fftw_complex *out, int n_threads, bool aligned)
+{
+    backend_ = string_to_backend(plan_flag);
+    if (backend_ == backend::native)
+    {
+        // twiddle tables only, no planning
+        native_.plan(dim_r);
+    }
+    else
+    {
+        fftw_.plan(dim_r, plan_flag, in, out, n_threads, aligned);
+    }
+}
+
+bool hpxfft::util::fft_backend::r2c_1d::accepts(double *in, std::size_t step) const
+{
+    return backend_ == backend::native || fftw_.accepts(in, step);
+}
+
+void hpxfft::util::fft_backend::r2c_1d::execute(double *in, fftw_complex *out)
+{
+    if (backend_ == backend::native)
+    {
+        native_.execute(in, reinterpret_cast<double *>(out));
+    }
+    else
+    {
+        fftw_.execute(in, out);
+    }
+}
+
+void hpxfft::util::fft_backend::r2c_1d::flops(double *add, double *mul, double *fma)
+{
+    if (backend_ == backend::native)
+    {
+        native_.flops(add, mul, fma);
+    }
+    else
+    {
+        fftw_.flops(add, mul, fma);
+    }
+}
+
+void hpxfft::util::fft_backend::r2c_1d::print_plan(FILE *stream)
+{
+    if (backend_ == backend::native)
+    {
+        native_.print_plan(stream);
+    }
+    else
+    {
+        fftw_.print_plan(stream);
+    }
+}
+
+// c2c backend
+void hpxfft::util::fft_backend::c2c_1d::plan(int dim_c,
+                                             std::string plan_flag,
+                                             fftw_complex *in,
+                                             fftw_complex *out,
+                                             fftw_adapter::direction direction,
+                                             int n_threads,
+                                             bool aligned)
+{
+    backend_ = string_to_backend(plan_flag);
+    if (backend_ == backend::native)
+    {
+        // twiddle tables only, no planning
+        native_.plan(dim_c, static_cast<int>(direction));
+    }
+    else
+    {
+        fftw_.plan(dim_c, plan_flag, in, out, direction, n_threads, aligned);
+    }
+}
+
+void hpxfft::util::fft_backend::c2c_1d::execute(fftw_complex *in, fftw_complex *out)
+{
+    if (backend_ == backend::native)
+    {
+        native_.execute(reinterpret_cast<const double *>(in), reinterpret_cast<double *>(out));
+    }
+    else
+    {
+        fftw_.execute(in, out);
+    }
+}
+
+void hpxfft::util::fft_backend::c2c_1d::flops(double *add, double *mul, double *fma)
+{
+    if (backend_ == backend::native)
+    {
+        native_.flops(add, mul, fma);
+    }
+    else
+    {
+        fftw_.flops(add, mul, fma);
+    }
+}
+
+void hpxfft::util::fft_backend::c2c_1d::print_plan(FILE *stream)
+{
+    if (backend_ == backend::native)
+    {
+        native_.print_plan(stream);
+    }
+    else
+    {
+        fftw_.print_plan(stream);
+    }
+}
+
+// batched r2c backend
+void hpxfft::util::fft_backend::r2c_1d_many::plan(
+    int dim_r, int howmany, std::string plan_flag, double *values, bool aligned)
+{
+    backend_ = string_to_backend(plan_flag);
+    dim_r_ = static_cast<std::size_t>(dim_r);
+    howmany_ = static_cast<std::size_t>(howmany);
+    if (backend_ == backend::native)
+    {
+        native_.plan(dim_r);
+    }
+    else
+    {
+        fftw_.plan(dim_r, howmany, plan_flag, values, aligned);
+    }
+}
+
+bool hpxfft::util::fft_backend::r2c_1d_many::accepts(double *values, std::size_t step) const
+{
+    return backend_ == backend::native || fftw_.accepts(values, step);
+}
+
+void hpxfft::util::fft_backend::r2c_1d_many::execute(double *values)
+{
+    if (backend_ == backend::native)
+    {
+        const std::size_t dist = 2 * (dim_r_ / 2 + 1);
+        for (std::size_t b = 0; b < howmany_; ++b)
+        {
+            native_.execute(values + b * dist, values + b * dist);
+        }
+    }
+    else
+    {
+        fftw_.execute(values);
+    }
+}
+
+void hpxfft::util::fft_backend::r2c_1d_many::flops(double *add, double *mul, double *fma)
+{
+    if (backend_ == backend::native)
+    {
+        native_.flops(add, mul, fma);
+        *add *= static_cast<double>(howmany_);
+        *mul *= static_cast<double>(howmany_);
+        *fma *= static_cast<double>(howmany_);
+    }
+    else
+    {
+        fftw_.flops(add, mul, fma);
+    }
+}
+
+void hpxfft::util::fft_backend::r2c_1d_many::print_plan(FILE *stream)
+{
+    if (backend_ == backend::native)
+    {
+        fprintf(stream, "(native-batch howmany=%zu ", howmany_);
+        native_.print_plan(stream);
+        fprintf(stream, ")");
+    }
+    else
+    {
+        fftw_.print_plan(stream);
+    }
+}
+
+// batched c2r backend
+void hpxfft::util::fft_backend::c2r_1d_many::plan(
+    int dim_r, int howmany, std::string plan_flag, double *values, bool aligned)
+{
+    backend_ = string_to_backend(plan_flag);
+    dim_r_ = static_cast<std::size_t>(dim_r);
+    howmany_ = static_cast<std::size_t>(howmany);
+    if (backend_ == backend::native)
+    {
+        native_.plan(dim_r);
+    }
+    else
+    {
+        fftw_.plan(dim_r, howmany, plan_flag, values, aligned);
+    }
+}
+
+bool hpxfft::util::fft_backend::c2r_1d_many::accepts(double *values, std::size_t step) const
+{
+    return backend_ == backend::native || fftw_.accepts(values, step);
+}
+
+void hpxfft::util::fft_backend::c2r_1d_many::execute(double *values)
+{
+    if (backend_ == backend::native)
+    {
+        const std::size_t dist = 2 * (dim_r_ / 2 + 1);
+        for (std::size_t b = 0; b < howmany_; ++b)
+        {
+            native_.execute(values + b * dist, values + b * dist);
+        }
+    }
+    else
+    {
+        fftw_.execute(values);
+    }
+}
+
+void hpxfft::util::fft_backend::c2r_1d_many::flops(double *add, double *mul, double *fma)
+{
+    if (backend_ == backend::native)
+    {
+        native_.flops(add, mul, fma);
+        *add *= static_cast<double>(howmany_);
+        *mul *= static_cast<double>(howmany_);
+        *fma *= static_cast<double>(howmany_);
+    }
+    else
+    {
+        fftw_.flops(add, mul, fma);
+    }
+}
+
+void hpxfft::util::fft_backend::c2r_1d_many::print_plan(FILE *stream)
+{
+    if (backend_ == backend::native)
+    {
+        fprintf(stream, "(native-batch howmany=%zu ", howmany_);
+        native_.print_plan(stream);
+        fprintf(stream, ")");
+    }
+    else
+    {
+        fftw_.print_plan(stream);
+    }
+}
+
+// batched c2c backend
+void hpxfft::util::fft_backend::c2c_1d_many::plan(int dim_c,
+                                                  int howmany,
+                                                  int stride,
+                                                  int dist,
+                                                  std::string plan_flag,
+                                                  fftw_complex *values,
+                                                  fftw_adapter::direction direction,
+                                                  bool aligned)
+{
+    backend_ = string_to_backend(plan_flag);
+    dim_c_ = static_cast<std::size_t>(dim_c);
+    howmany_ = static_cast<std::size_t>(howmany);
+    stride_ = static_cast<std::size_t>(stride);
+    dist_ = static_cast<std::size_t>(dist);
+    if (backend_ == backend::native)
+    {
+        native_.plan(dim_c, static_cast<int>(direction));
+    }
+    else
+    {
+        fftw_.plan(dim_c, howmany, stride, dist, plan_flag, values, direction, aligned);
+    }
+}
+
+bool hpxfft::util::fft_backend::c2c_1d_many::accepts(double *values, std::size_t step) const
+{
+    return backend_ == backend::native || fftw_.accepts(values, step);
+}
+
+void hpxfft::util::fft_backend::c2c_1d_many::execute(fftw_complex *values)
+{
+    if (backend_ != backend::native)
+    {
+        fftw_.execute(values);
+        return;
+    }
+    double *data = reinterpret_cast<double *>(values);
+    if (stride_ == 1)
+    {
+        for (std::size_t b = 0; b < howmany_; ++b)
+        {
+            native_.execute(data + 2 * b * dist_, data + 2 * b * dist_);
+        }
+        return;
+    }
+    // gather strided transforms into a contiguous buffer
+    double *buffer = strided_buffer(2 * dim_c_).data();
+    for (std::size_t b = 0; b < howmany_; ++b)
+    {
+        double *first = data + 2 * b * dist_;
+        for (std::size_t k = 0; k < dim_c_; ++k)
+        {
+            buffer[2 * k] = first[2 * k * stride_];
+            buffer[2 * k + 1] = first[2 * k * stride_ + 1];
+        }
+        native_.execute(buffer, buffer);
+        for (std::size_t k = 0; k < dim_c_; ++k)
+        {
+            first[2 * k * stride_] = buffer[2 * k];
+            first[2 * k * stride_ + 1] = buffer[2 * k + 1];
+        }
+    }
+}
+
+void hpxfft::util::fft_backend::c2c_1d_many::flops(double *add, double *mul, double *fma)
+{
+    if (backend_ == backend::native)
+    {
+        native_.flops(add, mul, fma);
+        *add *= static_cast<double>(howmany_);
+        *mul *= static_cast<double>(howmany_);
+        *fma *= static_cast<double>(howmany_);
+    }
+    else
+    {
+        fftw_.flops(add, mul, fma);
+    }
+}
+
+void hpxfft::util::fft_backend::c2c_1d_many::print_plan(FILE *stream)
+{
+    if (backend_ == backend::native)
+    {
+        fprintf(stream, "(native-batch howmany=%zu stride=%zu dist=%zu ", howmany_, stride_, dist_);
+        native_.print_plan(stream);
+        fprintf(stream, ")");
+    }
+    else
+    {
+        fftw_.print_plan(stream);
+    }
+}
@@ -0,0 +1,43 @@
+#include "../../include/hpxfft/util/loop_chunking.hpp"
+
+#include <algorithm>
+
+void hpxfft::util::chunk_tuner::initialize(std::size_t n_iterations, std::size_t n_threads)
+{
+    const std::size_t n_per_thread = std::max(n_iterations / std::max(n_threads, std::size_t(1)), std::size_t(1));
+    // HPX default, one and four static chunks per thread,
+    // small dynamic chunks and guided chunks for unbalanced work
+    candidates_ = { chunk_param{ chunk_policy::automatic, 0 },
+                    chunk_param{ chunk_policy::static_size, n_per_thread },
+                    chunk_param{ chunk_policy::static_size, std::max(n_per_thread / 4, std::size_t(1)) },
+                    chunk_param{ chunk_policy::dynamic_size, std::max(n_per_thread / 8, std::size_t(1)) },
+                    chunk_param{ chunk_policy::guided_size, 1 } };
+    runtimes_.assign(candidates_.size(), 0.0);
+    trial_ = 0;
+    locked_ = false;
+    best_ = candidates_[0];
+}
+
+const hpxfft::util::chunk_param &hpxfft::util::chunk_tuner::current() const
+{
+    return locked_ ? best_ : candidates_[trial_];
+}
+
+void hpxfft::util::chunk_tuner::record(double runtime)
+{
+    if (locked_)
+    {
+        return;
+    }
+    runtimes_[trial_] = runtime;
+    ++trial_;
+    // all candidates timed: lock in the fastest one
+    if (trial_ == candidates_.size())
+    {
+        auto fastest = std::min_element(runtimes_.begin(), runtimes_.end());
+        best_ = candidates_[std::distance(runtimes_.begin(), fastest)];
+        locked_ = true;
+    }
+}
+
+bool hpxfft::util::chunk_tuner::locked() const noexcept { return locked_; }
@@ -0,0 +1,283 @@
+#include "../../include/hpxfft/util/native_fft.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+constexpr double pi = 3.14159265358979323846264338327950288;
+
+bool is_power_of_two(std::size_t n) { return n > 0 && (n & (n - 1)) == 0; }
+
+// scratch buffers of the calling thread, the kernels never suspend
+std::vector<double> &scratch(std::size_t i, std::size_t size)
+{
+    thread_local std::vector<double> buffers[3];
+    if (buffers[i].size() < size)
+    {
+        buffers[i].resize(size);
+    }
+    return buffers[i];
+}
+
+void store_twiddle(std::vector<double> &twiddles, double angle)
+{
+    twiddles.push_back(std::cos(angle));
+    twiddles.push_back(std::sin(angle));
+}
+}  // namespace
+
+// complex FFT
+void hpxfft::util::native_fft::c2c_1d::plan(int dim_c, int sign)
+{
+    if (dim_c < 1 || !is_power_of_two(static_cast<std::size_t>(dim_c)))
+    {
+        throw std::invalid_argument("Native FFT backend supports power-of-two lengths only");
+    }
+    n_ = static_cast<std::size_t>(dim_c);
+    sign_ = sign < 0 ? -1 : 1;
+    // twiddles of all radix-4 stages
+    twiddles_.clear();
+    for (std::size_t n = n_; n >= 4; n /= 4)
+    {
+        for (std::size_t p = 0; p < n / 4; ++p)
+        {
+            const double angle = sign_ * 2.0 * pi * static_cast<double>(p) / static_cast<double>(n);
+            store_twiddle(twiddles_, angle);
+            store_twiddle(twiddles_, 2.0 * angle);
+            store_twiddle(twiddles_, 3.0 * angle);
+        }
+    }
+}
+
+double *hpxfft::util::native_fft::c2c_1d::transform(double *x, double *y) const
+{
+    const double *w = twiddles_.data();
+    const double sign = static_cast<double>(sign_);
+    std::size_t n = n_;
+    std::size_t s = 1;
+    // radix-4 stages, the inner loop runs over contiguous memory
+    while (n >= 4)
+    {
+        const std::size_t m = n / 4;
+        for (std::size_t p = 0; p < m; ++p)
+        {
+            const double w1_re = w[6 * p], w1_im = w[6 * p + 1];
+            const double w2_re = w[6 * p + 2], w2_im = w[6 * p + 3];
+            const double w3_re = w[6 * p + 4], w3_im = w[6 * p + 5];
+            const double *x0 = x + 2 * s * p;
+            const double *x1 = x + 2 * s * (p + m);
+            const double *x2 = x + 2 * s * (p + 2 * m);
+            const double *x3 = x + 2 * s * (p + 3 * m);
+            double *y0 = y + 2 * s * (4 * p);
+            double *y1 = y + 2 * s * (4 * p + 1);
+            double *y2 = y + 2 * s * (4 * p + 2);
+            double *y3 = y + 2 * s * (4 * p + 3);
+            for (std::size_t q = 0; q < s; ++q)
+            {
+                const double apc_re = x0[2 * q] + x2[2 * q], apc_im = x0[2 * q + 1] + x2[2 * q + 1];
+                const double amc_re = x0[2 * q] - x2[2 * q], amc_im = x0[2 * q + 1] - x2[2 * q + 1];
+                const double bpd_re = x1[2 * q] + x3[2 * q], bpd_im = x1[2 * q + 1] + x3[2 * q + 1];
+                // (b - d) multiplied by sign * i
+                const double jbmd_re = -sign * (x1[2 * q + 1] - x3[2 * q + 1]);
+                const double jbmd_im = sign * (x1[2 * q] - x3[2 * q]);
+                const double t1_re = amc_re + jbmd_re, t1_im = amc_im + jbmd_im;
+                const double t2_re = apc_re - bpd_re, t2_im = apc_im - bpd_im;
+                const double t3_re = amc_re - jbmd_re, t3_im = amc_im - jbmd_im;
+                y0[2 * q] = apc_re + bpd_re;
+                y0[2 * q + 1] = apc_im + bpd_im;
+                y1[2 * q] = w1_re * t1_re - w1_im * t1_im;
+                y1[2 * q + 1] = w1_re * t1_im + w1_im * t1_re;
+                y2[2 * q] = w2_re * t2_re - w2_im * t2_im;
+                y2[2 * q + 1] = w2_re * t2_im + w2_im * t2_re;
+                y3[2 * q] = w3_re * t3_re - w3_im * t3_im;
+                y3[2 * q + 1] = w3_re * t3_im + w3_im * t3_re;
+            }
+        }
+        w += 6 * m;
+        n = m;
+        s *= 4;
+        std::swap(x, y);
+    }
+    // final radix-2 stage for odd powers of two
+    if (n == 2)
+    {
+        for (std::size_t q = 0; q < 2 * s; q += 2)
+        {
+            const double a_re = x[q], a_im = x[q + 1];
+            const double b_re = x[q + 2 * s], b_im = x[q + 2 * s + 1];
+            y[q] = a_re + b_re;
+            y[q + 1] = a_im + b_im;
+            y[q + 2 * s] = a_re - b_re;
+            y[q + 2 * s + 1] = a_im - b_im;
+        }
+        std::swap(x, y);
+    }
+    return x;
+}
+
+void hpxfft::util::native_fft::c2c_1d::execute(const double *in, double *out) const
+{
+    double *x = scratch(0, 2 * n_).data();
+    double *y = scratch(1, 2 * n_).data();
+    std::copy(in, in + 2 * n_, x);
+    const double *result = transform(x, y);
+    std::copy(result, result + 2 * n_, out);
+}
+
+void hpxfft::util::native_fft::c2c_1d::flops(double *add, double *mul, double *fma) const
+{
+    std::size_t n_radix_4 = 0;
+    std::size_t n = n_;
+    for (; n >= 4; n /= 4)
+    {
+        ++n_radix_4;
+    }
+    // radix-4 butterfly: 8 complex additions and 3 complex multiplications
+    const double butterflies_4 = static_cast<double>(n_radix_4 * (n_ / 4));
+    const double butterflies_2 = n == 2 ? static_cast<double>(n_ / 2) : 0.0;
+    *add = butterflies_4 * 22.0 + butterflies_2 * 4.0;
+    *mul = butterflies_4 * 12.0;
+    *fma = 0.0;
+}
+
+void hpxfft::util::native_fft::c2c_1d::print_plan(FILE *stream) const
+{
+    fprintf(stream, "(native-stockham-radix4 n=%zu sign=%d)", n_, sign_);
+}
+
+std::size_t hpxfft::util::native_fft::c2c_1d::size() const noexcept { return n_; }
+
+// real FFT: complex FFT of half length and a post-processing step
+void hpxfft::util::native_fft::r2c_1d::plan(int dim_r)
+{
+    if (dim_r < 2 || !is_power_of_two(static_cast<std::size_t>(dim_r)))
+    {
+        throw std::invalid_argument("Native FFT backend supports power-of-two lengths only");
+    }
+    n_ = static_cast<std::size_t>(dim_r);
+    half_.plan(dim_r / 2, -1);
+    twiddles_.clear();
+    for (std::size_t k = 0; 4 * k <= n_; ++k)
+    {
+        store_twiddle(twiddles_, -2.0 * pi * static_cast<double>(k) / static_cast<double>(n_));
+    }
+}
+
+void hpxfft::util::native_fft::r2c_1d::execute(const double *in, double *out) const
+{
+    const std::size_t m = n_ / 2;
+    // z[j] = x[2j] + i x[2j+1]
+    half_.execute(in, out);
+    // Z[m] = Z[0]
+    const double z0_re = out[0];
+    const double z0_im = out[1];
+    out[0] = z0_re + z0_im;
+    out[1] = 0.0;
+    out[2 * m] = z0_re - z0_im;
+    out[2 * m + 1] = 0.0;
+    for (std::size_t k = 1; 2 * k <= m; ++k)
+    {
+        const double w_re = twiddles_[2 * k];
+        const double w_im = twiddles_[2 * k + 1];
+        const double a_re = out[2 * k];
+        const double a_im = out[2 * k + 1];
+        const double b_re = out[2 * (m - k)];
+        const double b_im = out[2 * (m - k) + 1];
+        // E = (A + conj(B)) / 2, O = (A - conj(B)) / 2i
+        const double e_re = 0.5 * (a_re + b_re);
+        const double e_im = 0.5 * (a_im - b_im);
+        const double o_re = 0.5 * (a_im + b_im);
+        const double o_im = -0.5 * (a_re - b_re);
+        // X[k] = E + W^k O, X[m - k] = conj(E - W^k O)
+        const double t_re = w_re * o_re - w_im * o_im;
+        const double t_im = w_re * o_im + w_im * o_re;
+        out[2 * k] = e_re + t_re;
+        out[2 * k + 1] = e_im + t_im;
+        out[2 * (m - k)] = e_re - t_re;
+        out[2 * (m - k) + 1] = t_im - e_im;
+    }
+}
+
+void hpxfft::util::native_fft::r2c_1d::flops(double *add, double *mul, double *fma) const
+{
+    half_.flops(add, mul, fma);
+    // post-processing: one complex multiplication and 6 additions per pair
+    const double pairs = static_cast<double>(n_ / 4);
+    *add += pairs * 8.0 + 2.0;
+    *mul += pairs * 8.0;
+}
+
+void hpxfft::util::native_fft::r2c_1d::print_plan(FILE *stream) const
+{
+    fprintf(stream, "(native-rdft-halfsize n=%zu ", n_);
+    half_.print_plan(stream);
+    fprintf(stream, ")");
+}
+
+// inverse real FFT: pre-processing step and a backward complex FFT of half length
+void hpxfft::util::native_fft::c2r_1d::plan(int dim_r)
+{
+    if (dim_r < 2 || !is_power_of_two(static_cast<std::size_t>(dim_r)))
+    {
+        throw std::invalid_argument("Native FFT backend supports power-of-two lengths only");
+    }
+    n_ = static_cast<std::size_t>(dim_r);
+    half_.plan(dim_r / 2, 1);
+    twiddles_.clear();
+    for (std::size_t k = 0; 4 * k <= n_; ++k)
+    {
+        store_twiddle(twiddles_, -2.0 * pi * static_cast<double>(k) / static_cast<double>(n_));
+    }
+}
+
+void hpxfft::util::native_fft::c2r_1d::execute(const double *in, double *out) const
+{
+    const std::size_t m = n_ / 2;
+    double *z = scratch(2, 2 * m).data();
+    // Z[k] = E[k] + i O[k], scaled by 2 for the unnormalized result of length n
+    // E[k] = X[k] + conj(X[m - k]), O[k] = (X[k] - conj(X[m - k])) conj(W^k)
+    z[0] = in[0] + in[2 * m] - (in[1] + in[2 * m + 1]);
+    z[1] = in[1] - in[2 * m + 1] + (in[0] - in[2 * m]);
+    for (std::size_t k = 1; 2 * k <= m; ++k)
+    {
+        const double w_re = twiddles_[2 * k];
+        const double w_im = twiddles_[2 * k + 1];
+        const double a_re = in[2 * k];
+        const double a_im = in[2 * k + 1];
+        const double b_re = in[2 * (m - k)];
+        const double b_im = in[2 * (m - k) + 1];
+        const double e_re = a_re + b_re;
+        const double e_im = a_im - b_im;
+        const double d_re = a_re - b_re;
+        const double d_im = a_im + b_im;
+        // O[k] = d conj(W^k)
+        const double o_re = d_re * w_re + d_im * w_im;
+        const double o_im = d_im * w_re - d_re * w_im;
+        z[2 * k] = e_re - o_im;
+        z[2 * k + 1] = e_im + o_re;
+        // partner: E[m - k] = conj(E[k]), O[m - k] = conj(O[k])
+        z[2 * (m - k)] = e_re + o_im;
+        z[2 * (m - k) + 1] = -e_im + o_re;
+    }
+    // z[j] = x[2j] + i x[2j+1]
+    half_.execute(z, out);
+}
+
+void hpxfft::util::native_fft::c2r_1d::flops(double *add, double *mul, double *fma) const
+{
+    half_.flops(add, mul, fma);
+    // pre-processing: one complex multiplication and 8 additions per pair
+    const double pairs = static_cast<double>(n_ / 4);
+    *add += pairs * 10.0 + 4.0;
+    *mul += pairs * 4.0;
+}
+
+void hpxfft::util::native_fft::c2r_1d::print_plan(FILE *stream) const
+{
+    fprintf(stream, "(native-rdft-inverse-halfsize n=%zu ", n_);
+    half_.print_plan(stream);
+    fprintf(stream, ")");
+}
@@ -0,0 +1,234 @@
+#include "../../include/hpxfft/util/task_graph.hpp"
+
+#include "../../include/hpxfft/util/thread_pools.hpp"
+#include <mutex>
+
+std::size_t hpxfft::util::task_graph::add_node(std::function<void()> work)
+{
+    return add_node(std::move(work), hpxfft::util::compute_executor());
+}
+
+std::size_t hpxfft::util::task_graph::add_node(std::function<void()> work, hpx::execution::parallel_executor executor)
+{
+    nodes_.push_back(node{ std::move(work), std::move(executor), {}, 0 });
+    modified_ = true;
+    return nodes_.size() - 1;
+}
+
+void hpxfft::util::task_graph::add_edge(std::size_t from, std::size_t to)
+{
+    nodes_[from].successors_.push_back(to);
+    ++nodes_[to].num_predecessors_;
+    modified_ = true;
+}
+
+void hpxfft::util::task_graph::set_priority(std::size_t i, hpx::threads::thread_priority priority)
+{
+    nodes_[i].executor_ = hpx::execution::experimental::with_priority(nodes_[i].executor_, priority);
+    nodes_[i].critical_ = priority == hpx::threads::thread_priority::high
+                          || priority == hpx::threads::thread_priority::high_recursive
+                          || priority == hpx::threads::thread_priority::boost;
+    modified_ = true;
+}
+
+void hpxfft::util::task_graph::set_background_limit(std::size_t max_running) { background_limit_ = max_running; }
+
+std::size_t hpxfft::util::task_graph::size() const noexcept { return nodes_.size(); }
+
+void hpxfft::util::task_graph::clear()
+{
+    nodes_.clear();
+    roots_.clear();
+    counters_.reset();
+    num_critical_ = 0;
+    modified_ = true;
+}
+
+void hpxfft::util::task_graph::execute(std::size_t i)
+{
+    constexpr std::size_t none = static_cast<std::size_t>(-1);
+    while (true)
+    {
+        // after a failure the remaining nodes only drain
+        bool succeeded = !failed_.load(std::memory_order_acquire);
+        if (succeeded && nodes_[i].work_)
+        {
+            try
+            {
+                nodes_[i].work_();
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+                succeeded = false;
+            }
+        }
+        // release successors, continue with the first ready one on the same executor
+        std::size_t next = none;
+        if (succeeded)
+        {
+            for (const std::size_t successor : nodes_[i].successors_)
+            {
+                if (counters_[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    in_flight_.fetch_add(1, std::memory_order_relaxed);
+                    if (next == none && nodes_[successor].executor_ == nodes_[i].executor_
+                        && nodes_[successor].critical_ == nodes_[i].critical_)
+                    {
+                        next = successor;
+                    }
+                    else
+                    {
+                        spawn(successor);
+                    }
+                }
+            }
+        }
+        if (nodes_[i].critical_)
+        {
+            if (critical_remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                release_deferred();
+            }
+        }
+        else if (background_limit_ > 0 && next == none)
+        {
+            // an inlined successor keeps the slot
+            release_background_slot();
+        }
+        finish_node();
+        if (next == none)
+        {
+            return;
+        }
+        i = next;
+    }
+}
+
+void hpxfft::util::task_graph::spawn(std::size_t i)
+{
+    if (!nodes_[i].critical_ && background_limit_ > 0)
+    {
+        std::lock_guard<hpx::mutex> lock(background_mutex_);
+        if (failed_.load(std::memory_order_acquire))
+        {
+            finish_node();
+            return;
+        }
+        if (critical_remaining_.load(std::memory_order_acquire) > 0 && running_background_ >= background_limit_)
+        {
+            deferred_.push_back(i);
+            return;
+        }
+        ++running_background_;
+    }
+    hpx::post(nodes_[i].executor_, &task_graph::execute, this, i);
+}
+
+void hpxfft::util::task_graph::release_background_slot()
+{
+    std::unique_lock<hpx::mutex> lock(background_mutex_);
+    if (deferred_.empty())
+    {
+        --running_background_;
+        return;
+    }
+    const std::size_t i = deferred_.front();
+    deferred_.pop_front();
+    lock.unlock();
+    hpx::post(nodes_[i].executor_, &task_graph::execute, this, i);
+}
+
+void hpxfft::util::task_graph::release_deferred()
+{
+    std::deque<std::size_t> deferred;
+    {
+        std::lock_guard<hpx::mutex> lock(background_mutex_);
+        deferred.swap(deferred_);
+        running_background_ += deferred.size();
+    }
+    for (const std::size_t i : deferred)
+    {
+        hpx::post(nodes_[i].executor_, &task_graph::execute, this, i);
+    }
+}
+
+void hpxfft::util::task_graph::fail(std::exception_ptr error)
+{
+    std::deque<std::size_t> deferred;
+    {
+        std::lock_guard<hpx::mutex> lock(background_mutex_);
+        if (!error_)
+        {
+            error_ = std::move(error);
+        }
+        failed_.store(true, std::memory_order_release);
+        deferred.swap(deferred_);
+    }
+    // deferred nodes never start, the failing node keeps the run alive
+    in_flight_.fetch_sub(deferred.size(), std::memory_order_acq_rel);
+}
+
+void hpxfft::util::task_graph::finish_node()
+{
+    if (in_flight_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        if (failed_.load(std::memory_order_acquire))
+        {
+            done_.set_exception(error_);
+        }
+        else
+        {
+            done_.set_value();
+        }
+    }
+}
+
+void hpxfft::util::task_graph::run() { run_async().get(); }
+
+hpx::future<void> hpxfft::util::task_graph::run_async()
+{
+    if (nodes_.empty())
+    {
+        return hpx::make_ready_future();
+    }
+    const std::size_t num_nodes = nodes_.size();
+    // (re)build counters and roots after the graph changed
+    if (modified_)
+    {
+        counters_ = std::make_unique<std::atomic<std::size_t>[]>(num_nodes);
+        roots_.clear();
+        num_critical_ = 0;
+        for (std::size_t i = 0; i < num_nodes; ++i)
+        {
+            if (nodes_[i].num_predecessors_ == 0)
+            {
+                roots_.push_back(i);
+            }
+            if (nodes_[i].critical_)
+            {
+                ++num_critical_;
+            }
+        }
+        modified_ = false;
+    }
+    // reset dependency counters
+    for (std::size_t i = 0; i < num_nodes; ++i)
+    {
+        counters_[i].store(nodes_[i].num_predecessors_, std::memory_order_relaxed);
+    }
+    in_flight_.store(roots_.size(), std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    error_ = nullptr;
+    critical_remaining_.store(num_critical_, std::memory_order_relaxed);
+    running_background_ = 0;
+    deferred_.clear();
+    done_ = hpx::promise<void>();
+    hpx::future<void> done = done_.get_future();
+    // spawn all nodes without dependencies
+    for (const std::size_t root : roots_)
+    {
+        spawn(root);
+    }
+    return done;
+}
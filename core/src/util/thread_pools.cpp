@@ -0,0 +1,107 @@
+#include "../../include/hpxfft/util/thread_pools.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <hpx/runtime.hpp>
+
+void hpxfft::util::create_communication_pool(hpx::resource::partitioner &rp, std::size_t n_cores)
+{
+    if (n_cores == 0)
+    {
+        return;
+    }
+    // at least one core has to remain for the default pool
+    std::size_t n_cores_total = 0;
+    for (const hpx::resource::numa_domain &domain : rp.numa_domains())
+    {
+        n_cores_total += domain.cores().size();
+    }
+    n_cores = std::min(n_cores, n_cores_total - 1);
+    if (n_cores == 0)
+    {
+        return;
+    }
+    rp.create_thread_pool(communication_pool_name, hpx::resource::scheduling_policy::local_priority_fifo);
+    // take the last n_cores cores, the default pool keeps the first ones
+    std::size_t core_index = 0;
+    for (const hpx::resource::numa_domain &domain : rp.numa_domains())
+    {
+        for (const hpx::resource::core &core : domain.cores())
+        {
+            if (core_index >= n_cores_total - n_cores)
+            {
+                rp.add_resource(core, communication_pool_name);
+            }
+            ++core_index;
+        }
+    }
+}
+
+hpx::execution::parallel_executor hpxfft::util::communication_executor()
+{
+    if (hpx::resource::pool_exists(communication_pool_name))
+    {
+        return hpx::execution::parallel_executor(&hpx::resource::get_thread_pool(communication_pool_name));
+    }
+    return compute_executor();
+}
+
+hpx::execution::parallel_executor hpxfft::util::compute_executor()
+{
+    return hpx::execution::parallel_executor(&hpx::resource::get_thread_pool("default"));
+}
+
+std::size_t hpxfft::util::compute_thread_count()
+{
+    return hpx::resource::get_thread_pool("default").get_os_thread_count();
+}
+
+hpx::execution::parallel_executor hpxfft::util::worker_executor(std::size_t worker)
+{
+    // the hint selects the worker thread, bound priority prevents work stealing
+    const auto hint = hpx::threads::thread_schedule_hint(static_cast<std::int16_t>(worker % compute_thread_count()));
+    return hpx::execution::experimental::with_hint(
+        hpx::execution::experimental::with_priority(compute_executor(), hpx::threads::thread_priority::bound), hint);
+}
+
+std::size_t hpxfft::util::background_task_limit() { return std::max(compute_thread_count(), std::size_t(2)) - 1; }
+
+hpx::future<void> hpxfft::util::background_for_loop(hpx::execution::parallel_executor executor,
+                                                    std::size_t first,
+                                                    std::size_t last,
+                                                    std::function<void(std::size_t)> body)
+{
+    if (first >= last)
+    {
+        return hpx::make_ready_future();
+    }
+    const std::size_t n = last - first;
+    const std::size_t n_tasks = std::min(background_task_limit(), n);
+    // the tasks share the loop body, each one runs a contiguous block
+    auto shared_body = std::make_shared<std::function<void(std::size_t)>>(std::move(body));
+    std::vector<hpx::future<void>> tasks(n_tasks);
+    for (std::size_t t = 0; t < n_tasks; ++t)
+    {
+        const std::size_t begin = first + t * n / n_tasks;
+        const std::size_t end = first + (t + 1) * n / n_tasks;
+        tasks[t] = hpx::async(executor,
+                              [shared_body, begin, end]
+                              {
+                                  for (std::size_t i = begin; i < end; ++i)
+                                  {
+                                      (*shared_body)(i);
+                                  }
+                              });
+    }
+    return hpx::when_all(std::move(tasks))
+        .then(
+            [](hpx::future<std::vector<hpx::future<void>>> r)
+            {
+                for (hpx::future<void> &f : r.get())
+                {
+                    f.get();
+                }
+            });
+}
@@ -1,6 +1,7 @@
 #include "hpxfft/2D/distributed/agas.hpp"      // for hpxfft::fft2D::distributed::agas, hpxfft::fft2D::distributed::vector_2d
 #include "hpxfft/util/create_dir.hpp"       // for hpxfft::util::create_parent_dir
 #include "hpxfft/util/print_vector_2d.hpp"  // for hpxfft::util::print_vector_2d
+#include "hpxfft/util/thread_pools.hpp"     // for hpxfft::util::create_communication_pool
 #include <fstream>                          // for std::ofstream
 #include <hpx/hpx_init.hpp>
 #include <numeric>  // for std::iota
@@ -96,11 +97,14 @@ int main(int argc, char *argv[])
         "result", value<bool>()->default_value(0), "Print generated results (default: false)")(
         "nx", value<std::size_t>()->default_value(8), "Total x dimension")(
         "ny", value<std::size_t>()->default_value(14), "Total y dimension")(
-        "plan", value<std::string>()->default_value("estimate"), "FFTW plan (default: estimate)")(
+        "plan", value<std::string>()->default_value("estimate"), "FFTW plan or native (default: estimate)")(
         "run",
         value<std::string>()->default_value("scatter"),
         "Choose 2d FFT algorithm communication: scatter or all_to_all")(
-        "header", value<bool>()->default_value(0), "Write runtime file header");
+        "header", value<bool>()->default_value(0), "Write runtime file header")(
+        "comm_cores",
+        value<std::size_t>()->default_value(0),
+        "Cores of the communication thread pool (default: 0, single pool)");
 
     // Initialize and run HPX, this example requires to run hpx_main on all
     // localities
@@ -109,6 +113,9 @@ int main(int argc, char *argv[])
     hpx::init_params init_args;
     init_args.desc_cmdline = desc_commandline;
     init_args.cfg = cfg;
+    // optional dedicated thread pool for the collectives
+    init_args.rp_callback = [](hpx::resource::partitioner &rp, const hpx::program_options::variables_map &vm)
+    { hpxfft::util::create_communication_pool(rp, vm["comm_cores"].as<std::size_t>()); };
 
     return hpx::init(argc, argv, init_args);
 }
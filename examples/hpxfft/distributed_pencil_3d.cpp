@@ -0,0 +1,176 @@
+#include "hpxfft/3D/distributed/pencil.hpp" // for hpxfft::fft3D::distributed::pencil, hpxfft::fft3D::distributed::vector_3d
+#include "hpxfft/util/create_dir.hpp"       // for hpxfft::util::create_parent_dir
+#include "hpxfft/util/print_vector_3d.hpp"  // for hpxfft::util::print_vector_3d
+#include "hpxfft/util/thread_pools.hpp"     // for hpxfft::util::create_communication_pool
+#include <fstream>                          // for std::ofstream
+#include <hpx/hpx_init.hpp>
+
+int hpx_main(hpx::program_options::variables_map &vm)
+{
+    ////////////////////////////////////////////////////////////////
+    // Parameters and Data structures
+    const std::size_t this_locality = hpx::get_locality_id();
+    const std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    const std::size_t n_rows =
+        vm["rows"].as<std::size_t>() == 0 ? hpxfft::fft3D::distributed::pencil::default_grid_rows(num_localities)
+                                          : vm["rows"].as<std::size_t>();
+    const std::size_t n_cols = num_localities / n_rows;
+    const std::string plan_flag = vm["plan"].as<std::string>();
+    bool print_result = vm["result"].as<bool>();
+    bool print_header = vm["header"].as<bool>();
+    // time measurement
+    auto t = hpx::chrono::high_resolution_timer();
+    // FFT dimension parameters
+    const std::size_t dim_c_x = vm["nx"].as<std::size_t>();  // N_X;
+    const std::size_t dim_c_y = vm["ny"].as<std::size_t>();  // N_Y;
+    const std::size_t dim_r_z = vm["nz"].as<std::size_t>();  // N_Z;
+    const std::size_t dim_c_z = dim_r_z / 2 + 1;
+    // division parameters
+    const std::size_t n_x_local = dim_c_x / n_rows;
+    const std::size_t n_y_local = dim_c_y / n_cols;
+
+    ////////////////////////////////////////////////////////////////
+    // Initialization
+    hpxfft::fft3D::distributed::vector_3d values_vec(n_x_local, n_y_local, 2 * dim_c_z);
+    for (std::size_t i = 0; i < n_x_local; ++i)
+    {
+        for (std::size_t j = 0; j < n_y_local; ++j)
+        {
+            for (std::size_t k = 0; k < dim_r_z; ++k)
+            {
+                values_vec(i, j, k) = k;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Computation
+    hpxfft::fft3D::distributed::pencil fft_computer;
+    auto start_total = t.now();
+    fft_computer.initialize(std::move(values_vec), n_rows, plan_flag);
+    auto stop_init = t.now();
+    values_vec = fft_computer.fft_3d_r2c();
+    auto stop_total = t.now();
+
+    // optional: print results
+    if (print_result)
+    {
+        sleep(this_locality);
+        hpxfft::util::print_vector_3d(values_vec);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Postprocessing
+    // print and store runtimes if on locality 0
+    if (this_locality == 0)
+    {
+        auto total = stop_total - start_total;
+        auto init = stop_init - start_total;
+        std::string msg =
+            "\nLocality {20} - {1} x {2} grid:\n"
+            "Total runtime : {3}\n"
+            "Initialization: {4}\n"
+            "FFT 3D runtime: {5}\n"
+            "FFTW r2c      : {6}\n"
+            "First split   : {7}\n"
+            "First comm    : {8}\n"
+            "First trans   : {9}\n"
+            "FFTW c2c 1    : {10}\n"
+            "Second split  : {11}\n"
+            "Second comm   : {12}\n"
+            "Second trans  : {13}\n"
+            "FFTW c2c 2    : {14}\n"
+            "Third split   : {15}\n"
+            "Third comm    : {16}\n"
+            "Third trans   : {17}\n"
+            "Fourth comm   : {18}\n"
+            "Plan time     : {19}\n";
+        hpx::util::format_to(std::cout,
+                             msg,
+                             n_rows,
+                             n_cols,
+                             total,
+                             init,
+                             fft_computer.get_measurement("total"),
+                             fft_computer.get_measurement("first_fftw"),
+                             fft_computer.get_measurement("first_split"),
+                             fft_computer.get_measurement("first_comm"),
+                             fft_computer.get_measurement("first_trans"),
+                             fft_computer.get_measurement("second_fftw"),
+                             fft_computer.get_measurement("second_split"),
+                             fft_computer.get_measurement("second_comm"),
+                             fft_computer.get_measurement("second_trans"),
+                             fft_computer.get_measurement("third_fftw"),
+                             fft_computer.get_measurement("third_split"),
+                             fft_computer.get_measurement("third_comm"),
+                             fft_computer.get_measurement("third_trans"),
+                             fft_computer.get_measurement("fourth_comm"),
+                             fft_computer.get_measurement("plan"),
+                             this_locality)
+            << std::flush;
+
+        std::string runtime_file_path = "runtimes/runtimes_hpx_distributed_pencil_3d.txt";
+        hpxfft::util::create_parent_dir(runtime_file_path);
+        std::ofstream runtime_file;
+        runtime_file.open(runtime_file_path, std::ios_base::app);
+
+        const std::vector<std::string> phases = { "first_fftw",   "first_split",  "first_comm",   "first_trans",
+                                                  "second_fftw",  "second_split", "second_comm",  "second_trans",
+                                                  "third_fftw",   "third_split",  "third_comm",   "third_trans",
+                                                  "fourth_split", "fourth_comm",  "fourth_trans", "plan" };
+        if (print_header)
+        {
+            runtime_file << "n_threads;n_localities;n_rows;n_cols;n_x;n_y;n_z;plan;total;initialization;fft_3d_total;";
+            for (const std::string &phase : phases)
+            {
+                runtime_file << phase << ";";
+            }
+            runtime_file << "\n";
+        }
+        runtime_file << hpx::get_os_thread_count() << ";" << num_localities << ";" << n_rows << ";" << n_cols << ";"
+                     << dim_c_x << ";" << dim_c_y << ";" << dim_r_z << ";" << plan_flag << ";" << total << ";" << init
+                     << ";" << fft_computer.get_measurement("total") << ";";
+        for (const std::string &phase : phases)
+        {
+            runtime_file << fft_computer.get_measurement(phase) << ";";
+        }
+        runtime_file << "\n";
+        runtime_file.close();
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Finalize HPX runtime
+    return hpx::finalize();
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace hpx::program_options;
+
+    options_description desc_commandline;
+    desc_commandline.add_options()(
+        "result", value<bool>()->default_value(0), "Print generated results (default: false)")(
+        "nx", value<std::size_t>()->default_value(8), "Total x dimension")(
+        "ny", value<std::size_t>()->default_value(8), "Total y dimension")(
+        "nz", value<std::size_t>()->default_value(16), "Total z dimension")(
+        "plan", value<std::string>()->default_value("estimate"), "FFTW plan or native (default: estimate)")(
+        "rows",
+        value<std::size_t>()->default_value(0),
+        "Rows of the locality grid, has to divide the number of localities (default: 0, most square grid)")(
+        "header", value<bool>()->default_value(0), "Write runtime file header")(
+        "comm_cores",
+        value<std::size_t>()->default_value(0),
+        "Cores of the communication thread pool (default: 0, single pool)");
+
+    // Initialize and run HPX, this example requires to run hpx_main on all
+    // localities
+    const std::vector<std::string> cfg = { "hpx.run_hpx_main!=1" };
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+    init_args.cfg = cfg;
+    // optional dedicated thread pool for the collectives
+    init_args.rp_callback = [](hpx::resource::partitioner &rp, const hpx::program_options::variables_map &vm)
+    { hpxfft::util::create_communication_pool(rp, vm["comm_cores"].as<std::size_t>()); };
+    return hpx::init(argc, argv, init_args);
+}
@@ -0,0 +1,156 @@
+#include "hpxfft/ND/shared/engine.hpp"  // for hpxfft::fftND::shared::engine, hpxfft::fftND::shared::vector_nd
+#include "hpxfft/util/create_dir.hpp"   // for hpxfft::util::create_parent_dir
+#include <fstream>                      // for std::ofstream
+#include <hpx/hpx_init.hpp>
+
+using vector_4d = hpxfft::fftND::shared::vector_nd<4>;
+
+// run the 4D engine with the given scheduling policy, returns the FFT runtime
+template <typename Policy>
+real run_engine(vector_4d values_vec, const std::string &plan_flag, const std::size_t tile_dim, bool print_result)
+{
+    hpxfft::fftND::shared::engine<4, Policy> fft_computer;
+    fft_computer.initialize(std::move(values_vec), plan_flag, tile_dim);
+    values_vec = fft_computer.fft_nd_r2c();
+
+    // optional: print results
+    if (print_result)
+    {
+        for (std::size_t i = 0; i < values_vec.size(); i += 2)
+        {
+            std::cout << "(" << values_vec.data()[i] << " " << values_vec.data()[i + 1] << ") ";
+        }
+        std::cout << "\n";
+    }
+
+    std::string msg =
+        "FFT 4D runtime: {1}\n"
+        "Plan time     : {2}\n"
+        "Plan flops    : {3}\n";
+    hpx::util::format_to(std::cout,
+                         msg,
+                         fft_computer.get_measurement("total"),
+                         fft_computer.get_measurement("plan"),
+                         fft_computer.get_measurement("plan_flops"))
+        << std::flush;
+
+    // store plan info
+    std::string plan_file_path = "plans/plan_hpx_shared_engine_4d.txt";
+    hpxfft::util::create_parent_dir(plan_file_path);
+    fft_computer.write_plans_to_file(plan_file_path);
+
+    return fft_computer.get_measurement("total");
+}
+
+int hpx_main(hpx::program_options::variables_map &vm)
+{
+    ////////////////////////////////////////////////////////////////
+    // Check if shared memory
+    const std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    if (std::size_t(1) != num_localities)
+    {
+        std::cout << "Localities " << num_localities << " instead of 1: Abort runtime\n";
+        return hpx::finalize();
+    }
+    ////////////////////////////////////////////////////////////////
+    // Parameters and Data structures
+    const std::string run_flag = vm["run"].as<std::string>();
+    const std::string plan_flag = vm["plan"].as<std::string>();
+    const std::size_t tile_dim = vm["tile"].as<std::size_t>();
+    bool print_result = vm["result"].as<bool>();
+    bool print_header = vm["header"].as<bool>();
+    // time measurement
+    auto t = hpx::chrono::high_resolution_timer();
+    // FFT dimension parameters: time and space
+    const std::size_t dim_c_t = vm["nt"].as<std::size_t>();  // N_T;
+    const std::size_t dim_c_x = vm["nx"].as<std::size_t>();  // N_X;
+    const std::size_t dim_c_y = vm["ny"].as<std::size_t>();  // N_Y;
+    const std::size_t dim_r_z = vm["nz"].as<std::size_t>();  // N_Z;
+    const std::size_t dim_c_z = dim_r_z / 2 + 1;
+
+    ////////////////////////////////////////////////////////////////
+    // Initialization
+    vector_4d values_vec({dim_c_t, dim_c_x, dim_c_y, 2 * dim_c_z});
+    for (std::size_t l = 0; l < dim_c_t; ++l)
+    {
+        for (std::size_t i = 0; i < dim_c_x; ++i)
+        {
+            for (std::size_t j = 0; j < dim_c_y; ++j)
+            {
+                for (std::size_t k = 0; k < dim_r_z; ++k)
+                {
+                    values_vec(l, i, j, k) = k;
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Computation
+    auto start_total = t.now();
+    real fft_total;
+    if (run_flag == "sync")
+    {
+        fft_total = run_engine<hpxfft::fftND::shared::policy::sync>(
+            std::move(values_vec), plan_flag, tile_dim, print_result);
+    }
+    else if (run_flag == "dataflow")
+    {
+        fft_total = run_engine<hpxfft::fftND::shared::policy::dataflow>(
+            std::move(values_vec), plan_flag, tile_dim, print_result);
+    }
+    else
+    {
+        fft_total = run_engine<hpxfft::fftND::shared::policy::loop>(
+            std::move(values_vec), plan_flag, tile_dim, print_result);
+    }
+    auto stop_total = t.now();
+
+    ////////////////////////////////////////////////////////////////
+    // Postprocessing
+    // print and store runtimes
+    auto total = stop_total - start_total;
+    std::string msg =
+        "\nLocality 0 - shared - {1}\n"
+        "Total runtime : {2}\n";
+    hpx::util::format_to(std::cout, msg, run_flag, total) << std::flush;
+
+    std::string runtime_file_path = "runtimes/runtimes_hpx_shared_engine_4d.txt";
+    hpxfft::util::create_parent_dir(runtime_file_path);
+    std::ofstream runtime_file;
+    runtime_file.open(runtime_file_path, std::ios_base::app);
+
+    if (print_header)
+    {
+        runtime_file << "n_threads;n_t;n_x;n_y;n_z;plan;run_flag;tile;total;fft_4d_total;\n";
+    }
+    runtime_file << hpx::get_os_thread_count() << ";" << dim_c_t << ";" << dim_c_x << ";" << dim_c_y << ";" << dim_r_z
+                 << ";" << plan_flag << ";" << run_flag << ";" << tile_dim << ";" << total << ";" << fft_total << ";\n";
+    runtime_file.close();
+
+    ////////////////////////////////////////////////////////////////
+    // Finalize HPX runtime
+    return hpx::finalize();
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace hpx::program_options;
+
+    options_description desc_commandline;
+    desc_commandline.add_options()(
+        "result", value<bool>()->default_value(0), "Print generated results (default: false)")(
+        "nt", value<std::size_t>()->default_value(4), "Total t dimension")(
+        "nx", value<std::size_t>()->default_value(8), "Total x dimension")(
+        "ny", value<std::size_t>()->default_value(14), "Total y dimension")(
+        "nz", value<std::size_t>()->default_value(16), "Total z dimension")(
+        "plan", value<std::string>()->default_value("estimate"), "FFTW plan (default: estimate)")(
+        "run", value<std::string>()->default_value("loop"), "Choose scheduling policy: loop, sync or dataflow")(
+        "tile", value<std::size_t>()->default_value(32), "Permute tile size in complex entries")(
+        "header", value<bool>()->default_value(0), "Write runtime file header");
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+
+    return hpx::init(argc, argv, init_args);
+}
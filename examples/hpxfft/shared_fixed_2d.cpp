@@ -0,0 +1,98 @@
+#include "hpxfft/2D/shared/fixed.hpp"  // for hpxfft::fft2D::shared::fixed_fft_2d, hpxfft::fft2D::shared::vector_2d
+#include "hpxfft/util/create_dir.hpp"  // for hpxfft::util::create_parent_dir
+#include <fstream>                     // for std::ofstream
+#include <hpx/hpx_init.hpp>
+
+// repeated in-place transforms of one compile-time shape, returns runtime
+template <std::size_t N>
+double run_fixed(std::size_t n_runs)
+{
+    using fixed_fft = hpxfft::fft2D::shared::fixed_fft_2d<N, N>;
+    hpxfft::fft2D::shared::vector_2d values_vec(N, fixed_fft::n_col);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            values_vec(i, j) = j;
+        }
+    }
+    auto t = hpx::chrono::high_resolution_timer();
+    auto start = t.now();
+    for (std::size_t run = 0; run < n_runs; ++run)
+    {
+        fixed_fft::fft_2d_r2c_inplace(values_vec.data());
+    }
+    return t.now() - start;
+}
+
+int hpx_main(hpx::program_options::variables_map &vm)
+{
+    ////////////////////////////////////////////////////////////////
+    // Parameters and Data structures
+    const std::size_t size = vm["size"].as<std::size_t>();
+    const std::size_t n_runs = vm["runs"].as<std::size_t>();
+    bool print_header = vm["header"].as<bool>();
+
+    ////////////////////////////////////////////////////////////////
+    // Computation
+    double total;
+    switch (size)
+    {
+    case 8:
+        total = run_fixed<8>(n_runs);
+        break;
+    case 16:
+        total = run_fixed<16>(n_runs);
+        break;
+    case 32:
+        total = run_fixed<32>(n_runs);
+        break;
+    case 64:
+        total = run_fixed<64>(n_runs);
+        break;
+    default:
+        std::cout << "Size " << size << " not instantiated: choose 8, 16, 32 or 64\n";
+        return hpx::finalize();
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Postprocessing
+    // print and store runtimes
+    std::string msg =
+        "\nLocality 0 - fixed -\n"
+        "Total runtime : {1}\n"
+        "FFT 2D runtime: {2}\n";
+    hpx::util::format_to(std::cout, msg, total, total / n_runs) << std::flush;
+
+    std::string runtime_file_path = "runtimes/runtimes_hpx_shared_fixed.txt";
+    hpxfft::util::create_parent_dir(runtime_file_path);
+    std::ofstream runtime_file;
+    runtime_file.open(runtime_file_path, std::ios_base::app);
+
+    if (print_header)
+    {
+        runtime_file << "n_x;n_y;runs;total;fft_2d_total;\n";
+    }
+    runtime_file << size << ";" << size << ";" << n_runs << ";" << total << ";" << total / n_runs << ";\n";
+    runtime_file.close();
+
+    ////////////////////////////////////////////////////////////////
+    // Finalize HPX runtime
+    return hpx::finalize();
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace hpx::program_options;
+
+    options_description desc_commandline;
+    desc_commandline.add_options()(
+        "size", value<std::size_t>()->default_value(16), "Square dimension: 8, 16, 32 or 64")(
+        "runs", value<std::size_t>()->default_value(100000), "Number of repeated transforms")(
+        "header", value<bool>()->default_value(0), "Write runtime file header");
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+
+    return hpx::init(argc, argv, init_args);
+}
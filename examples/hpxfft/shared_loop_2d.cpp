@@ -19,6 +19,9 @@ int hpx_main(hpx::program_options::variables_map &vm)
     // Parameters and Data structures
     const std::string run_flag = vm["run"].as<std::string>();
     const std::string plan_flag = vm["plan"].as<std::string>();
+    const std::string chunk_flag = vm["chunk"].as<std::string>();
+    const std::size_t chunk_size = vm["chunk_size"].as<std::size_t>();
+    const std::size_t n_runs = vm["runs"].as<std::size_t>();
     bool print_result = vm["result"].as<bool>();
     bool print_header = vm["header"].as<bool>();
     // time measurement
@@ -41,17 +44,38 @@ int hpx_main(hpx::program_options::variables_map &vm)
 
     ////////////////////////////////////////////////////////////////
     // Computation
+    // same chunking for all parallel phases
+    const hpxfft::util::chunk_param chunk{ hpxfft::util::string_to_chunk_policy(chunk_flag), chunk_size };
+    const hpxfft::fft2D::shared::loop_chunking chunking{ chunk, chunk, chunk, chunk };
+    // keep input for repeated runs
+    hpxfft::fft2D::shared::vector_2d input_vec;
+    if (n_runs > 1)
+    {
+        input_vec = values_vec;
+    }
     hpxfft::fft2D::shared::loop fft_computer;
     auto start_total = t.now();
-    fft_computer.initialize(std::move(values_vec), plan_flag);
+    fft_computer.initialize(std::move(values_vec), plan_flag, chunking);
     auto stop_init = t.now();
-    if (run_flag == "seq")
-    {
-        values_vec = fft_computer.fft_2d_r2c_seq();
-    }
-    else
+    // with chunk tuning, the last run uses the locked in chunking
+    for (std::size_t run = 0; run < n_runs; ++run)
     {
-        values_vec = fft_computer.fft_2d_r2c_par();
+        if (run > 0)
+        {
+            fft_computer.set_values(input_vec);
+        }
+        if (run_flag == "seq")
+        {
+            values_vec = fft_computer.fft_2d_r2c_seq();
+        }
+        else if (run_flag == "affinity")
+        {
+            values_vec = fft_computer.fft_2d_r2c_affinity();
+        }
+        else
+        {
+            values_vec = fft_computer.fft_2d_r2c_par();
+        }
     }
     auto stop_total = t.now();
 
@@ -141,8 +165,13 @@ int main(int argc, char *argv[])
         "result", value<bool>()->default_value(0), "Print generated results (default: false)")(
         "nx", value<std::size_t>()->default_value(8), "Total x dimension")(
         "ny", value<std::size_t>()->default_value(14), "Total y dimension")(
-        "plan", value<std::string>()->default_value("estimate"), "FFTW plan (default: estimate)")(
-        "run", value<std::string>()->default_value("par"), "Choose 2d FFT algorithm: par or seq")(
+        "plan", value<std::string>()->default_value("estimate"), "FFTW plan or native (default: estimate)")(
+        "run", value<std::string>()->default_value("par"), "Choose 2d FFT algorithm: par, affinity or seq")(
+        "chunk",
+        value<std::string>()->default_value("auto"),
+        "Loop chunking: auto, static, dynamic, guided or tune")(
+        "chunk_size", value<std::size_t>()->default_value(0), "Chunk size (default: HPX default)")(
+        "runs", value<std::size_t>()->default_value(1), "Number of repeated transforms")(
         "header", value<bool>()->default_value(0), "Write runtime file header");
 
     hpx::init_params init_args;
@@ -94,7 +94,7 @@ int main(int argc, char *argv[])
         "result", value<bool>()->default_value(0), "Print generated results (default: false)")(
         "nx", value<std::size_t>()->default_value(8), "Total x dimension")(
         "ny", value<std::size_t>()->default_value(14), "Total y dimension")(
-        "plan", value<std::string>()->default_value("estimate"), "FFTW plan (default: estimate)")(
+        "plan", value<std::string>()->default_value("estimate"), "FFTW plan or native (default: estimate)")(
         "header", value<bool>()->default_value(0), "Write runtime file header");
 
     hpx::init_params init_args;
@@ -0,0 +1,112 @@
+#include "hpxfft/2D/shared/service.hpp"  // for hpxfft::fft2D::shared::service, hpxfft::fft2D::shared::vector_2d
+#include "hpxfft/util/create_dir.hpp"    // for hpxfft::util::create_parent_dir
+#include <fstream>                       // for std::ofstream
+#include <hpx/hpx_init.hpp>
+
+int hpx_main(hpx::program_options::variables_map &vm)
+{
+    ////////////////////////////////////////////////////////////////
+    // Check if shared memory
+    const std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    if (std::size_t(1) != num_localities)
+    {
+        std::cout << "Localities " << num_localities << " instead of 1: Abort runtime\n";
+        return hpx::finalize();
+    }
+    ////////////////////////////////////////////////////////////////
+    // Parameters and Data structures
+    const std::string plan_flag = vm["plan"].as<std::string>();
+    const std::size_t n_transforms = vm["transforms"].as<std::size_t>();
+    const std::size_t max_batch = vm["batch"].as<std::size_t>();
+    bool print_header = vm["header"].as<bool>();
+    // time measurement
+    auto t = hpx::chrono::high_resolution_timer();
+    // FFT dimension parameters
+    const std::size_t dim_c_x = vm["nx"].as<std::size_t>();  // N_X;
+    const std::size_t dim_r_y = vm["ny"].as<std::size_t>();  // N_Y;
+    const std::size_t dim_c_y = dim_r_y / 2 + 1;
+
+    ////////////////////////////////////////////////////////////////
+    // Initialization
+    hpxfft::fft2D::shared::vector_2d values_vec(dim_c_x, 2 * dim_c_y);
+    for (std::size_t i = 0; i < dim_c_x; ++i)
+    {
+        for (std::size_t j = 0; j < dim_r_y; ++j)
+        {
+            values_vec(i, j) = j;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Computation
+    auto start_total = t.now();
+    hpxfft::fft2D::shared::service fft_service(plan_flag, max_batch);
+    // warm up: first plan and buffer of this shape
+    fft_service.fft_2d_r2c(values_vec);
+    auto stop_init = t.now();
+    // independent submissions, each one from its own task
+    std::vector<hpx::future<void>> futures(n_transforms);
+    for (std::size_t k = 0; k < n_transforms; ++k)
+    {
+        futures[k] = hpx::async(
+            [&fft_service, &values_vec]
+            {
+                hpxfft::fft2D::shared::vector_2d input = values_vec;
+                fft_service.fft_2d_r2c(std::move(input));
+            });
+    }
+    hpx::wait_all(futures);
+    auto stop_total = t.now();
+
+    ////////////////////////////////////////////////////////////////
+    // Postprocessing
+    // print and store runtimes
+    auto total = stop_total - start_total;
+    auto init = stop_init - start_total;
+    auto transforms = stop_total - stop_init;
+    std::string msg =
+        "\nLocality 0 - service -\n"
+        "Total runtime : {1}\n"
+        "Initialization: {2}\n"
+        "Transforms    : {3}\n"
+        "FFTs / second : {4}\n";
+    hpx::util::format_to(std::cout, msg, total, init, transforms, n_transforms / transforms) << std::flush;
+
+    std::string runtime_file_path = "runtimes/runtimes_hpx_shared_service.txt";
+    hpxfft::util::create_parent_dir(runtime_file_path);
+    std::ofstream runtime_file;
+    runtime_file.open(runtime_file_path, std::ios_base::app);
+
+    if (print_header)
+    {
+        runtime_file << "n_threads;n_x;n_y;plan;transforms;batch;total;initialization;" << "fft_2d_total;"
+                     << "ffts_per_second;\n";
+    }
+    runtime_file << hpx::get_os_thread_count() << ";" << dim_c_x << ";" << dim_r_y << ";" << plan_flag << ";"
+                 << n_transforms << ";" << max_batch << ";" << total << ";" << init << ";" << transforms << ";"
+                 << n_transforms / transforms << ";\n";
+    runtime_file.close();
+
+    ////////////////////////////////////////////////////////////////
+    // Finalize HPX runtime
+    return hpx::finalize();
+}
+
+int main(int argc, char *argv[])
+{
+    using namespace hpx::program_options;
+
+    options_description desc_commandline;
+    desc_commandline.add_options()(
+        "nx", value<std::size_t>()->default_value(64), "Total x dimension")(
+        "ny", value<std::size_t>()->default_value(64), "Total y dimension")(
+        "plan", value<std::string>()->default_value("estimate"), "FFTW plan (default: estimate)")(
+        "transforms", value<std::size_t>()->default_value(100000), "Number of independent transforms")(
+        "batch", value<std::size_t>()->default_value(64), "Maximal number of transforms per FFTW batch")(
+        "header", value<bool>()->default_value(0), "Write runtime file header");
+
+    hpx::init_params init_args;
+    init_args.desc_cmdline = desc_commandline;
+
+    return hpx::init(argc, argv, init_args);
+}
@@ -18,6 +18,7 @@ int hpx_main(hpx::program_options::variables_map &vm)
     ////////////////////////////////////////////////////////////////
     // Parameters and Data structures
     const std::string plan_flag = vm["plan"].as<std::string>();
+    const bool affinity = vm["affinity"].as<bool>();
     bool print_result = vm["result"].as<bool>();
     bool print_header = vm["header"].as<bool>();
     // time measurement
@@ -42,7 +43,7 @@ int hpx_main(hpx::program_options::variables_map &vm)
     // Computation
     hpxfft::fft2D::shared::sync fft_computer;
     auto start_total = t.now();
-    fft_computer.initialize(std::move(values_vec), plan_flag);
+    fft_computer.initialize(std::move(values_vec), plan_flag, affinity);
     auto stop_init = t.now();
     values_vec = fft_computer.fft_2d_r2c();
     auto stop_total = t.now();
@@ -110,7 +111,8 @@ int main(int argc, char *argv[])
         "result", value<bool>()->default_value(0), "Print generated results (default: false)")(
         "nx", value<std::size_t>()->default_value(8), "Total x dimension")(
         "ny", value<std::size_t>()->default_value(14), "Total y dimension")(
-        "plan", value<std::string>()->default_value("estimate"), "FFTW plan (default: estimate)")(
+        "plan", value<std::string>()->default_value("estimate"), "FFTW plan or native (default: estimate)")(
+        "affinity", value<bool>()->default_value(0), "Pin row blocks to worker threads (default: false)")(
         "header", value<bool>()->default_value(0), "Write runtime file header");
 
     hpx::init_params init_args;
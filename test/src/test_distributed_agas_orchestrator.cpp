@@ -0,0 +1,66 @@
+#include "../../core/include/hpxfft/2D/distributed/agas_orchestrator.hpp"
+#include "../../core/include/hpxfft/util/print_vector_2d.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <fftw3.h>
+#include <hpx/hpx_init.hpp>
+#include <stdexcept>
+
+using hpxfft::fft2D::distributed::agas_orchestrator;
+using real = double;
+
+int entrypoint_test1(int argc, char *argv[])
+{
+    // Parameters and Data structures
+    // choose dimensions consistent with the implementation:
+    const std::size_t n_row = 4;
+    const std::size_t n_col = 6;
+    hpxfft::fft2D::distributed::vector_2d values_vec(n_row, n_col, 0.0);
+
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        values_vec(i, 0) = 1.0;
+        values_vec(i, 1) = 2.0;
+        values_vec(i, 2) = 3.0;
+        values_vec(i, 3) = 4.0;
+    }
+
+    // expected output
+    hpxfft::fft2D::distributed::vector_2d expected_output(n_row, n_col, 0.0);
+
+    expected_output(0, 0) = 40.0;
+    expected_output(0, 2) = -8.0;
+    expected_output(0, 3) = 8.0;
+    expected_output(0, 4) = -8.0;
+
+    // Computation driven from this locality only
+    hpxfft::fft2D::distributed::agas_orchestrator fft;
+    std::string plan_flag = "estimate";
+    hpx::future<void> init_future = fft.initialize(std::move(values_vec), "scatter", plan_flag);
+    init_future.get();
+    hpx::future<void> fft_future = fft.fft_2d_r2c();
+    fft_future.get();
+    values_vec = fft.get_result();
+    REQUIRE(values_vec == expected_output);
+
+    // row slabs must not drop remainder rows
+    const std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    hpxfft::fft2D::distributed::agas_orchestrator fft_uneven;
+    REQUIRE_THROWS_AS(fft_uneven.initialize(hpxfft::fft2D::distributed::vector_2d(0, n_col), "scatter", plan_flag),
+                      std::invalid_argument);
+    if (num_localities > 1)
+    {
+        REQUIRE_THROWS_AS(
+            fft_uneven.initialize(
+                hpxfft::fft2D::distributed::vector_2d(num_localities + 1, n_col), "scatter", plan_flag),
+            std::invalid_argument);
+    }
+
+    return hpx::finalize();
+}
+
+TEST_CASE("distributed agas orchestrator fft 2d r2c runs and produces correct output",
+          "[distributed agas orchestrator][fft]")
+{
+    hpx::init(&entrypoint_test1, 0, nullptr);
+}
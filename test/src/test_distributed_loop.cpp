@@ -1,6 +1,7 @@
 #include "../../core/include/hpxfft/2D/distributed/loop.hpp"
 #include "../../core/include/hpxfft/util/print_vector_2d.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <cmath>
 #include <fftw3.h>
 #include <hpx/hpx_init.hpp>
@@ -47,6 +48,19 @@ int entrypoint_test1(int argc, char *argv[])
     REQUIRE(total >= 0.0);
     REQUIRE(values_vec == expected_output);
 
+    // second run with new collective generations and communication buffers
+    std::fill(values_vec.begin(), values_vec.end(), 0.0);
+    for (std::size_t i = 0; i < n_x_local; ++i)
+    {
+        values_vec(i, 0) = 1.0;
+        values_vec(i, 1) = 2.0;
+        values_vec(i, 2) = 3.0;
+        values_vec(i, 3) = 4.0;
+    }
+    fft.set_values(std::move(values_vec));
+    values_vec = fft.fft_2d_r2c();
+    REQUIRE(values_vec == expected_output);
+
     return hpx::finalize();
 }
 
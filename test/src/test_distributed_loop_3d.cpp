@@ -0,0 +1,113 @@
+#include "../../core/include/hpxfft/3D/distributed/loop.hpp"
+#include "../../core/include/hpxfft/3D/shared/loop.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <hpx/hpx_init.hpp>
+
+using hpxfft::fft3D::distributed::loop;
+using real = double;
+
+int entrypoint_test1(int argc, char *argv[])
+{
+    // Parameters and Data structures
+    const std::size_t this_locality = hpx::get_locality_id();
+    const std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    // choose dimensions consistent with the implementation:
+    const std::size_t n_x = 4;
+    const std::size_t n_y = 4;
+    const std::size_t n_z_r = 4;
+    const std::size_t n_z_c = n_z_r / 2 + 1;
+    const std::size_t n_x_local = n_x / num_localities;
+    hpxfft::fft3D::distributed::vector_3d values_vec(n_x_local, n_y, 2 * n_z_c, 0.0);
+
+    for (std::size_t i = 0; i < n_x_local; ++i)
+    {
+        for (std::size_t j = 0; j < n_y; ++j)
+        {
+            for (std::size_t k = 0; k < n_z_r; ++k)
+            {
+                values_vec(i, j, k) = k;
+            }
+        }
+    }
+
+    // expected output
+    hpxfft::fft3D::distributed::vector_3d expected_output(n_x_local, n_y, 2 * n_z_c, 0.0);
+
+    if (this_locality == 0)
+    {
+        expected_output(0, 0, 0) = 96.0;
+        expected_output(0, 0, 2) = -32.0;
+        expected_output(0, 0, 3) = 32.0;
+        expected_output(0, 0, 4) = -32.0;
+    }
+
+    // Computation
+    for (const std::string comm_flag : { "scatter", "all_to_all" })
+    {
+        hpxfft::fft3D::distributed::vector_3d input(values_vec);
+        hpxfft::fft3D::distributed::loop fft;
+        std::string plan_flag = "estimate";
+        fft.initialize(std::move(input), comm_flag, plan_flag);
+        hpxfft::fft3D::distributed::vector_3d out = fft.fft_3d_r2c();
+        auto total = fft.get_measurement(std::string("total"));
+        REQUIRE(total >= 0.0);
+        REQUIRE(fft.get_measurement(std::string("first_comm")) >= 0.0);
+        REQUIRE(out == expected_output);
+    }
+
+    // position-dependent input, the reference is the shared loop engine on the full input
+    auto position_input = [](std::size_t i, std::size_t j, std::size_t k)
+    { return std::sin(0.3 * i + 0.7 * j * j) + 0.1 * k * (j + 1); };
+    hpxfft::fft3D::shared::vector_3d full_input(n_x, n_y, 2 * n_z_c, 0.0);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for (std::size_t j = 0; j < n_y; ++j)
+        {
+            for (std::size_t k = 0; k < n_z_r; ++k)
+            {
+                full_input(i, j, k) = position_input(i, j, k);
+            }
+        }
+    }
+    hpxfft::fft3D::shared::loop reference_fft;
+    reference_fft.initialize(std::move(full_input), "estimate");
+    const hpxfft::fft3D::shared::vector_3d reference_output = reference_fft.fft_3d_r2c_par();
+
+    // x-slices of this locality
+    const std::size_t x_offset = this_locality * n_x_local;
+    for (const std::string comm_flag : { "scatter", "all_to_all" })
+    {
+        hpxfft::fft3D::distributed::vector_3d input(n_x_local, n_y, 2 * n_z_c, 0.0);
+        for (std::size_t i = 0; i < n_x_local; ++i)
+        {
+            for (std::size_t j = 0; j < n_y; ++j)
+            {
+                for (std::size_t k = 0; k < n_z_r; ++k)
+                {
+                    input(i, j, k) = position_input(x_offset + i, j, k);
+                }
+            }
+        }
+        hpxfft::fft3D::distributed::loop fft;
+        fft.initialize(std::move(input), comm_flag, "estimate");
+        hpxfft::fft3D::distributed::vector_3d out = fft.fft_3d_r2c();
+        for (std::size_t i = 0; i < n_x_local; ++i)
+        {
+            for (std::size_t j = 0; j < n_y; ++j)
+            {
+                for (std::size_t k = 0; k < 2 * n_z_c; ++k)
+                {
+                    REQUIRE(std::abs(out(i, j, k) - reference_output(x_offset + i, j, k)) < 1e-10);
+                }
+            }
+        }
+    }
+
+    return hpx::finalize();
+}
+
+TEST_CASE("distributed loop fft 3d r2c runs and produces correct output", "[distributed loop][3D][fft]")
+{
+    hpx::init(&entrypoint_test1, 0, nullptr);
+}
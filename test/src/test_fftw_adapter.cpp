@@ -0,0 +1,51 @@
+#include "../../core/include/hpxfft/util/adapter_fftw.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fftw3.h>
+#include <string>
+#include <vector>
+
+using real = double;
+
+TEST_CASE("fftw adapter wisdom round trip: export, import, then plan", "[fftw adapter][wisdom]")
+{
+    const int n = 16;
+    const int n_c = n / 2 + 1;
+    const real pi = std::acos(-1.0);
+    const std::string file_path =
+        (std::filesystem::temp_directory_path() / "hpxfft_test_fftw_adapter.wisdom").string();
+
+    std::vector<real> in(n);
+    std::vector<fftw_complex> out(n_c);
+
+    // measured plan, its wisdom is exported
+    {
+        hpxfft::util::fftw_adapter::r2c_1d measured;
+        measured.plan(n, "measure", in.data(), out.data());
+        REQUIRE(hpxfft::util::fftw_adapter::export_wisdom(file_path));
+    }
+
+    // fresh planner state, the stored measurements come back from the file
+    fftw_forget_wisdom();
+    REQUIRE(hpxfft::util::fftw_adapter::import_wisdom(file_path));
+    REQUIRE_FALSE(hpxfft::util::fftw_adapter::import_wisdom(file_path + ".missing"));
+
+    // planning after the import, measure overwrites the arrays
+    hpxfft::util::fftw_adapter::r2c_1d planned;
+    planned.plan(n, "measure", in.data(), out.data());
+    for (int i = 0; i < n; ++i)
+    {
+        in[i] = 1.0 + 0.5 * std::cos(2.0 * pi * 3.0 * i / n);
+    }
+    planned.execute(in.data(), out.data());
+    std::remove(file_path.c_str());
+
+    for (int k = 0; k < n_c; ++k)
+    {
+        const real re = k == 0 ? static_cast<real>(n) : (k == 3 ? 0.25 * n : 0.0);
+        REQUIRE(std::abs(out[k][0] - re) < 1e-10);
+        REQUIRE(std::abs(out[k][1]) < 1e-10);
+    }
+}
@@ -1,6 +1,7 @@
 #include "../../core/include/hpxfft/2D/shared/naive.hpp"
 #include "../../core/include/hpxfft/util/print_vector_2d.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <cmath>
 #include <hpx/hpx_init.hpp>
 
@@ -42,6 +43,24 @@ int entrypoint_test1(int argc, char *argv[])
     REQUIRE(total >= 0.0);
     REQUIRE(values_vec == expected_output);
 
+    // replay the task graph on the returned buffer with doubled input
+    std::fill(values_vec.begin(), values_vec.end(), 0.0);
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        values_vec(i, 0) = 2.0;
+        values_vec(i, 1) = 4.0;
+        values_vec(i, 2) = 6.0;
+        values_vec(i, 3) = 8.0;
+    }
+    fft.set_values(std::move(values_vec));
+    values_vec = fft.fft_2d_r2c();
+    hpxfft::fft2D::shared::vector_2d expected_replay = expected_output;
+    for (std::size_t i = 0; i < expected_replay.size(); ++i)
+    {
+        expected_replay.data()[i] *= 2.0;
+    }
+    REQUIRE(values_vec == expected_replay);
+
     return hpx::finalize();
 }
 
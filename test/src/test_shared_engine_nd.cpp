@@ -0,0 +1,123 @@
+#include "../../core/include/hpxfft/ND/shared/engine.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <hpx/hpx_init.hpp>
+
+using real = double;
+
+// 3D input of test_shared_loop_3d: the engine must match the 3D engines
+template <typename Policy>
+void check_3d()
+{
+    const std::size_t n_x = 3;
+    const std::size_t n_y = 5;
+    const std::size_t n_z_r = 4;
+    const std::size_t n_z_c = n_z_r / 2 + 1;
+    hpxfft::fftND::shared::vector_nd<3> values_vec({n_x, n_y, 2 * n_z_c}, 0.0);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for (std::size_t j = 0; j < n_y; ++j)
+        {
+            for (std::size_t k = 0; k < n_z_r; ++k)
+            {
+                values_vec(i, j, k) = k;
+            }
+        }
+    }
+
+    // expected output
+    hpxfft::fftND::shared::vector_nd<3> expected_output({n_x, n_y, 2 * n_z_c}, 0.0);
+    expected_output(0, 0, 0) = 90.0;
+    expected_output(0, 0, 2) = -30.0;
+    expected_output(0, 0, 3) = 30.0;
+    expected_output(0, 0, 4) = -30.0;
+
+    hpxfft::fftND::shared::engine<3, Policy> fft;
+    fft.initialize(std::move(values_vec), "estimate", 2);
+    hpxfft::fftND::shared::vector_nd<3> out = fft.fft_nd_r2c();
+    REQUIRE(fft.get_measurement("total") >= 0.0);
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        REQUIRE(std::abs(out.data()[i] - expected_output.data()[i]) < 1e-10);
+    }
+}
+
+// 4D round trip, unnormalized: input scaled by the number of real entries
+template <typename Policy>
+void check_4d()
+{
+    const std::size_t n_t = 2;
+    const std::size_t n_x = 3;
+    const std::size_t n_y = 4;
+    const std::size_t n_z_r = 6;
+    const std::size_t n_z_c = n_z_r / 2 + 1;
+    hpxfft::fftND::shared::vector_nd<4> values_vec({n_t, n_x, n_y, 2 * n_z_c}, 0.0);
+    for (std::size_t l = 0; l < n_t; ++l)
+    {
+        for (std::size_t i = 0; i < n_x; ++i)
+        {
+            for (std::size_t j = 0; j < n_y; ++j)
+            {
+                for (std::size_t k = 0; k < n_z_r; ++k)
+                {
+                    values_vec(l, i, j, k) = static_cast<real>((l + 2 * i + 3 * j + 5 * k) % 7);
+                }
+            }
+        }
+    }
+    hpxfft::fftND::shared::vector_nd<4> input = values_vec;
+
+    hpxfft::fftND::shared::engine<4, Policy> fft;
+    fft.initialize(std::move(values_vec), "estimate", 2);
+    hpxfft::fftND::shared::vector_nd<4> spectrum = fft.fft_nd_r2c();
+    // zero frequency: sum of all entries
+    real sum = 0.0;
+    for (std::size_t l = 0; l < n_t; ++l)
+    {
+        for (std::size_t i = 0; i < n_x; ++i)
+        {
+            for (std::size_t j = 0; j < n_y; ++j)
+            {
+                for (std::size_t k = 0; k < n_z_r; ++k)
+                {
+                    sum += input(l, i, j, k);
+                }
+            }
+        }
+    }
+    REQUIRE(std::abs(spectrum(0, 0, 0, 0) - sum) < 1e-10);
+    REQUIRE(std::abs(spectrum(0, 0, 0, 1)) < 1e-10);
+
+    hpxfft::fftND::shared::vector_nd<4> out = fft.fft_nd_c2r(std::move(spectrum));
+    const real scale = static_cast<real>(n_t * n_x * n_y * n_z_r);
+    for (std::size_t l = 0; l < n_t; ++l)
+    {
+        for (std::size_t i = 0; i < n_x; ++i)
+        {
+            for (std::size_t j = 0; j < n_y; ++j)
+            {
+                for (std::size_t k = 0; k < n_z_r; ++k)
+                {
+                    REQUIRE(std::abs(out(l, i, j, k) - scale * input(l, i, j, k)) < 1e-10);
+                }
+            }
+        }
+    }
+}
+
+int entrypoint_test1(int argc, char *argv[])
+{
+    check_3d<hpxfft::fftND::shared::policy::loop>();
+    check_3d<hpxfft::fftND::shared::policy::sync>();
+    check_3d<hpxfft::fftND::shared::policy::dataflow>();
+    check_4d<hpxfft::fftND::shared::policy::loop>();
+    check_4d<hpxfft::fftND::shared::policy::sync>();
+    check_4d<hpxfft::fftND::shared::policy::dataflow>();
+
+    return hpx::finalize();
+}
+
+TEST_CASE("shared engine fft nd r2c produces correct output for every policy", "[shared engine][ND][fft]")
+{
+    hpx::init(&entrypoint_test1, 0, nullptr);
+}
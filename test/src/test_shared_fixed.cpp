@@ -0,0 +1,76 @@
+#include "../../core/include/hpxfft/2D/shared/fixed.hpp"
+#include "../../core/include/hpxfft/2D/shared/loop.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <hpx/hpx_init.hpp>
+
+using hpxfft::fft2D::shared::fixed_fft_2d;
+using real = double;
+
+int entrypoint_test1(int argc, char *argv[])
+{
+    // Parameters and Data structures
+    // choose dimensions consistent with the implementation:
+    const std::size_t n_row = 4;
+    const std::size_t n_col = 6;
+    hpxfft::fft2D::shared::vector_2d values_vec(n_row, n_col, 0.0);
+
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        values_vec(i, 0) = 1.0;
+        values_vec(i, 1) = 2.0;
+        values_vec(i, 2) = 3.0;
+        values_vec(i, 3) = 4.0;
+    }
+
+    // expected output
+    hpxfft::fft2D::shared::vector_2d expected_output(n_row, n_col, 0.0);
+
+    expected_output(0, 0) = 40.0;
+    expected_output(0, 2) = -8.0;
+    expected_output(0, 3) = 8.0;
+    expected_output(0, 4) = -8.0;
+
+    // Computation
+    hpxfft::fft2D::shared::fixed_fft_2d<4, 4> fft;
+    fft.initialize(std::move(values_vec));
+    values_vec = fft.fft_2d_r2c();
+    REQUIRE(values_vec == expected_output);
+
+    // Comparison with the FFTW based engine for a larger shape
+    constexpr std::size_t n_x = 16;
+    constexpr std::size_t n_y = 32;
+    using fixed_16_32 = hpxfft::fft2D::shared::fixed_fft_2d<n_x, n_y>;
+    hpxfft::fft2D::shared::vector_2d input(n_x, fixed_16_32::n_col, 0.0);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for (std::size_t j = 0; j < n_y; ++j)
+        {
+            input(i, j) = std::sin(0.3 * i + 0.7 * j) + 0.1 * j;
+        }
+    }
+    hpxfft::fft2D::shared::loop fft_reference;
+    fft_reference.initialize(input, "estimate");
+    hpxfft::fft2D::shared::vector_2d reference = fft_reference.fft_2d_r2c_par();
+    fixed_16_32 fft_fixed;
+    fft_fixed.initialize(input);
+    hpxfft::fft2D::shared::vector_2d result = fft_fixed.fft_2d_r2c();
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for (std::size_t j = 0; j < fixed_16_32::n_col; ++j)
+        {
+            REQUIRE(std::abs(result(i, j) - reference(i, j)) < 1e-10);
+        }
+    }
+
+    // wrong shape
+    hpxfft::fft2D::shared::fixed_fft_2d<8, 8> fft_wrong;
+    REQUIRE_THROWS_AS(fft_wrong.initialize(hpxfft::fft2D::shared::vector_2d(4, 6)), std::invalid_argument);
+
+    return hpx::finalize();
+}
+
+TEST_CASE("shared fixed fft 2d r2c runs and produces correct output", "[shared fixed][fft]")
+{
+    hpx::init(&entrypoint_test1, 0, nullptr);
+}
@@ -51,6 +51,57 @@ int entrypoint_test1(int argc, char *argv[])
     auto flops = fft2.get_measurement(std::string("plan_flops"));
     REQUIRE(total >= 0.0);
     REQUIRE(out2 == expected_output);
+    // with fewer rows than threads the row FFTs are multi-threaded if FFTW threads are available
+    REQUIRE(fft2.get_measurement(std::string("first_fftw_threads")) >= 1.0);
+    REQUIRE(fft2.get_measurement(std::string("second_fftw_threads")) >= 1.0);
+
+    // Computation with fixed chunking and chunk tuning, repeated until the tuners are locked
+    hpxfft::fft2D::shared::vector_2d input(n_row, n_col, 0.0);
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        input(i, 0) = 1.0;
+        input(i, 1) = 2.0;
+        input(i, 2) = 3.0;
+        input(i, 3) = 4.0;
+    }
+    hpxfft::fft2D::shared::loop_chunking chunking;
+    chunking.first_fftw = { hpxfft::util::chunk_policy::static_size, 1 };
+    chunking.first_trans = { hpxfft::util::chunk_policy::dynamic_size, 2 };
+    chunking.second_fftw = { hpxfft::util::chunk_policy::guided_size, 1 };
+    chunking.second_trans = { hpxfft::util::chunk_policy::tune, 0 };
+    hpxfft::fft2D::shared::loop fft3;
+    fft3.initialize(input, plan_flag, chunking);
+    for (std::size_t run = 0; run < 8; ++run)
+    {
+        if (run > 0)
+        {
+            fft3.set_values(input);
+        }
+        hpxfft::fft2D::shared::vector_2d out3 = fft3.fft_2d_r2c_par();
+        REQUIRE(out3 == expected_output);
+    }
+
+    // Computation with row blocks pinned to worker threads
+    hpxfft::fft2D::shared::loop fft4;
+    fft4.initialize(input, plan_flag);
+    hpxfft::fft2D::shared::vector_2d out4 = fft4.fft_2d_r2c_affinity();
+    REQUIRE(out4 == expected_output);
+    fft4.set_values(input);
+    hpx::future<hpxfft::fft2D::shared::vector_2d> future4 = fft4.fft_2d_r2c_affinity_async();
+    out4 = future4.get();
+    REQUIRE(out4 == expected_output);
+
+    // Computation with the native power-of-two kernels instead of FFTW
+    hpxfft::fft2D::shared::loop fft5;
+    fft5.initialize(input, std::string("native"));
+    hpxfft::fft2D::shared::vector_2d out5 = fft5.fft_2d_r2c_par();
+    for (std::size_t i = 0; i < n_x_local; ++i)
+    {
+        for (std::size_t j = 0; j < n_col; ++j)
+        {
+            REQUIRE(std::abs(out5(i, j) - expected_output(i, j)) < 1e-12);
+        }
+    }
 
     return hpx::finalize();
 }
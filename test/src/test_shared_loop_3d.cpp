@@ -1,6 +1,7 @@
 #include "../../core/include/hpxfft/3D/shared/loop.hpp"
 #include "../../core/include/hpxfft/util/print_vector_3d.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <cmath>
 #include <hpx/hpx_init.hpp>
 
@@ -56,6 +57,69 @@ int entrypoint_test1(int argc, char *argv[])
     REQUIRE(total >= 0.0);
     REQUIRE(out2 == expected_output);
 
+    // Computation with partial permute tiles
+    hpxfft::fft3D::shared::vector_3d values_vec_tiled(n_x, n_y, 2*n_z_c, 0.0);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                values_vec_tiled(i, j, k) = k;
+            }
+        }
+    }
+    hpxfft::fft3D::shared::loop fft_tiled;
+    fft_tiled.initialize(std::move(values_vec_tiled), plan_flag, 2);
+    hpxfft::fft3D::shared::vector_3d out_tiled = fft_tiled.fft_3d_r2c_par();
+    REQUIRE(out_tiled == expected_output);
+
+    // repeated computation on the returned buffer
+    std::fill(out_tiled.begin(), out_tiled.end(), 0.0);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                out_tiled(i, j, k) = k;
+            }
+        }
+    }
+    fft_tiled.set_values(std::move(out_tiled));
+    out_tiled = fft_tiled.fft_3d_r2c_par();
+    REQUIRE(out_tiled == expected_output);
+
+    // inverse computation, unnormalized: input scaled by the number of real entries
+    hpxfft::fft3D::shared::vector_3d out_inverse = fft_tiled.fft_3d_c2r_par(std::move(out_tiled));
+    auto inverse_total = fft_tiled.get_measurement(std::string("inverse_total"));
+    REQUIRE(inverse_total >= 0.0);
+    const real scale = static_cast<real>(n_x * n_y * n_z_r);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                REQUIRE(std::abs(out_inverse(i, j, k) - scale * k) < 1e-10);
+            }
+        }
+    }
+
+    // inverse computation on a spectrum the engine did not return
+    hpxfft::fft3D::shared::vector_3d spectrum(expected_output);
+    hpxfft::fft3D::shared::vector_3d out_foreign = fft_tiled.fft_3d_c2r_par(std::move(spectrum));
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                REQUIRE(std::abs(out_foreign(i, j, k) - scale * k) < 1e-10);
+            }
+        }
+    }
+
     return hpx::finalize();
 }
 
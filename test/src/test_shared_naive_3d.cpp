@@ -1,7 +1,9 @@
 #include "../../core/include/hpxfft/3D/shared/naive.hpp"
 #include "../../core/include/hpxfft/util/print_vector_3d.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <cmath>
+#include <complex>
 #include <hpx/hpx_init.hpp>
 
 using hpxfft::fft3D::shared::naive;
@@ -47,6 +49,88 @@ int entrypoint_test1(int argc, char *argv[])
     REQUIRE(total >= 0.0);
     REQUIRE(out == expected_output);
 
+    // round trip on input varying in x, y and z, the inverse is unnormalized
+    hpxfft::fft3D::shared::vector_3d input(n_x, n_y, 2*n_z_c, 0.0);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                input(i, j, k) = 1.0 + i + 2.0 * j * j - 0.5 * k * i;
+            }
+        }
+    }
+    fft.set_values(hpxfft::fft3D::shared::vector_3d(input));
+    hpxfft::fft3D::shared::vector_3d spectrum = fft.fft_3d_r2c();
+    hpxfft::fft3D::shared::vector_3d out_inverse = fft.fft_3d_c2r(std::move(spectrum));
+    const real scale = static_cast<real>(n_x * n_y * n_z_r);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                REQUIRE(std::abs(out_inverse(i, j, k) - scale * input(i, j, k)) < 1e-10);
+            }
+        }
+    }
+
+    // position-dependent input, reference by direct summation of the 3D DFT
+    auto position_input = [](std::size_t i, std::size_t j, std::size_t k)
+    { return std::sin(0.3 * i + 0.7 * j * j) + 0.1 * k * (j + 1); };
+    const real pi = std::acos(-1.0);
+    hpxfft::fft3D::shared::vector_3d expected_spectrum(n_x, n_y, 2*n_z_c, 0.0);
+    for (std::size_t a = 0; a < n_x; ++a)
+    {
+        for(std::size_t b = 0; b < n_y; ++b)
+        {
+            for(std::size_t c = 0; c < n_z_c; ++c)
+            {
+                std::complex<real> sum = 0.0;
+                for (std::size_t i = 0; i < n_x; ++i)
+                {
+                    for(std::size_t j = 0; j < n_y; ++j)
+                    {
+                        for(std::size_t k = 0; k < n_z_r; ++k)
+                        {
+                            const real phase = -2.0 * pi
+                                             * (static_cast<real>(a * i) / n_x + static_cast<real>(b * j) / n_y
+                                                + static_cast<real>(c * k) / n_z_r);
+                            sum += position_input(i, j, k) * std::polar(1.0, phase);
+                        }
+                    }
+                }
+                expected_spectrum(a, b, 2*c) = sum.real();
+                expected_spectrum(a, b, 2*c + 1) = sum.imag();
+            }
+        }
+    }
+
+    // repeated computation: the returned buffer is refilled and swapped back in
+    hpxfft::fft3D::shared::vector_3d buffer = std::move(out_inverse);
+    for (std::size_t run = 0; run < 2; ++run)
+    {
+        std::fill(buffer.begin(), buffer.end(), 0.0);
+        for (std::size_t i = 0; i < n_x; ++i)
+        {
+            for(std::size_t j = 0; j < n_y; ++j)
+            {
+                for(std::size_t k = 0; k < n_z_r; ++k)
+                {
+                    buffer(i, j, k) = position_input(i, j, k);
+                }
+            }
+        }
+        fft.set_values(std::move(buffer));
+        buffer = fft.fft_3d_r2c();
+        REQUIRE(buffer.size() == expected_spectrum.size());
+        for (std::size_t i = 0; i < buffer.size(); ++i)
+        {
+            REQUIRE(std::abs(buffer.data()[i] - expected_spectrum.data()[i]) < 1e-10);
+        }
+    }
+
     return hpx::finalize();
 }
 
@@ -0,0 +1,86 @@
+#include "../../core/include/hpxfft/2D/shared/sender.hpp"
+#include "../../core/include/hpxfft/util/print_vector_2d.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <hpx/hpx_init.hpp>
+#include <stdexcept>
+
+using hpxfft::fft2D::shared::sender;
+using real = double;
+
+int entrypoint_test1(int argc, char *argv[])
+{
+    // Parameters and Data structures
+    const std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    // choose dimensions consistent with the implementation:
+    const std::size_t n_row = 4;
+    const std::size_t n_col = 6;
+    const std::size_t n_x_local = n_row / num_localities;
+    hpxfft::fft2D::shared::vector_2d values_vec(n_row, n_col, 0.0);
+
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        values_vec(i, 0) = 1.0;
+        values_vec(i, 1) = 2.0;
+        values_vec(i, 2) = 3.0;
+        values_vec(i, 3) = 4.0;
+    }
+
+    // expected output
+    hpxfft::fft2D::shared::vector_2d expected_output(n_x_local, n_col, 0.0);
+
+    expected_output(0, 0) = 40.0;
+    expected_output(0, 2) = -8.0;
+    expected_output(0, 3) = 8.0;
+    expected_output(0, 4) = -8.0;
+
+    // Computation
+    hpxfft::fft2D::shared::sender fft;
+    std::string plan_flag = "estimate";
+    fft.initialize(std::move(values_vec), plan_flag);
+    values_vec = fft.fft_2d_r2c();
+    auto total = fft.get_measurement(std::string("total"));
+    REQUIRE(total >= 0.0);
+    REQUIRE(values_vec == expected_output);
+
+    // repeated computation on the returned buffer
+    std::fill(values_vec.begin(), values_vec.end(), 0.0);
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        values_vec(i, 0) = 1.0;
+        values_vec(i, 1) = 2.0;
+        values_vec(i, 2) = 3.0;
+        values_vec(i, 3) = 4.0;
+    }
+    fft.set_values(std::move(values_vec));
+    values_vec = fft.fft_2d_r2c();
+    REQUIRE(values_vec == expected_output);
+
+    // input of another shape is rejected
+    REQUIRE_THROWS_AS(fft.set_values(hpxfft::fft2D::shared::vector_2d(n_row + 1, n_col, 0.0)), std::invalid_argument);
+
+    // Computation chained with user work
+    namespace ex = hpx::execution::experimental;
+    hpxfft::fft2D::shared::vector_2d values_vec_chain(n_row, n_col, 0.0);
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        values_vec_chain(i, 0) = 1.0;
+        values_vec_chain(i, 1) = 2.0;
+        values_vec_chain(i, 2) = 3.0;
+        values_vec_chain(i, 3) = 4.0;
+    }
+    hpxfft::fft2D::shared::sender fft_chain;
+    fft_chain.initialize(std::move(values_vec_chain), plan_flag);
+    auto result = hpx::this_thread::experimental::sync_wait(
+        fft_chain.fft_2d_r2c_sender()
+        | ex::then([&](hpxfft::fft2D::shared::vector_2d out) { return out == expected_output; }));
+    REQUIRE(hpx::get<0>(*result));
+
+    return hpx::finalize();
+}
+
+TEST_CASE("shared sender fft 2d r2c runs and produces correct output", "[shared sender][fft]")
+{
+    hpx::init(&entrypoint_test1, 0, nullptr);
+}
@@ -0,0 +1,90 @@
+#include "../../core/include/hpxfft/2D/shared/loop.hpp"
+#include "../../core/include/hpxfft/2D/shared/service.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <hpx/hpx_init.hpp>
+
+using hpxfft::fft2D::shared::service;
+using real = double;
+
+int entrypoint_test1(int argc, char *argv[])
+{
+    // Parameters and Data structures
+    // choose dimensions consistent with the implementation:
+    const std::size_t n_row = 4;
+    const std::size_t n_col = 6;
+    hpxfft::fft2D::shared::vector_2d values_vec(n_row, n_col, 0.0);
+
+    for (std::size_t i = 0; i < n_row; ++i)
+    {
+        values_vec(i, 0) = 1.0;
+        values_vec(i, 1) = 2.0;
+        values_vec(i, 2) = 3.0;
+        values_vec(i, 3) = 4.0;
+    }
+
+    // expected output
+    hpxfft::fft2D::shared::vector_2d expected_output(n_row, n_col, 0.0);
+
+    expected_output(0, 0) = 40.0;
+    expected_output(0, 2) = -8.0;
+    expected_output(0, 3) = 8.0;
+    expected_output(0, 4) = -8.0;
+
+    // Computation of a single transform
+    std::string plan_flag = "estimate";
+    hpxfft::fft2D::shared::service fft(plan_flag, 4);
+    hpxfft::fft2D::shared::vector_2d out = fft.fft_2d_r2c(values_vec);
+    REQUIRE(out == expected_output);
+
+    // Many concurrent transforms of two shapes, submitted from different tasks
+    const std::size_t n_transforms = 50;
+    std::vector<hpx::future<hpxfft::fft2D::shared::vector_2d>> futures;
+    for (std::size_t k = 0; k < n_transforms; ++k)
+    {
+        futures.push_back(hpx::async(
+            [&fft, &values_vec, k]
+            {
+                // every other transform with an additional zero row
+                hpxfft::fft2D::shared::vector_2d input(k % 2 == 0 ? 4 : 5, 6, 0.0);
+                std::copy(values_vec.begin(), values_vec.end(), input.begin());
+                return fft.fft_2d_r2c(std::move(input));
+            }));
+    }
+    for (std::size_t k = 0; k < n_transforms; ++k)
+    {
+        hpxfft::fft2D::shared::vector_2d result = futures[k].get();
+        if (k % 2 == 0)
+        {
+            REQUIRE(result == expected_output);
+        }
+        else
+        {
+            // zero row only changes the non-zero frequencies in x-direction
+            REQUIRE(result.n_row() == 5);
+            REQUIRE(std::abs(result(0, 0) - 40.0) < 1e-12);
+        }
+    }
+
+    // destroying another engine keeps the cached plans of the service valid
+    {
+        hpxfft::fft2D::shared::vector_2d loop_input = values_vec;
+        hpxfft::fft2D::shared::loop other;
+        other.initialize(std::move(loop_input), plan_flag);
+        REQUIRE(other.fft_2d_r2c_par() == expected_output);
+    }
+    out = fft.fft_2d_r2c(values_vec);
+    REQUIRE(out == expected_output);
+
+    // invalid shape
+    hpxfft::fft2D::shared::vector_2d invalid(2, 3, 0.0);
+    REQUIRE_THROWS(fft.fft_2d_r2c(std::move(invalid)));
+
+    return hpx::finalize();
+}
+
+TEST_CASE("shared service fft 2d r2c batches concurrent transforms and produces correct output",
+          "[shared service][fft]")
+{
+    hpx::init(&entrypoint_test1, 0, nullptr);
+}
@@ -47,6 +47,33 @@ int entrypoint_test1(int argc, char *argv[])
     REQUIRE(total >= 0.0);
     REQUIRE(out == expected_output);
 
+    // round trip on input varying in x, y and z, the inverse is unnormalized
+    hpxfft::fft3D::shared::vector_3d input(n_x, n_y, 2*n_z_c, 0.0);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                input(i, j, k) = 1.0 + i + 2.0 * j * j - 0.5 * k * i;
+            }
+        }
+    }
+    fft.set_values(hpxfft::fft3D::shared::vector_3d(input));
+    hpxfft::fft3D::shared::vector_3d spectrum = fft.fft_3d_r2c();
+    hpxfft::fft3D::shared::vector_3d out_inverse = fft.fft_3d_c2r(std::move(spectrum));
+    const real scale = static_cast<real>(n_x * n_y * n_z_r);
+    for (std::size_t i = 0; i < n_x; ++i)
+    {
+        for(std::size_t j = 0; j < n_y; ++j)
+        {
+            for(std::size_t k = 0; k < n_z_r; ++k)
+            {
+                REQUIRE(std::abs(out_inverse(i, j, k) - scale * input(i, j, k)) < 1e-10);
+            }
+        }
+    }
+
     return hpx::finalize();
 }
 
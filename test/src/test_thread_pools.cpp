@@ -0,0 +1,118 @@
+#include "../../core/include/hpxfft/2D/distributed/loop.hpp"
+#include "../../core/include/hpxfft/util/thread_pools.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <hpx/hpx_init.hpp>
+#include <hpx/thread.hpp>
+#include <string>
+#include <vector>
+
+using real = double;
+
+// cores seen by the resource partitioner, set in the rp_callback
+std::size_t n_cores_total = 0;
+
+int entrypoint_test1(int argc, char *argv[])
+{
+    // the communication pool takes one core unless a single core is available
+    const bool has_communication_pool = hpx::resource::pool_exists(hpxfft::util::communication_pool_name);
+    REQUIRE(has_communication_pool == (n_cores_total > 1));
+    REQUIRE(hpxfft::util::compute_thread_count() >= 1);
+
+    // tasks run on the pool of their executor
+    auto pool_name = [] { return hpx::this_thread::get_pool()->get_pool_name(); };
+    const std::string communication_pool =
+        hpx::async(hpxfft::util::communication_executor(), pool_name).get();
+    const std::string compute_pool = hpx::async(hpxfft::util::compute_executor(), pool_name).get();
+    REQUIRE(compute_pool == "default");
+    REQUIRE(communication_pool == (has_communication_pool ? hpxfft::util::communication_pool_name : "default"));
+
+    // background work leaves one worker thread of the compute pool free
+    const std::size_t n_compute = hpxfft::util::compute_thread_count();
+    REQUIRE(hpxfft::util::background_task_limit() == (n_compute > 1 ? n_compute - 1 : 1));
+    // every index of [first, last) runs once, on at most background_task_limit() tasks at a time
+    const std::size_t first = 3;
+    const std::size_t last = 103;
+    std::vector<int> visits(last, 0);
+    std::atomic<std::size_t> running(0);
+    std::atomic<std::size_t> max_running(0);
+    hpxfft::util::background_for_loop(hpxfft::util::compute_executor(),
+                                      first,
+                                      last,
+                                      [&](std::size_t i)
+                                      {
+                                          const std::size_t now = ++running;
+                                          std::size_t seen = max_running.load();
+                                          while (now > seen && !max_running.compare_exchange_weak(seen, now))
+                                          {
+                                          }
+                                          ++visits[i];
+                                          hpx::this_thread::yield();
+                                          --running;
+                                      })
+        .get();
+    REQUIRE(std::count(visits.begin(), visits.begin() + first, 0) == static_cast<std::ptrdiff_t>(first));
+    REQUIRE(std::count(visits.begin() + first, visits.end(), 1) == static_cast<std::ptrdiff_t>(last - first));
+    REQUIRE(max_running.load() <= hpxfft::util::background_task_limit());
+    // an empty range is ready at once
+    REQUIRE(hpxfft::util::background_for_loop(hpxfft::util::compute_executor(), 5, 5, [](std::size_t) {}).is_ready());
+
+    // Parameters and Data structures
+    const std::size_t this_locality = hpx::get_locality_id();
+    const std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    // choose dimensions consistent with the implementation:
+    const std::size_t n_row = 4;
+    const std::size_t n_col = 6;
+    const std::size_t n_x_local = n_row / num_localities;
+    hpxfft::fft2D::distributed::vector_2d values_vec(n_x_local, n_col, 0.0);
+
+    for (std::size_t i = 0; i < n_x_local; ++i)
+    {
+        values_vec(i, 0) = 1.0;
+        values_vec(i, 1) = 2.0;
+        values_vec(i, 2) = 3.0;
+        values_vec(i, 3) = 4.0;
+    }
+
+    // expected output
+    hpxfft::fft2D::distributed::vector_2d expected_output(n_x_local, n_col, 0.0);
+
+    if (this_locality == 0)
+    {
+        expected_output(0, 0) = 40.0;
+        expected_output(0, 2) = -8.0;
+        expected_output(0, 3) = 8.0;
+        expected_output(0, 4) = -8.0;
+    }
+
+    // Computation: collectives on the communication pool, FFTs on the default pool
+    for (const std::string comm_flag : { "scatter", "all_to_all" })
+    {
+        hpxfft::fft2D::distributed::vector_2d input(values_vec);
+        hpxfft::fft2D::distributed::loop fft;
+        std::string plan_flag = "estimate";
+        fft.initialize(std::move(input), comm_flag, plan_flag);
+        hpxfft::fft2D::distributed::vector_2d out = fft.fft_2d_r2c();
+        REQUIRE(fft.get_measurement(std::string("total")) >= 0.0);
+        REQUIRE(out == expected_output);
+    }
+
+    return hpx::finalize();
+}
+
+TEST_CASE("thread pools run background loops and a distributed loop fft 2d r2c", "[thread pools][fft]")
+{
+    hpx::init_params init_args;
+    init_args.rp_callback = [](hpx::resource::partitioner &rp, const hpx::program_options::variables_map &)
+    {
+        for (const hpx::resource::numa_domain &domain : rp.numa_domains())
+        {
+            n_cores_total += domain.cores().size();
+        }
+        hpxfft::util::create_communication_pool(rp, 1);
+    };
+    hpx::init(&entrypoint_test1, 0, nullptr, init_args);
+}
@@ -0,0 +1,49 @@
+#define CATCH_CONFIG_MAIN
+#include "../../core/include/hpxfft/util/vector_nd.hpp"
+#include "../../core/include/hpxfft/util/vector_3d.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <numeric>
+
+TEST_CASE("Vector ND constant: Initialization", "[vector_nd][init]")
+{
+    hpxfft::util::vector_nd<double, 4> vec({2, 3, 2, 2}, 3.0);
+
+    REQUIRE(vec.extent(0) == 2);
+    REQUIRE(vec.extent(1) == 3);
+    REQUIRE(vec.extent(3) == 2);
+    REQUIRE(vec(0, 0, 0, 0) == 3.0);
+    REQUIRE(vec(1, 2, 1, 1) == 3.0);
+    REQUIRE(vec.size() == 24);
+    REQUIRE(vec.slice(1) == vec.data() + 12);
+}
+
+TEST_CASE("Vector ND: Access Out of Range", "[vector_nd][exception]")
+{
+    hpxfft::util::vector_nd<double, 3> vec({2, 2, 2}, 1.0);
+
+    REQUIRE_THROWS_AS(vec.at({0, 2, 0}), std::runtime_error);
+    REQUIRE_THROWS_AS(vec.rearrange({2, 2, 3}), std::runtime_error);
+}
+
+TEST_CASE("Vector ND: Same layout as Vector 3D", "[vector_nd][layout]")
+{
+    hpxfft::util::vector_nd<double, 3> vec_nd({2, 3, 4});
+    hpxfft::util::vector_3d<double> vec_3d(2, 3, 4);
+    std::iota(vec_nd.begin(), vec_nd.end(), 0.0);
+    std::iota(vec_3d.begin(), vec_3d.end(), 0.0);
+
+    REQUIRE(vec_nd(1, 2, 3) == vec_3d(1, 2, 3));
+    REQUIRE(vec_nd(0, 1, 2) == vec_3d(0, 1, 2));
+}
+
+TEST_CASE("Compare two Vector ND instances", "[vector_nd][compare]")
+{
+    hpxfft::util::vector_nd<double, 2> vec1({2, 2}, 5.0);
+    hpxfft::util::vector_nd<double, 2> vec2({2, 2}, 5.0);
+    hpxfft::util::vector_nd<double, 2> vec3({2, 2}, 6.0);
+    hpxfft::util::vector_nd<double, 2> vec4({1, 4}, 5.0);
+
+    REQUIRE(vec1 == vec2);
+    REQUIRE(!(vec1 == vec3));
+    REQUIRE(!(vec1 == vec4));
+}